@@ -0,0 +1,2673 @@
+/**
+	@file benchmark.cpp
+
+	@brief Benchmark delle code
+
+    @description
+    File sorgente con la funzione main() dei benchmark.
+    Contiene le funzioni che misurano il tempo di esecuzione e il numero
+    di allocazioni dinamiche delle operazioni delle code, per confrontare
+    le diverse implementazioni.
+    Ogni benchmark può essere eseguito singolarmente passandone il nome
+    come argomento da riga di comando; senza argomenti vengono eseguiti tutti.
+*/
+
+// Direttive per il pre-compilatore
+
+#include <iostream> // std::cout, std::endl
+#include <cstdlib> // std::malloc, std::free
+#include <cstring> // std::strcmp
+#include <new> // std::bad_alloc
+#include <chrono> // std::chrono
+#include <memory_resource> // std::pmr::monotonic_buffer_resource
+#include <string> // std::string
+#include <vector> // std::vector
+#include <algorithm> // std::nth_element, std::count
+#include <queue> // std::priority_queue
+#include <array> // std::array
+#include <thread> // std::thread, std::this_thread::yield
+#include <mutex> // std::mutex, std::lock_guard
+#include <atomic> // std::atomic
+#include <ctime> // std::clock
+#include <iterator> // std::back_inserter
+#include <functional> // std::function
+#include <condition_variable> // std::condition_variable
+#include <coroutine> // std::coroutine_handle, std::suspend_never
+#include <exception> // std::terminate
+#include <streambuf> // std::streambuf
+#include <ostream> // std::ostream
+#include <sstream> // std::ostringstream
+#include <fstream> // std::ifstream, std::ofstream
+#include <filesystem> // std::filesystem::temp_directory_path
+#include <pthread.h> // pthread_setaffinity_np
+#include "./headers/queue.h" // queue, parse_queue, serialize, deserialize
+#include "./headers/chunked_queue.h" // chunked_queue
+#include "./headers/ring_queue.h" // ring_queue
+#include "./headers/simd_search.h" // plain_equality_tag
+#include "./headers/spsc_queue.h" // spsc_queue
+#include "./headers/mpmc_queue.h" // mpmc_queue
+#include "./headers/blocking_queue.h" // blocking_queue
+#include "./headers/executor.h" // executor
+#include "./headers/sharded_queue.h" // sharded_queue
+#include "./headers/flat_combining_queue.h" // flat_combining_queue
+#include "./headers/async_queue.h" // async_queue
+#include "./headers/multicast_ring.h" // multicast_ring
+#include "./headers/multilevel_queue.h" // multilevel_queue
+#include "./headers/delay_queue.h" // delay_queue
+#include "./headers/hashed_queue.h" // hashed_queue
+#include "./headers/execution.h" // execution::par, execution::par_unseq,
+                                 // execution::speculative_op_tag
+#include "./headers/algorithms.h" // count_if, reduce, transform_into,
+                                  // remove_if
+
+// Conteggio delle allocazioni dinamiche
+
+/**
+	@brief Numero di chiamate all'allocatore globale
+
+    @description
+	Atomico perché incrementato anche dai thread dei benchmark concorrenti;
+    l'ordinamento rilassato basta a un contatore.
+*/
+static std::atomic<unsigned long> allocations(0);
+
+/*
+    GCC, dopo aver espanso in linea gli operatori ridefiniti, segnala
+    std::free su puntatori restituiti da new (-Wmismatched-new-delete):
+    qui è l'abbinamento corretto, perché anche new usa std::malloc.
+*/
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+/**
+	@brief Ridefinizione dell'operatore new globale
+
+    @description
+	Conta le chiamate all'allocatore globale, per misurare il traffico
+    di allocazione delle code.
+*/
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+/**
+	@brief Ridefinizione dell'operatore delete globale
+*/
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+/**
+	@brief Ridefinizione dell'operatore delete globale con dimensione
+*/
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+	@brief Ridefinizione dell'operatore new globale con allineamento
+
+    @description
+	Utilizzato, tra gli altri, dalle memory_resource di std::pmr.
+*/
+void *operator new(std::size_t size, std::align_val_t align) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = static_cast<std::size_t>(align);
+    void *p = std::aligned_alloc(a, (size + a - 1) / a * a);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+/**
+	@brief Ridefinizione dell'operatore delete globale con allineamento
+*/
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+/**
+	@brief Ridefinizione dell'operatore delete globale con dimensione
+	       e allineamento
+*/
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+#pragma GCC diagnostic pop
+
+/**
+	@brief Funtore per l'uguaglianza tra interi
+*/
+struct equal_int : plain_equality_tag {
+    bool operator()(int i1, int i2) const {
+        return i1 == i2;
+    }
+};
+
+/**
+	@brief Funtore per l'uguaglianza tra float
+*/
+struct equal_float : plain_equality_tag {
+    bool operator()(float f1, float f2) const {
+        return f1 == f2;
+    }
+};
+
+/**
+	@brief Funtore per l'uguaglianza tra stringhe
+*/
+struct equal_string {
+    bool operator()(const std::string &s1, const std::string &s2) const {
+        return s1 == s2;
+    }
+};
+
+/**
+	@brief Definizione di un tipo di dato per code di interi
+*/
+typedef queue<int, equal_int> queue_int;
+
+/**
+	@brief Funtore di uguaglianza tra code di interi
+*/
+struct equal_queue_int {
+    bool operator()(const queue_int &q1, const queue_int &q2) const {
+        if(q1.size() != q2.size())
+            return false;
+        queue_int::const_iterator i1 = q1.begin(), i2 = q2.begin();
+        for(; i1 != q1.end(); ++i1, ++i2)
+            if(*i1 != *i2)
+                return false;
+        return true;
+    }
+};
+
+/**
+	@brief Cronometro
+
+    @description
+	Misura il tempo trascorso dalla sua istanziazione.
+*/
+class stopwatch {
+
+    std::chrono::steady_clock::time_point _start; ///< @brief Istante iniziale
+
+public:
+
+    stopwatch() : _start(std::chrono::steady_clock::now()) {}
+
+    /**
+		@brief Tempo trascorso in secondi
+	*/
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             _start).count();
+    }
+};
+
+/**
+	@brief Stampa di una riga di risultati
+
+    @param name nome della misura
+    @param ops numero di operazioni eseguite
+    @param secs tempo impiegato in secondi
+    @param allocs numero di allocazioni effettuate
+*/
+void report(const char *name, unsigned long ops, double secs,
+            unsigned long allocs) {
+    std::cout << name << ": " << (ops / secs / 1e6) << " Mop/s, " <<
+                 allocs << " allocazioni" << std::endl;
+}
+
+/**
+	@brief Ciclo di inserimenti e rimozioni su una coda
+
+    @description
+	Esegue rounds cicli di riempimento con batch elementi seguiti
+    dallo svuotamento completo della coda, e un ciclo stazionario
+    in cui ad ogni inserimento segue una rimozione.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_enqueue_dequeue(const char *name, unsigned int rounds,
+                           unsigned int batch) {
+    Q q;
+    long sum = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        for(unsigned int i = 0; i < batch; ++i)
+            q.enqueue(static_cast<int>(i));
+        for(unsigned int i = 0; i < batch; ++i)
+            sum += q.dequeue();
+    }
+    double secs = sw.seconds();
+    std::cout << "[riempimento/svuotamento] ";
+    report(name, 2UL * rounds * batch, secs, allocations - allocs);
+
+    allocs = allocations;
+    stopwatch sw2;
+    for(unsigned int i = 0; i < rounds * batch; ++i) {
+        q.enqueue(static_cast<int>(i));
+        sum += q.dequeue();
+    }
+    secs = sw2.seconds();
+    std::cout << "[stazionario]             ";
+    report(name, 2UL * rounds * batch, secs, allocations - allocs);
+
+    if(sum == 42)
+        std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark della coda a blocchi rispetto alla coda a elementi
+*/
+void bench_chunked() {
+    std::cout << "******** chunked_queue vs queue ********" << std::endl;
+
+    const unsigned int rounds = 20;
+    const unsigned int batch = 500000;
+
+    bench_enqueue_dequeue<queue<int, equal_int> >("queue", rounds, batch);
+    bench_enqueue_dequeue<chunked_queue<int, equal_int, 64> >(
+        "chunked_queue<64>", rounds, batch);
+    bench_enqueue_dequeue<chunked_queue<int, equal_int, 128> >(
+        "chunked_queue<128>", rounds, batch);
+    bench_enqueue_dequeue<chunked_queue<int, equal_int, 256> >(
+        "chunked_queue<256>", rounds, batch);
+
+    queue<int, equal_int> q;
+    chunked_queue<int, equal_int> cq;
+    for(unsigned int i = 0; i < batch; ++i) {
+        q.enqueue(static_cast<int>(i));
+        cq.enqueue(static_cast<int>(i));
+    }
+    stopwatch sw;
+    bool found = q.contains(-1);
+    report("[contains] queue", batch, sw.seconds(), 0);
+    stopwatch sw2;
+    found = cq.contains(-1) || found;
+    report("[contains] chunked_queue<128>", batch, sw2.seconds(), 0);
+    if(found)
+        std::cout << "Valore inatteso trovato nella coda." << std::endl;
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Scansione di una coda tramite iteratori e contains
+
+    @description
+	Riempie la coda con n elementi e misura una scansione completa
+    con iteratore costante e una ricerca di un valore assente con contains.
+
+    @tparam Q tipo della coda
+    @tparam V tipo del valore degli elementi della coda
+*/
+template <typename Q, typename V>
+void bench_scan(const char *name, unsigned int n, unsigned int repeat) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<V>(i));
+
+    V sum = 0;
+    stopwatch sw;
+    for(unsigned int r = 0; r < repeat; ++r) {
+        typename Q::const_iterator i, ie;
+        for(i = q.begin(), ie = q.end(); i != ie; ++i)
+            sum += *i;
+    }
+    std::cout << "[iterazione] ";
+    report(name, static_cast<unsigned long>(n) * repeat, sw.seconds(), 0);
+
+    unsigned int found = 0;
+    stopwatch sw2;
+    for(unsigned int r = 0; r < repeat; ++r)
+        found += q.contains(static_cast<V>(-1)) ? 1 : 0;
+    std::cout << "[contains]   ";
+    report(name, static_cast<unsigned long>(n) * repeat, sw2.seconds(), 0);
+
+    if(found > 0 || sum == static_cast<V>(42))
+        std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark della coda circolare rispetto alla coda a elementi
+*/
+void bench_ring() {
+    std::cout << "******** ring_queue vs queue ********" << std::endl;
+
+    bench_enqueue_dequeue<queue<int, equal_int> >("queue<int>", 20, 500000);
+    bench_enqueue_dequeue<ring_queue<int, equal_int> >("ring_queue<int>", 20,
+                                                       500000);
+
+    bench_scan<queue<int, equal_int>, int>("queue<int>", 1000000, 20);
+    bench_scan<ring_queue<int, equal_int>, int>("ring_queue<int>", 1000000,
+                                                20);
+    bench_scan<queue<float, equal_float>, float>("queue<float>", 1000000, 20);
+    bench_scan<ring_queue<float, equal_float>, float>("ring_queue<float>",
+                                                      1000000, 20);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark del pool dei nodi liberi della coda
+
+    @description
+	Confronta il ciclo di inserimenti e rimozioni della coda con il pool
+    disabilitato (capacità 0) e con il pool di capacità di default,
+    riportando il numero di allocazioni e la percentuale di riutilizzo
+    dei nodi.
+*/
+void bench_pool() {
+    std::cout << "******** Pool dei nodi liberi di queue ********" << std::endl;
+
+    const unsigned int n = 10000000;
+    const unsigned int capacities[] = {0, queue<int, equal_int>::
+                                          DEFAULT_POOL_CAPACITY, 1024};
+
+    for(unsigned int c = 0; c < 3; ++c) {
+        queue<int, equal_int> q;
+        q.set_pool_capacity(capacities[c]);
+        long sum = 0;
+
+        unsigned long allocs = allocations;
+        stopwatch sw;
+        for(unsigned int i = 0; i < n; ++i) {
+            q.enqueue(static_cast<int>(i));
+            if(i % 8 == 7)
+                while(q.size() > 0)
+                    sum += q.dequeue();
+        }
+        double secs = sw.seconds();
+
+        std::cout << "[capacita' " << capacities[c] << "] ";
+        report("queue", 2UL * n, secs, allocations - allocs);
+        double hits = static_cast<double>(q.pool_hits());
+        std::cout << "    riutilizzi del pool: " <<
+                     (100.0 * hits / (hits + q.pool_misses())) << "%" <<
+                     std::endl;
+        if(sum == 42)
+            std::cout << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark della coda con allocatore polimorfico
+
+    @description
+	Confronta il riempimento e la distruzione di una coda con l'allocatore
+    di default e di una pmr::queue che attinge da un
+    std::pmr::monotonic_buffer_resource, rilasciato in un'unica operazione
+    al termine di ogni richiesta.
+*/
+void bench_pmr() {
+    std::cout << "******** pmr::queue su arena monotona ********" << std::endl;
+
+    const unsigned int requests = 100;
+    const unsigned int n = 100000;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int r = 0; r < requests; ++r) {
+        queue<int, equal_int> q;
+        for(unsigned int i = 0; i < n; ++i)
+            q.enqueue(static_cast<int>(i));
+    }
+    report("queue", static_cast<unsigned long>(requests) * n, sw.seconds(),
+           allocations - allocs);
+
+    std::pmr::monotonic_buffer_resource arena;
+    allocs = allocations;
+    stopwatch sw2;
+    for(unsigned int r = 0; r < requests; ++r) {
+        {
+            pmr::queue<int, equal_int> q(&arena);
+            for(unsigned int i = 0; i < n; ++i)
+                q.enqueue(static_cast<int>(i));
+        }
+        arena.release();
+    }
+    report("pmr::queue", static_cast<unsigned long>(requests) * n,
+           sw2.seconds(), allocations - allocs);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Riempimento di una coda di code con copia o spostamento
+
+    @description
+	Inserisce n code di interi, ciascuna di m elementi, in una coda di code,
+    copiandole oppure spostandole, e misura il tempo e il numero
+    di allocazioni dell'intero riempimento (compresa la costruzione
+    delle code interne).
+
+    @tparam Q tipo della coda di code
+*/
+template <typename Q>
+void bench_nested(const char *name, bool move, unsigned int n,
+                  unsigned int m) {
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    {
+        Q q;
+        for(unsigned int i = 0; i < n; ++i) {
+            queue_int inner;
+            for(unsigned int j = 0; j < m; ++j)
+                inner.enqueue(static_cast<int>(j));
+            if(move)
+                q.enqueue(std::move(inner));
+            else
+                q.enqueue(inner);
+        }
+    }
+    double secs = sw.seconds();
+    std::cout << (move ? "[spostamento] " : "[copia]       ");
+    report(name, static_cast<unsigned long>(n) * m, secs,
+           allocations - allocs);
+}
+
+/**
+	@brief Benchmark della semantica di spostamento
+
+    @description
+	Confronta l'inserimento per copia e per spostamento di code annidate
+    nelle tre implementazioni della coda; nella coda circolare lo spostamento
+    evita anche la copia delle code interne quando il buffer cresce.
+*/
+void bench_move() {
+    std::cout << "******** Copia vs spostamento di code annidate ********" <<
+                 std::endl;
+
+    const unsigned int n = 20000;
+    const unsigned int m = 100;
+
+    for(int move = 0; move < 2; ++move) {
+        bench_nested<queue<queue_int, equal_queue_int> >("queue", move != 0, n,
+                                                         m);
+        bench_nested<chunked_queue<queue_int, equal_queue_int> >(
+            "chunked_queue", move != 0, n, m);
+        bench_nested<ring_queue<queue_int, equal_queue_int> >(
+            "ring_queue", move != 0, n, m);
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark della rimozione senza eccezioni
+
+    @description
+	Simula un consumatore che interroga ripetutamente una coda quasi sempre
+    vuota, confrontando dequeue con la gestione di empty_queue_exception
+    e try_dequeue; misura inoltre lo svuotamento di una coda di stringhe
+    lunghe, i cui valori vengono spostati anziché copiati.
+*/
+void bench_poll() {
+    std::cout << "******** dequeue vs try_dequeue ********" << std::endl;
+
+    const unsigned int polls = 200000;
+    queue<int, equal_int> q;
+    long sum = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int i = 0; i < polls; ++i) {
+        if(i % 16 == 0)
+            q.enqueue(static_cast<int>(i));
+        try {
+            sum += q.dequeue();
+        }
+        catch(empty_queue_exception &) {}
+    }
+    std::cout << "[interrogazione] ";
+    report("dequeue", polls, sw.seconds(), allocations - allocs);
+
+    allocs = allocations;
+    stopwatch sw2;
+    for(unsigned int i = 0; i < polls; ++i) {
+        if(i % 16 == 0)
+            q.enqueue(static_cast<int>(i));
+        int value;
+        if(q.try_dequeue(value))
+            sum += value;
+    }
+    std::cout << "[interrogazione] ";
+    report("try_dequeue", polls, sw2.seconds(), allocations - allocs);
+
+    const unsigned int n = 200000;
+    queue<std::string, equal_string> qs;
+    for(unsigned int i = 0; i < n; ++i)
+        qs.emplace(64, 'x');
+    allocs = allocations;
+    stopwatch sw3;
+    std::string s;
+    while(qs.try_dequeue(s))
+        sum += static_cast<long>(s.size());
+    std::cout << "[svuotamento]    ";
+    report("queue<std::string>", n, sw3.seconds(), allocations - allocs);
+
+    if(sum == 42)
+        std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Distruzione e svuotamento di una coda molto lunga
+
+    @description
+	Misura il tempo di distruzione di una coda di n elementi e quello
+    di clear seguito da un nuovo riempimento della stessa coda.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_destroy(const char *name, unsigned int n) {
+    Q *q = new Q();
+    for(unsigned int i = 0; i < n; ++i)
+        q->enqueue(static_cast<int>(i));
+    stopwatch sw;
+    delete q;
+    std::cout << "[distruzione]          ";
+    report(name, n, sw.seconds(), 0);
+
+    Q q2;
+    for(unsigned int i = 0; i < n; ++i)
+        q2.enqueue(static_cast<int>(i));
+    unsigned long allocs = allocations;
+    stopwatch sw2;
+    q2.clear();
+    for(unsigned int i = 0; i < n; ++i)
+        q2.enqueue(static_cast<int>(i));
+    std::cout << "[clear e riempimento]  ";
+    report(name, 2UL * n, sw2.seconds(), allocations - allocs);
+}
+
+/**
+	@brief Benchmark della distruzione di code da 10 milioni di elementi
+*/
+void bench_clear() {
+    std::cout << "******** Distruzione di code molto lunghe ********" <<
+                 std::endl;
+
+    const unsigned int n = 10000000;
+
+    bench_destroy<queue<int, equal_int> >("queue", n);
+    bench_destroy<chunked_queue<int, equal_int> >("chunked_queue", n);
+    bench_destroy<ring_queue<int, equal_int> >("ring_queue", n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark del passaggio di lotti di elementi tra code
+
+    @description
+	Simula produttori che consegnano lotti di elementi a un consumatore,
+    confrontando l'inserimento degli elementi di un vettore
+    (iteratori ad accesso casuale), di una coda (iteratori in avanti)
+    e la concatenazione in tempo costante con splice.
+*/
+void bench_splice() {
+    std::cout << "******** Consegna di lotti: enqueue vs splice ********" <<
+                 std::endl;
+
+    const unsigned int batches = 5000;
+    const unsigned int batch = 1000;
+    const unsigned long ops = static_cast<unsigned long>(batches) * batch;
+    long sum = 0;
+
+    std::vector<int> v(batch, 1);
+    {
+        queue_int q;
+        unsigned long allocs = allocations;
+        stopwatch sw;
+        for(unsigned int b = 0; b < batches; ++b) {
+            q.enqueue(v.begin(), v.end());
+            sum += q.size();
+            q.clear();
+        }
+        std::cout << "[da vettore]  ";
+        report("enqueue", ops, sw.seconds(), allocations - allocs);
+    }
+
+    {
+        queue_int q;
+        unsigned long allocs = allocations;
+        stopwatch sw;
+        for(unsigned int b = 0; b < batches; ++b) {
+            queue_int produced;
+            for(unsigned int i = 0; i < batch; ++i)
+                produced.enqueue(static_cast<int>(i));
+            q.enqueue(produced.begin(), produced.end());
+            sum += q.size();
+            q.clear();
+        }
+        std::cout << "[da coda]     ";
+        report("enqueue", ops, sw.seconds(), allocations - allocs);
+    }
+
+    {
+        queue_int q;
+        unsigned long allocs = allocations;
+        stopwatch sw;
+        for(unsigned int b = 0; b < batches; ++b) {
+            queue_int produced;
+            for(unsigned int i = 0; i < batch; ++i)
+                produced.enqueue(static_cast<int>(i));
+            q.splice(std::move(produced));
+            sum += q.size();
+            q.clear();
+        }
+        std::cout << "[da coda]     ";
+        report("splice", ops, sw.seconds(), allocations - allocs);
+    }
+
+    if(sum == 42)
+        std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra interi lunghi
+*/
+struct equal_long {
+    bool operator()(long long l1, long long l2) const {
+        return l1 == l2;
+    }
+};
+
+/**
+	@brief Istante corrente in nanosecondi
+*/
+long long now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+	@brief Assegnamento del thread chiamante a una CPU
+
+    @description
+	Va chiamata all'inizio del corpo del thread, prima delle operazioni
+    misurate, così che nessuna parte della misura venga eseguita prima
+    dell'assegnamento. La CPU viene scelta modulo il numero di CPU
+    disponibili; se l'assegnamento non riesce, il thread resta libero
+    di migrare.
+
+    @param cpu indice della CPU
+*/
+void pin_this_thread(unsigned int cpu) {
+    unsigned int cpus = std::thread::hardware_concurrency();
+    if(cpus == 0)
+        cpus = 1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/**
+	@brief Coda protetta da un mutex
+
+    @description
+	Adattatore della classe queue con l'interfaccia try_enqueue/try_dequeue,
+    che rappresenta la soluzione con lock da confrontare con spsc_queue.
+*/
+class locked_queue {
+
+    std::mutex _mutex; ///< @brief Mutex che protegge la coda
+    queue<long long, equal_long> _queue; ///< @brief Coda protetta
+
+public:
+
+    bool try_enqueue(long long value) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.enqueue(value);
+        return true;
+    }
+
+    bool try_dequeue(long long &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.try_dequeue(out);
+    }
+};
+
+/**
+	@brief Passaggio di elementi tra un produttore e un consumatore
+
+    @description
+	Il produttore, assegnato alla CPU 0, inserisce n istanti di invio;
+    il consumatore, assegnato alla CPU 1, li rimuove e misura la latenza
+    di ciascun elemento. Riporta il throughput e il 50° e 99° percentile
+    della latenza.
+
+    @tparam Q tipo della coda, con i metodi try_enqueue e try_dequeue
+*/
+template <typename Q>
+void bench_pipeline(const char *name, Q &q, unsigned int n) {
+    std::vector<long long> latencies(n);
+
+    stopwatch sw;
+    std::thread consumer([&]() {
+        pin_this_thread(1);
+        long long sent;
+        for(unsigned int i = 0; i < n; ++i) {
+            while(!q.try_dequeue(sent))
+                std::this_thread::yield();
+            latencies[i] = now_ns() - sent;
+        }
+    });
+    std::thread producer([&]() {
+        pin_this_thread(0);
+        for(unsigned int i = 0; i < n; ++i)
+            while(!q.try_enqueue(now_ns()))
+                std::this_thread::yield();
+    });
+    producer.join();
+    consumer.join();
+    double secs = sw.seconds();
+
+    std::nth_element(latencies.begin(), latencies.begin() + n / 2,
+                     latencies.end());
+    long long p50 = latencies[n / 2];
+    std::nth_element(latencies.begin(), latencies.begin() + n * 99 / 100,
+                     latencies.end());
+    long long p99 = latencies[n * 99 / 100];
+
+    std::cout << name << ": " << (n / secs / 1e6) << " Mop/s, latenza p50 " <<
+                 p50 << " ns, p99 " << p99 << " ns" << std::endl;
+}
+
+/**
+	@brief Benchmark della coda a singolo produttore e singolo consumatore
+*/
+void bench_spsc() {
+    std::cout << "******** spsc_queue vs queue con mutex ********" <<
+                 std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int n = 2000000;
+
+    locked_queue lq;
+    bench_pipeline("queue + mutex", lq, n);
+    spsc_queue<long long, equal_long> sq(1024);
+    bench_pipeline("spsc_queue<1024>", sq, n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Passaggio di elementi tra più produttori e più consumatori
+
+    @description
+	Avvia threads produttori, che inseriscono ciascuno n elementi,
+    e threads consumatori, che li rimuovono finché non sono stati ricevuti
+    tutti; ogni thread viene assegnato a una CPU diversa (modulo il numero
+    di CPU). Riporta il throughput complessivo.
+
+    @tparam Q tipo della coda, con i metodi try_enqueue e try_dequeue
+*/
+template <typename Q>
+double bench_fan_in(unsigned int threads, unsigned int n) {
+    Q q;
+    const long long total = static_cast<long long>(threads) * n;
+    std::atomic<long long> consumed(0);
+    std::vector<std::thread> workers;
+
+    stopwatch sw;
+    for(unsigned int c = 0; c < threads; ++c)
+        workers.push_back(std::thread([&, c]() {
+            pin_this_thread(c);
+            long long value;
+            while(consumed.load(std::memory_order_relaxed) < total)
+                if(q.try_dequeue(value))
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                else
+                    std::this_thread::yield();
+        }));
+    for(unsigned int p = 0; p < threads; ++p)
+        workers.push_back(std::thread([&, p]() {
+            pin_this_thread(threads + p);
+            for(unsigned int i = 0; i < n; ++i)
+                q.try_enqueue(static_cast<long long>(i));
+        }));
+    for(std::thread &t : workers)
+        t.join();
+    return total / sw.seconds() / 1e6;
+}
+
+/**
+	@brief Adattatore della coda a più produttori e più consumatori
+*/
+class mpmc_adapter {
+
+    mpmc_queue<long long, equal_long> _queue; ///< @brief Coda adattata
+
+public:
+
+    bool try_enqueue(long long value) {
+        _queue.enqueue(value);
+        return true;
+    }
+
+    bool try_dequeue(long long &out) {
+        return _queue.try_dequeue(out);
+    }
+};
+
+/**
+	@brief Benchmark di scalabilità della coda a più produttori e più
+	       consumatori
+
+    @description
+	Confronta mpmc_queue con una queue protetta da un mutex, al variare
+    del numero di coppie produttore/consumatore da 1 a N.
+*/
+void bench_mpmc() {
+    std::cout << "******** mpmc_queue vs queue con mutex ********" <<
+                 std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int items = 800000;
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if(max_threads < 8)
+        max_threads = 8;
+
+    for(unsigned int t = 1; t <= max_threads; t *= 2) {
+        double locked = bench_fan_in<locked_queue>(t, items / t);
+        double lock_free = bench_fan_in<mpmc_adapter>(t, items / t);
+        std::cout << t << " produttori + " << t << " consumatori: " <<
+                     "queue + mutex " << locked << " Mop/s, mpmc_queue " <<
+                     lock_free << " Mop/s" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Latenza di risveglio di un consumatore in attesa
+
+    @description
+	Il consumatore attende sulla coda vuota (con dequeue se blocking è
+    true, altrimenti ripetendo try_dequeue); il produttore invia n istanti,
+    con una pausa di 1 ms tra un invio e il successivo, in modo che ogni
+    invio trovi il consumatore in attesa. Riporta il 50° e 99° percentile
+    della latenza.
+*/
+void bench_wakeup(const char *name, bool blocking, unsigned int n) {
+    blocking_queue<long long, equal_long> q(16);
+    std::vector<long long> latencies(n);
+
+    std::thread consumer([&]() {
+        long long sent;
+        for(unsigned int i = 0; i < n; ++i) {
+            if(blocking)
+                sent = q.dequeue();
+            else
+                while(!q.try_dequeue(sent))
+                    std::this_thread::yield();
+            latencies[i] = now_ns() - sent;
+        }
+    });
+    for(unsigned int i = 0; i < n; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        q.enqueue(now_ns());
+    }
+    consumer.join();
+
+    std::nth_element(latencies.begin(), latencies.begin() + n / 2,
+                     latencies.end());
+    long long p50 = latencies[n / 2];
+    std::nth_element(latencies.begin(), latencies.begin() + n * 99 / 100,
+                     latencies.end());
+    long long p99 = latencies[n * 99 / 100];
+
+    std::cout << name << ": latenza di risveglio p50 " << p50 <<
+                 " ns, p99 " << p99 << " ns" << std::endl;
+}
+
+/**
+	@brief Tempo di CPU consumato da consumatori inattivi
+
+    @description
+	Avvia threads consumatori su una coda vuota e misura, per 200 ms,
+    il tempo di CPU del processo; i consumatori attendono con dequeue
+    se blocking è true, altrimenti ripetendo try_dequeue.
+*/
+void bench_idle(const char *name, bool blocking, unsigned int threads) {
+    blocking_queue<long long, equal_long> q(16);
+    std::vector<std::thread> consumers;
+
+    for(unsigned int c = 0; c < threads; ++c)
+        consumers.push_back(std::thread([&]() {
+            long long value;
+            if(blocking)
+                value = q.dequeue();
+            else
+                while(!q.try_dequeue(value))
+                    std::this_thread::yield();
+        }));
+
+    std::clock_t start = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    double cpu_ms = 1000.0 * (std::clock() - start) / CLOCKS_PER_SEC;
+
+    for(unsigned int c = 0; c < threads; ++c)
+        q.enqueue(0);
+    for(std::thread &t : consumers)
+        t.join();
+
+    std::cout << name << ": " << cpu_ms << " ms di CPU in 200 ms" <<
+                 std::endl;
+}
+
+/**
+	@brief Throughput con produttori e consumatori sbilanciati
+
+    @description
+	producers produttori inseriscono in totale n elementi in una coda
+    di capacità 1024, consumers consumatori li rimuovono. Con batch pari
+    a 1 si usano enqueue e dequeue di un elemento alla volta, altrimenti
+    l'inserimento da intervallo e dequeue_bulk a blocchi di batch elementi.
+    Terminati i produttori, ogni consumatore viene fermato da un valore -1.
+*/
+void bench_imbalance(unsigned int producers, unsigned int consumers,
+                     unsigned int batch, unsigned int n) {
+    blocking_queue<long long, equal_long> q(1024);
+    const unsigned int per_producer = n / producers / batch * batch;
+    const long long total = static_cast<long long>(per_producer) * producers;
+    std::vector<std::thread> consumer_threads;
+    std::vector<std::thread> producer_threads;
+
+    stopwatch sw;
+    for(unsigned int c = 0; c < consumers; ++c)
+        consumer_threads.push_back(std::thread([&]() {
+            std::vector<long long> values;
+            long long stops = 0;
+            while(stops == 0) {
+                values.clear();
+                if(batch == 1)
+                    values.push_back(q.dequeue());
+                else
+                    q.dequeue_bulk(std::back_inserter(values), batch);
+                stops = std::count(values.begin(), values.end(), -1LL);
+            }
+            // restituisce i valori di terminazione degli altri consumatori
+            for(; stops > 1; --stops)
+                q.enqueue(-1LL);
+        }));
+    for(unsigned int p = 0; p < producers; ++p)
+        producer_threads.push_back(std::thread([&]() {
+            std::vector<long long> values(batch);
+            for(unsigned int i = 0; i < per_producer; i += batch) {
+                if(batch == 1)
+                    q.enqueue(static_cast<long long>(i));
+                else
+                    q.enqueue(values.begin(), values.end());
+            }
+        }));
+    for(std::thread &t : producer_threads)
+        t.join();
+    for(unsigned int c = 0; c < consumers; ++c)
+        q.enqueue(-1LL);
+    for(std::thread &t : consumer_threads)
+        t.join();
+
+    std::cout << producers << " produttori + " << consumers <<
+                 " consumatori, blocchi da " << batch << ": " <<
+                 (total / sw.seconds() / 1e6) << " Mop/s" << std::endl;
+}
+
+/**
+	@brief Benchmark della coda bloccante
+
+    @description
+	Misura la latenza di risveglio e il tempo di CPU dei consumatori
+    inattivi, confrontando l'attesa sulla variabile condizione con
+    l'attesa attiva, e il throughput con produttori e consumatori
+    sbilanciati, con operazioni singole e a blocchi.
+*/
+void bench_blocking() {
+    std::cout << "******** blocking_queue ********" << std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    bench_wakeup("dequeue bloccante", true, 500);
+    bench_wakeup("try_dequeue in attesa attiva", false, 500);
+    bench_idle("4 consumatori in dequeue", true, 4);
+    bench_idle("4 consumatori in try_dequeue", false, 4);
+
+    const unsigned int n = 400000;
+    bench_imbalance(4, 1, 1, n);
+    bench_imbalance(4, 1, 64, n);
+    bench_imbalance(1, 4, 1, n);
+    bench_imbalance(1, 4, 64, n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra puntatori a task
+*/
+struct equal_task {
+    bool operator()(const std::function<void()> *t1,
+                    const std::function<void()> *t2) const {
+        return t1 == t2;
+    }
+};
+
+/**
+	@brief Pool di thread con un'unica coda condivisa protetta da un mutex
+
+    @description
+	Soluzione da confrontare con executor: tutti i task, compresi quelli
+    sottomessi dai task, passano per la stessa queue.
+*/
+class locked_executor {
+
+    typedef std::function<void()> task_type;
+
+    std::mutex _mutex; ///< @brief Mutex che protegge la coda e i contatori
+    std::condition_variable _ready; ///< @brief Attesa di nuovi task
+    std::condition_variable _done; ///< @brief Attesa del completamento
+    queue<task_type *, equal_task> _tasks; ///< @brief Coda condivisa
+    unsigned int _pending; ///< @brief Task non ancora completati
+    bool _stop; ///< @brief Richiesta di terminazione
+    std::vector<std::thread> _threads; ///< @brief Thread del pool
+
+    void work() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(true) {
+            _ready.wait(lock, [this]() { return _tasks.size() > 0 || _stop; });
+            if(_tasks.size() == 0)
+                return;
+            task_type *task = _tasks.dequeue();
+            lock.unlock();
+            (*task)();
+            delete task;
+            lock.lock();
+            if(--_pending == 0)
+                _done.notify_all();
+        }
+    }
+
+public:
+
+    explicit locked_executor(unsigned int threads) :
+        _pending(0), _stop(false) {
+        for(unsigned int i = 0; i < threads; ++i)
+            _threads.push_back(std::thread(&locked_executor::work, this));
+    }
+
+    ~locked_executor() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _ready.notify_all();
+        for(std::thread &t : _threads)
+            t.join();
+    }
+
+    template <typename F>
+    void submit(F &&f) {
+        task_type *task = new task_type(std::forward<F>(f));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.enqueue(task);
+            ++_pending;
+        }
+        _ready.notify_one();
+    }
+
+    void wait_all() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _pending == 0; });
+    }
+};
+
+/**
+	@brief Lavoro di una foglia del fork/join, limitato dalla CPU
+*/
+unsigned long long leaf_work(unsigned int iterations, unsigned long long x) {
+    for(unsigned int i = 0; i < iterations; ++i)
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    return x;
+}
+
+/**
+	@brief Fork/join su un albero binario di task
+
+    @description
+	Ogni task interno sottomette i due figli, ogni foglia esegue
+    iterations passi di un generatore congruenziale; la radice viene
+    sottomessa da un thread esterno, che attende il completamento
+    con wait_all. Restituisce il tempo impiegato in secondi.
+
+    @tparam X tipo del pool, con i metodi submit e wait_all
+*/
+template <typename X>
+double bench_fork_join(unsigned int threads, unsigned int depth,
+                       unsigned int iterations) {
+    X pool(threads);
+    std::atomic<unsigned long long> checksum(0);
+    std::function<void(unsigned int, unsigned long long)> fork =
+        [&](unsigned int level, unsigned long long seed) {
+            if(level == 0) {
+                checksum.fetch_add(leaf_work(iterations, seed),
+                                   std::memory_order_relaxed);
+                return;
+            }
+            pool.submit([&fork, level, seed]() { fork(level - 1, 2 * seed); });
+            pool.submit([&fork, level, seed]() {
+                fork(level - 1, 2 * seed + 1);
+            });
+        };
+
+    stopwatch sw;
+    pool.submit([&fork, depth]() { fork(depth, 1); });
+    pool.wait_all();
+    double secs = sw.seconds();
+    if(checksum.load() == 0)
+        std::cout << "checksum nullo" << std::endl;
+    return secs;
+}
+
+/**
+	@brief Benchmark del pool di thread con work stealing
+
+    @description
+	Confronta executor con un pool di thread con un'unica coda condivisa
+    protetta da un mutex, su un fork/join con 2^16 foglie, al variare
+    del numero di thread da 1 a N, riportando il tempo e lo speedup
+    rispetto a un thread.
+*/
+void bench_executor() {
+    std::cout << "******** executor vs coda condivisa con mutex ********" <<
+                 std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int depth = 16;
+    const unsigned int iterations = 2000;
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if(max_threads < 8)
+        max_threads = 8;
+
+    double locked_base = 0;
+    double stealing_base = 0;
+    for(unsigned int t = 1; t <= max_threads; t *= 2) {
+        double locked = bench_fork_join<locked_executor>(t, depth, iterations);
+        double stealing = bench_fork_join<executor>(t, depth, iterations);
+        if(t == 1) {
+            locked_base = locked;
+            stealing_base = stealing;
+        }
+        std::cout << t << " thread: coda con mutex " << locked * 1e3 <<
+                     " ms (speedup " << locked_base / locked <<
+                     "), executor " << stealing * 1e3 << " ms (speedup " <<
+                     stealing_base / stealing << ")" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Adattatore della coda suddivisa in 8 corsie
+*/
+class sharded_adapter {
+
+    sharded_queue<long long, equal_long> _queue; ///< @brief Coda adattata
+
+public:
+
+    sharded_adapter() : _queue(8) {}
+
+    bool try_enqueue(long long value) {
+        _queue.enqueue(value);
+        return true;
+    }
+
+    bool try_dequeue(long long &out) {
+        return _queue.try_dequeue(out);
+    }
+};
+
+/**
+	@brief Inserimenti concorrenti di più produttori
+
+    @description
+	Avvia threads produttori, che inseriscono ciascuno n elementi
+    nella stessa coda, senza consumatori. Restituisce il throughput
+    complessivo degli inserimenti.
+
+    @tparam Q tipo della coda, con il metodo try_enqueue
+*/
+template <typename Q>
+double bench_producers(unsigned int threads, unsigned int n) {
+    Q q;
+    std::vector<std::thread> producers;
+
+    stopwatch sw;
+    for(unsigned int p = 0; p < threads; ++p)
+        producers.push_back(std::thread([&, p]() {
+            pin_this_thread(p);
+            for(unsigned int i = 0; i < n; ++i)
+                q.try_enqueue(static_cast<long long>(i));
+        }));
+    for(std::thread &t : producers)
+        t.join();
+    return static_cast<double>(threads) * n / sw.seconds() / 1e6;
+}
+
+/**
+	@brief Benchmark della coda suddivisa in corsie
+
+    @description
+	Confronta sharded_queue (8 corsie) con una queue protetta da un mutex,
+    con soli produttori e con coppie produttore/consumatore, al variare
+    del numero di thread da 1 a N.
+*/
+void bench_sharded() {
+    std::cout << "******** sharded_queue vs queue con mutex ********" <<
+                 std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int items = 800000;
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if(max_threads < 8)
+        max_threads = 8;
+
+    for(unsigned int t = 1; t <= max_threads; t *= 2) {
+        double locked = bench_producers<locked_queue>(t, items / t);
+        double sharded = bench_producers<sharded_adapter>(t, items / t);
+        std::cout << t << " produttori: queue + mutex " << locked <<
+                     " Mop/s, sharded_queue " << sharded << " Mop/s" <<
+                     std::endl;
+    }
+    for(unsigned int t = 1; t <= max_threads; t *= 2) {
+        double locked = bench_fan_in<locked_queue>(t, items / t);
+        double sharded = bench_fan_in<sharded_adapter>(t, items / t);
+        std::cout << t << " produttori + " << t << " consumatori: " <<
+                     "queue + mutex " << locked << " Mop/s, sharded_queue " <<
+                     sharded << " Mop/s" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Adattatore della coda con flat combining
+*/
+class flat_combining_adapter {
+
+    flat_combining_queue<long long, equal_long> _queue; ///< @brief Coda
+                                                        ///< adattata
+
+public:
+
+    bool try_enqueue(long long value) {
+        _queue.enqueue(value);
+        return true;
+    }
+
+    bool try_dequeue(long long &out) {
+        return _queue.try_dequeue(out);
+    }
+};
+
+/**
+	@brief Benchmark della coda con flat combining
+
+    @description
+	Matrice di confronto tra una queue protetta da un mutex,
+    flat_combining_queue e mpmc_queue, con un numero uguale di produttori
+    e consumatori, al variare del numero complessivo di thread da 2 a 32.
+*/
+void bench_combining() {
+    std::cout << "******** queue con mutex vs flat combining vs mpmc_queue "
+                 "********" << std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int items = 800000;
+    std::cout << "thread\tmutex\tcombining\tmpmc (Mop/s)" << std::endl;
+    for(unsigned int t = 1; t <= 16; t *= 2) {
+        double locked = bench_fan_in<locked_queue>(t, items / t);
+        double combining = bench_fan_in<flat_combining_adapter>(t, items / t);
+        double lock_free = bench_fan_in<mpmc_adapter>(t, items / t);
+        std::cout << 2 * t << "\t" << locked << "\t" << combining << "\t" <<
+                     lock_free << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra coroutine
+*/
+struct equal_handle {
+    bool operator()(std::coroutine_handle<> h1,
+                    std::coroutine_handle<> h2) const {
+        return h1 == h2;
+    }
+};
+
+/**
+	@brief Coroutine senza risultato, avviata subito e distrutta al termine
+*/
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() { return detached_task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+	@brief Event loop a singolo thread
+*/
+class event_loop {
+
+    ring_queue<std::coroutine_handle<>, equal_handle> _ready; ///< @brief
+                                                              ///< Coroutine
+                                                              ///< pronte
+
+public:
+
+    void post(std::coroutine_handle<> handle) {
+        _ready.enqueue(handle);
+    }
+
+    unsigned int run() {
+        unsigned int resumed = 0;
+        std::coroutine_handle<> handle;
+        while(_ready.try_dequeue(handle)) {
+            handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+};
+
+/**
+	@brief Scheduler che affida la ripresa delle coroutine a un event loop
+
+    @description
+	Se l'inserimento nell'event loop fallisce il programma termina:
+    async_queue richiede uno scheduler noexcept.
+*/
+struct loop_scheduler {
+    event_loop *loop; ///< @brief Event loop
+
+    void operator()(std::coroutine_handle<> handle) const noexcept {
+        loop->post(handle);
+    }
+};
+
+typedef async_queue<long long, equal_long, loop_scheduler> async_queue_long;
+
+/**
+	@brief Consumatore che conta i valori ricevuti fino al primo valore
+	       negativo
+*/
+detached_task async_consumer(async_queue_long &q, unsigned long &received) {
+    while(true) {
+        long long value = co_await q.dequeue();
+        if(value < 0)
+            break;
+        ++received;
+    }
+}
+
+/**
+	@brief Benchmark della coda asincrona
+
+    @description
+	Su un solo thread, con un event loop: misura il throughput
+    di enqueue e ripresa con 10000 coroutine consumatrici in attesa
+    e quello di co_await su una coda mai vuota, senza sospensione.
+    Per confronto, riporta il throughput di blocking_queue con un thread
+    produttore e un thread consumatore.
+*/
+void bench_async() {
+    std::cout << "******** async_queue ********" << std::endl;
+
+    const unsigned int n = 2000000;
+    const unsigned int consumers = 10000;
+
+    {
+        event_loop loop;
+        async_queue_long q(loop_scheduler{&loop});
+        unsigned long received = 0;
+        for(unsigned int c = 0; c < consumers; ++c)
+            async_consumer(q, received);
+        std::cout << "Coroutine in attesa: " << q.waiting() <<
+                     ", thread: 1" << std::endl;
+
+        stopwatch sw;
+        for(unsigned int i = 0; i < n; i += consumers) {
+            for(unsigned int c = 0; c < consumers; ++c)
+                q.enqueue(static_cast<long long>(i + c));
+            loop.run();
+        }
+        double secs = sw.seconds();
+        std::cout << "enqueue + ripresa di una coroutine in attesa: " <<
+                     (received / secs / 1e6) << " Mop/s" << std::endl;
+
+        for(unsigned int c = 0; c < consumers; ++c)
+            q.enqueue(-1);
+        loop.run();
+    }
+
+    {
+        event_loop loop;
+        async_queue_long q(loop_scheduler{&loop});
+        unsigned long received = 0;
+        for(unsigned int i = 0; i < n; ++i)
+            q.enqueue(static_cast<long long>(i));
+        q.enqueue(-1);
+
+        stopwatch sw;
+        async_consumer(q, received); // non viene mai sospesa
+        double secs = sw.seconds();
+        std::cout << "co_await senza sospensione: " <<
+                     (received / secs / 1e6) << " Mop/s" << std::endl;
+    }
+
+    {
+        blocking_queue<long long, equal_long> q(1024);
+        stopwatch sw;
+        std::thread consumer([&]() {
+            while(q.dequeue() >= 0)
+                ;
+        });
+        for(unsigned int i = 0; i < n; ++i)
+            q.enqueue(static_cast<long long>(i));
+        q.enqueue(-1);
+        consumer.join();
+        std::cout << "blocking_queue, 2 thread: " << (n / sw.seconds() / 1e6) <<
+                     " Mop/s" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Coda di stringhe protetta da un mutex, per la distribuzione
+	       con una copia per consumatore
+*/
+struct locked_string_queue {
+    std::mutex mutex; ///< @brief Mutex che protegge la coda
+    queue<std::string, equal_string> items; ///< @brief Coda protetta
+};
+
+/**
+	@brief Distribuzione di n messaggi a più consumatori
+
+    @description
+	Il produttore pubblica n stringhe di 64 caratteri, che ciascuno
+    dei consumatori legge per intero; se multicast è true, tramite
+    un multicast_ring condiviso, altrimenti copiando ogni stringa
+    in una queue per consumatore, protetta da un mutex. Riporta
+    il throughput in messaggi pubblicati al secondo e le allocazioni
+    per messaggio.
+*/
+void bench_fan_out(bool multicast, unsigned int consumers, unsigned int n) {
+    const std::string message(64, 'x');
+    multicast_ring<std::string, equal_string> ring(1024, consumers);
+    std::vector<std::unique_ptr<locked_string_queue>> queues;
+    for(unsigned int c = 0; c < consumers; ++c)
+        queues.push_back(std::unique_ptr<locked_string_queue>(
+            new locked_string_queue()));
+    std::vector<unsigned long> bytes(consumers, 0);
+    std::vector<std::thread> threads;
+
+    unsigned long before = allocations;
+    stopwatch sw;
+    for(unsigned int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&, c]() {
+            unsigned int received = 0;
+            std::string value;
+            while(received < n) {
+                unsigned int got = 0;
+                if(multicast)
+                    got = ring.consume(c, [&](const std::string &v) {
+                        bytes[c] += v.size();
+                    });
+                else {
+                    std::lock_guard<std::mutex> lock(queues[c]->mutex);
+                    while(queues[c]->items.try_dequeue(value)) {
+                        bytes[c] += value.size();
+                        ++got;
+                    }
+                }
+                received += got;
+                if(got == 0)
+                    std::this_thread::yield();
+            }
+        }));
+    for(unsigned int i = 0; i < n; ++i) {
+        if(multicast)
+            ring.publish(message);
+        else
+            for(unsigned int c = 0; c < consumers; ++c) {
+                std::lock_guard<std::mutex> lock(queues[c]->mutex);
+                queues[c]->items.enqueue(message);
+            }
+    }
+    for(std::thread &t : threads)
+        t.join();
+    double secs = sw.seconds();
+
+    std::cout << (multicast ? "multicast_ring" : "queue per consumatore") <<
+                 ", " << consumers << " consumatori: " << (n / secs / 1e6) <<
+                 " M messaggi/s, " <<
+                 static_cast<double>(allocations - before) / n <<
+                 " allocazioni per messaggio" << std::endl;
+}
+
+/**
+	@brief Benchmark del buffer multicast
+
+    @description
+	Confronta multicast_ring con la distribuzione tramite una queue
+    per consumatore, al variare del numero di consumatori.
+*/
+void bench_multicast() {
+    std::cout << "******** multicast_ring vs una queue per consumatore "
+                 "********" << std::endl;
+    std::cout << "CPU disponibili: " << std::thread::hardware_concurrency() <<
+                 std::endl;
+
+    const unsigned int n = 500000;
+    for(unsigned int c = 1; c <= 8; c *= 2) {
+        bench_fan_out(false, c, n);
+        bench_fan_out(true, c, n);
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Livelli di priorità del benchmark della coda a più livelli
+*/
+const unsigned int bench_levels = 32;
+
+/**
+	@brief Coda a più livelli con ricerca lineare del livello non vuoto
+
+    @description
+	Riferimento per multilevel_queue: gli stessi livelli FIFO, ma
+    la testa si trova scorrendo i livelli dal più alto.
+*/
+struct scanning_levels {
+    std::array<queue<int, equal_int>, bench_levels> levels;
+
+    void enqueue(unsigned int level, int value) {
+        levels[level].enqueue(value);
+    }
+
+    bool try_dequeue(int &out) {
+        for(unsigned int l = bench_levels; l-- > 0; )
+            if(levels[l].try_dequeue(out))
+                return true;
+        return false;
+    }
+};
+
+/**
+	@brief Heap binario con numero di sequenza per la stabilità FIFO
+*/
+struct sequenced_heap {
+    /**
+        @brief Elemento dello heap: livello, sequenza e valore
+    */
+    struct entry {
+        unsigned int level;
+        unsigned long sequence;
+        int value;
+
+        bool operator<(const entry &other) const {
+            if(level != other.level)
+                return level < other.level;
+            return sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<entry> heap;
+    unsigned long next = 0;
+
+    void enqueue(unsigned int level, int value) {
+        heap.push(entry{level, next++, value});
+    }
+
+    bool try_dequeue(int &out) {
+        if(heap.empty())
+            return false;
+        out = heap.top().value;
+        heap.pop();
+        return true;
+    }
+};
+
+/**
+	@brief Adattatore di multilevel_queue all'interfaccia del benchmark
+*/
+struct multilevel_adapter {
+    multilevel_queue<int, equal_int, bench_levels> q;
+
+    void enqueue(unsigned int level, int value) {
+        q.enqueue(level, value);
+    }
+
+    bool try_dequeue(int &out) {
+        return q.try_dequeue(out);
+    }
+};
+
+/**
+	@brief Ciclo stazionario su una coda con priorità
+
+    @description
+	Riempie la coda con backlog elementi e poi esegue n cicli in cui
+    a ogni rimozione segue un inserimento in un livello pseudo-casuale
+    (un generatore congruenziale, uguale per tutte le code).
+    Con pochi livelli occupati la ricerca lineare scorre molti livelli
+    vuoti, mentre lo heap paga un costo logaritmico nel backlog.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_priority(const char *name, unsigned int backlog,
+                    unsigned int used_levels, unsigned int n) {
+    Q q;
+    unsigned int seed = 12345;
+    auto next_level = [&seed, used_levels]() {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % used_levels;
+    };
+    for(unsigned int i = 0; i < backlog; ++i)
+        q.enqueue(next_level(), static_cast<int>(i));
+    long sum = 0;
+    int out = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int i = 0; i < n; ++i) {
+        if(q.try_dequeue(out))
+            sum += out;
+        q.enqueue(next_level(), static_cast<int>(i));
+    }
+    double secs = sw.seconds();
+    report(name, 2ul * n, secs, allocations - allocs);
+    if(sum == 42)
+        std::cout << std::endl; // impedisce di eliminare il ciclo
+}
+
+/**
+	@brief Benchmark della coda a più livelli
+
+    @description
+	Confronta multilevel_queue, che trova il livello di priorità massima
+    con la maschera dei livelli non vuoti, con la ricerca lineare
+    sui livelli e con uno heap binario stabilizzato da un numero
+    di sequenza.
+*/
+void bench_multilevel() {
+    std::cout << "******** multilevel_queue vs ricerca lineare vs heap "
+                 "********" << std::endl;
+
+    const unsigned int n = 2000000;
+    const unsigned int backlogs[] = {16, 4096};
+    const unsigned int used[] = {2, bench_levels};
+    for(unsigned int b : backlogs)
+        for(unsigned int u : used) {
+            std::cout << "backlog " << b << ", livelli usati " << u << " su " <<
+                         bench_levels << ":" << std::endl;
+            bench_priority<multilevel_adapter>("multilevel_queue", b, u, n);
+            bench_priority<scanning_levels>("ricerca lineare", b, u, n);
+            bench_priority<sequenced_heap>("priority_queue", b, u, n);
+        }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Orologio simulato del benchmark della coda con scadenza
+
+    @description
+	L'istante corrente avanza di un tick per passo del benchmark,
+    in modo che il costo misurato sia quello della coda e non quello
+    della lettura dell'orologio di sistema.
+*/
+struct bench_clock {
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<bench_clock> time_point;
+    static const bool is_steady = true;
+
+    static time_point now() {
+        return time_point();
+    }
+};
+
+/**
+	@brief Adattatore di delay_queue all'interfaccia del benchmark
+*/
+struct wheel_timers {
+    delay_queue<int, equal_int, bench_clock> q{bench_clock::duration(1)};
+
+    void schedule(unsigned long long deadline, int value) {
+        q.enqueue(bench_clock::time_point(bench_clock::duration(deadline)),
+                  value);
+    }
+
+    bool expire(unsigned long long now, int &out) {
+        return q.try_dequeue(bench_clock::time_point(bench_clock::duration(now)),
+                             out);
+    }
+};
+
+/**
+	@brief Heap binario di timer, con numero di sequenza per la stabilità
+*/
+struct heap_timers {
+    /**
+        @brief Timer dello heap: scadenza, sequenza e valore
+    */
+    struct entry {
+        unsigned long long deadline;
+        unsigned long sequence;
+        int value;
+
+        bool operator<(const entry &other) const {
+            if(deadline != other.deadline)
+                return deadline > other.deadline;
+            return sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<entry> heap;
+    unsigned long next = 0;
+
+    void schedule(unsigned long long deadline, int value) {
+        heap.push(entry{deadline, next++, value});
+    }
+
+    bool expire(unsigned long long now, int &out) {
+        if(heap.empty() || heap.top().deadline > now)
+            return false;
+        out = heap.top().value;
+        heap.pop();
+        return true;
+    }
+};
+
+/**
+	@brief Ciclo stazionario di inserimenti e scadenze di timer
+
+    @description
+	Programma pending timer con scadenze pseudo-casuali entro horizon tick
+    e poi, a ogni tick, inserisce per ogni timer scaduto un nuovo timer
+    con una scadenza pseudo-casuale, mantenendo costante il numero
+    di timer in attesa (come una coda di ritrasmissioni).
+
+    @tparam Q tipo della coda di timer
+*/
+template <typename Q>
+void bench_timers(const char *name, unsigned int pending,
+                  unsigned long long horizon, unsigned int n) {
+    Q q;
+    unsigned int seed = 12345;
+    auto next_delay = [&seed, horizon]() {
+        seed = seed * 1103515245u + 12345u;
+        return 1 + (seed >> 4) % horizon;
+    };
+    for(unsigned int i = 0; i < pending; ++i)
+        q.schedule(next_delay(), static_cast<int>(i));
+    long sum = 0;
+    int out = 0;
+    unsigned long ops = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned long long now = 1; ops < 2ul * n; ++now)
+        while(q.expire(now, out)) {
+            sum += out;
+            q.schedule(now + next_delay(), out);
+            ops += 2;
+        }
+    double secs = sw.seconds();
+    report(name, ops, secs, allocations - allocs);
+    if(sum == 42)
+        std::cout << std::endl; // impedisce di eliminare il ciclo
+}
+
+/**
+	@brief Benchmark della coda con scadenza
+
+    @description
+	Confronta delay_queue, la cui ruota temporale gerarchica inserisce
+    e fa scadere i timer in tempo costante ammortizzato, con uno heap
+    binario, il cui costo cresce con il logaritmo dei timer in attesa.
+*/
+void bench_delay() {
+    std::cout << "******** delay_queue vs heap di timer ********" << std::endl;
+
+    const unsigned int n = 4000000;
+    const unsigned int pending[] = {1000, 1000000};
+    for(unsigned int p : pending) {
+        std::cout << p << " timer in attesa, scadenze entro " << 4ull * p <<
+                     " tick:" << std::endl;
+        bench_timers<wheel_timers>("delay_queue", p, 4ull * p, n);
+        bench_timers<heap_timers>("priority_queue", p, 4ull * p, n);
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Costo di contains su una coda di n interi
+
+    @description
+	Cerca lookups valori, metà presenti e metà assenti, in una coda
+    di n interi distinti.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_lookup(const char *name, unsigned int n, unsigned int lookups) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<int>(2 * i));
+    unsigned int found = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int i = 0; i < lookups; ++i)
+        if(q.contains(static_cast<int>((i * 2654435761u) % (2 * n))))
+            ++found;
+    double secs = sw.seconds();
+    report(name, lookups, secs, allocations - allocs);
+    if(found == 42)
+        std::cout << std::endl; // impedisce di eliminare il ciclo
+}
+
+/**
+	@brief Costo di inserimento e rimozione con l'indice
+
+    @description
+	Mantiene nella coda backlog interi e poi esegue n cicli
+    di inserimento e rimozione, per misurare il costo aggiunto
+    dall'aggiornamento dell'indice.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_indexed_cycle(const char *name, unsigned int backlog,
+                         unsigned int n) {
+    Q q;
+    for(unsigned int i = 0; i < backlog; ++i)
+        q.enqueue(static_cast<int>(i));
+    long sum = 0;
+    int out = 0;
+
+    unsigned long allocs = allocations;
+    stopwatch sw;
+    for(unsigned int i = 0; i < n; ++i) {
+        q.enqueue(static_cast<int>(backlog + i));
+        if(q.try_dequeue(out))
+            sum += out;
+    }
+    double secs = sw.seconds();
+    report(name, 2ul * n, secs, allocations - allocs);
+    if(sum == 42)
+        std::cout << std::endl; // impedisce di eliminare il ciclo
+}
+
+/**
+	@brief Benchmark della coda con indice hash
+
+    @description
+	Confronta contains di hashed_queue, una ricerca nell'indice,
+    con la scansione lineare di queue al crescere della coda,
+    e misura il costo dell'indice su inserimenti e rimozioni.
+*/
+void bench_hashed() {
+    std::cout << "******** hashed_queue vs queue ********" << std::endl;
+
+    const unsigned int sizes[] = {1000, 100000, 1000000};
+    for(unsigned int n : sizes) {
+        std::cout << "contains su " << n << " elementi:" << std::endl;
+        bench_lookup<hashed_queue<int, equal_int> >("hashed_queue", n, 1000000);
+        bench_lookup<queue<int, equal_int> >("queue", n,
+                                             100000000u / n);
+    }
+    std::cout << "inserimento e rimozione con 100000 elementi:" << std::endl;
+    bench_indexed_cycle<hashed_queue<int, equal_int> >("hashed_queue", 100000,
+                                                       2000000);
+    bench_indexed_cycle<queue<int, equal_int> >("queue", 100000, 2000000);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra float non dichiarato semplice
+
+    @description
+	Forza la ricerca che chiama il funtore su un elemento alla volta.
+*/
+struct equal_float_functor {
+    bool operator()(float f1, float f2) const {
+        return f1 == f2;
+    }
+};
+
+/**
+	@brief Costo di contains, find e count su una coda di n float
+
+    @description
+	Riempie la coda con n valori tutti diversi da quello cercato,
+    così che ogni ricerca scandisca l'intera coda, e ripete la ricerca
+    fino a visitare circa 2^28 elementi. Il risultato è espresso
+    in miliardi di elementi visitati al secondo.
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_scan(const char *name, unsigned int n) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<float>(i % 1000));
+    const unsigned int rounds = (1u << 28) / n;
+    unsigned long hits = 0;
+
+    stopwatch sw;
+    for(unsigned int r = 0; r < rounds; ++r)
+        hits += q.contains(-1.0f);
+    double contains_secs = sw.seconds();
+    stopwatch sw_count;
+    for(unsigned int r = 0; r < rounds; ++r)
+        hits += q.count(-1.0f);
+    double count_secs = sw_count.seconds();
+
+    double visited = static_cast<double>(rounds) * n / 1e9;
+    std::cout << name << ": contains " << visited / contains_secs <<
+                 " G elementi/s, count " << visited / count_secs <<
+                 " G elementi/s" << std::endl;
+    if(hits == 42)
+        std::cout << std::endl; // impedisce di eliminare il ciclo
+}
+
+/**
+	@brief Benchmark della ricerca vettoriale
+
+    @description
+	Confronta la ricerca di ring_queue e chunked_queue con funtore
+    di uguaglianza semplice (confronti SSE2/AVX2) con la stessa ricerca
+    che chiama il funtore su un elemento alla volta e con la scansione
+    della lista di queue, al crescere della coda.
+*/
+void bench_simd() {
+    std::cout << "******** ricerca vettoriale vs funtore ********" << std::endl;
+
+    const unsigned int sizes[] = {64, 4096, 262144, 4194304};
+    for(unsigned int n : sizes) {
+        std::cout << n << " elementi:" << std::endl;
+        bench_scan<ring_queue<float, equal_float> >("ring_queue simd", n);
+        bench_scan<ring_queue<float, equal_float_functor> >("ring_queue "
+                                                            "funtore", n);
+        bench_scan<chunked_queue<float, equal_float> >("chunked_queue simd",
+                                                       n);
+        bench_scan<queue<float, equal_float> >("queue", n);
+    }
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Predicato di bench_transform: valori minori di una soglia
+*/
+struct below_float {
+    float value; ///< @brief Soglia
+    bool operator()(float f) const {
+        return f < value;
+    }
+};
+
+/**
+	@brief Operatore di bench_transform: trasformazione affine
+
+    @description
+	Definito su tutti i float, è speculativo: le politiche vettorizzabili
+    possono calcolarlo su tutti gli elementi di un blocco.
+*/
+struct affine_float : execution::speculative_op_tag {
+    float scale; ///< @brief Fattore di scala
+    float shift; ///< @brief Traslazione
+    float operator()(float f) const {
+        return f * scale + shift;
+    }
+};
+
+/**
+	@brief Costo di transformif su una coda di n float con una politica
+
+    @description
+	Ripete la trasformazione fino a visitare circa 2^28 elementi
+    e stampa i milioni di elementi visitati al secondo. Il predicato
+    seleziona circa metà degli elementi, in ordine irregolare, così che
+    il ciclo con salti condizionati paghi gli errori di predizione;
+    l'operatore lascia invariati i valori, così che la selezione resti
+    la stessa a ogni ripetizione.
+
+    @tparam Q tipo della coda
+    @tparam Policy politica di esecuzione (oppure numero di thread)
+*/
+template <typename Q, typename Policy>
+double bench_transform(Q &q, Policy policy) {
+    const unsigned int rounds = (1u << 28) / q.size();
+    stopwatch sw;
+    for(unsigned int r = 0; r < rounds; ++r)
+        transformif(q, policy, below_float{500.0f},
+                    affine_float{{}, 1.0f, 0.0f});
+    return static_cast<double>(rounds) * q.size() / 1e6 / sw.seconds();
+}
+
+/**
+	@brief Scalabilità di transformif su una coda
+
+    @tparam Q tipo della coda
+*/
+template <typename Q>
+void bench_scaling(const char *name, unsigned int n) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<float>((i * 2654435761u) % 1000));
+
+    std::cout << name << ": seq " << bench_transform(q, execution::seq) <<
+                 ", unseq " << bench_transform(q, execution::unseq) <<
+                 " M elementi/s" << std::endl;
+    const unsigned int cores = std::thread::hardware_concurrency();
+    for(unsigned int t = 1; t <= cores; t *= 2) {
+        std::cout << "  " << t << " thread: par " <<
+                     bench_transform(q, execution::parallel_policy(t)) <<
+                     ", par_unseq " <<
+                     bench_transform(q,
+                         execution::parallel_unsequenced_policy(t)) <<
+                     " M elementi/s" << std::endl;
+        if(t < cores && t * 2 > cores)
+            t = cores / 2; // l'ultima misura usa tutti i core
+    }
+}
+
+/**
+	@brief Benchmark di transformif parallela
+
+    @description
+	Misura transformif con politica sequenziale, vettorizzabile
+    e parallela, con un numero di thread crescente da 1 al numero di core,
+    su una coda di 4M float per ciascuna classe.
+*/
+void bench_parallel() {
+    std::cout << "******** transformif parallela ********" << std::endl;
+
+    const unsigned int n = 1u << 22;
+    bench_scaling<ring_queue<float, equal_float> >("ring_queue", n);
+    bench_scaling<chunked_queue<float, equal_float> >("chunked_queue", n);
+    bench_scaling<queue<float, equal_float> >("queue", n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Algoritmi a passata unica contro copia e scansione
+
+    @description
+	Su una coda di n interi confronta count_if, reduce, transform_into
+    e remove_if, sequenziali e paralleli, con lo schema "copia la coda,
+    poi visita la copia" (come add_queue_int nei test) e, per remove_if,
+    con la ricostruzione di una nuova coda con i soli elementi mantenuti.
+    Per remove_if la copia di partenza, necessaria a ogni ripetizione,
+    viene fatta fuori dalla misura. Il risultato è espresso in milioni
+    di elementi visitati al secondo.
+
+    @tparam Q tipo della coda di interi
+*/
+template <typename Q>
+void bench_fused(const char *name, unsigned int n) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<int>((i * 2654435761u) % 1000));
+    const unsigned int rounds = (1u << 25) / n;
+    const unsigned long ops = static_cast<unsigned long>(rounds) * n;
+    auto odd = [](int i) { return i % 2 != 0; };
+    auto twice = [](int i) { return 2 * i; };
+    unsigned long sink = 0;
+
+    std::cout << name << ":" << std::endl;
+
+    unsigned long allocs = allocations;
+    stopwatch sw_copy_count;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        Q copy(q);
+        unsigned int c = 0;
+        for(typename Q::const_iterator i = copy.begin(); i != copy.end(); ++i)
+            c += odd(*i) ? 1 : 0;
+        sink += c;
+    }
+    report("  conteggio copia+scansione", ops, sw_copy_count.seconds(),
+           allocations - allocs);
+    allocs = allocations;
+    stopwatch sw_count;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        q.set_head(static_cast<int>(r % 1000)); // impedisce di riusare
+                                                // il risultato
+        sink += count_if(q, odd);
+    }
+    report("  count_if", ops, sw_count.seconds(), allocations - allocs);
+    allocs = allocations;
+    stopwatch sw_par_count;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        q.set_head(static_cast<int>(r % 1000)); // impedisce di riusare
+                                                // il risultato
+        sink += count_if(q, execution::par, odd);
+    }
+    report("  count_if par", ops, sw_par_count.seconds(), allocations - allocs);
+
+    allocs = allocations;
+    stopwatch sw_reduce;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        q.set_head(static_cast<int>(r % 1000)); // impedisce di riusare
+                                                // il risultato
+        sink += reduce(q, 0L);
+    }
+    report("  reduce", ops, sw_reduce.seconds(), allocations - allocs);
+    allocs = allocations;
+    stopwatch sw_par_reduce;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        q.set_head(static_cast<int>(r % 1000)); // impedisce di riusare
+                                                // il risultato
+        sink += reduce(q, execution::par, 0L);
+    }
+    report("  reduce par", ops, sw_par_reduce.seconds(), allocations - allocs);
+
+    allocs = allocations;
+    stopwatch sw_copy_transform;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        Q copy(q);
+        transformif(copy, odd, twice);
+        sink += copy.size();
+    }
+    report("  copia+transformif", ops, sw_copy_transform.seconds(),
+           allocations - allocs);
+    allocs = allocations;
+    stopwatch sw_transform;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        Q out;
+        sink += transform_into(q, out, twice);
+    }
+    report("  transform_into", ops, sw_transform.seconds(),
+           allocations - allocs);
+    allocs = allocations;
+    stopwatch sw_par_transform;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        Q out;
+        sink += transform_into(q, execution::par, out, twice);
+    }
+    report("  transform_into par", ops, sw_par_transform.seconds(),
+           allocations - allocs);
+
+    double rebuild_secs = 0, remove_secs = 0, par_remove_secs = 0;
+    unsigned long rebuild_allocs = 0, remove_allocs = 0, par_remove_allocs = 0;
+    for(unsigned int r = 0; r < rounds; ++r) {
+        Q a(q), b(q), c(q);
+
+        allocs = allocations;
+        stopwatch sw_rebuild;
+        Q kept;
+        for(typename Q::const_iterator i = a.begin(); i != a.end(); ++i)
+            if(!odd(*i))
+                kept.enqueue(*i);
+        a = std::move(kept);
+        rebuild_secs += sw_rebuild.seconds();
+        rebuild_allocs += allocations - allocs;
+
+        allocs = allocations;
+        stopwatch sw_remove;
+        sink += remove_if(b, odd);
+        remove_secs += sw_remove.seconds();
+        remove_allocs += allocations - allocs;
+
+        allocs = allocations;
+        stopwatch sw_par_remove;
+        sink += remove_if(c, execution::par, odd);
+        par_remove_secs += sw_par_remove.seconds();
+        par_remove_allocs += allocations - allocs;
+        sink += a.size() + b.size() + c.size();
+    }
+    report("  ricostruzione filtrata", ops, rebuild_secs, rebuild_allocs);
+    report("  remove_if", ops, remove_secs, remove_allocs);
+    report("  remove_if par", ops, par_remove_secs, par_remove_allocs);
+
+    if(sink == 42)
+        std::cout << std::endl; // impedisce di eliminare i cicli
+}
+
+/**
+	@brief Benchmark degli algoritmi
+
+    @description
+	Esegue bench_fused su una coda di 1M interi per ciascuna classe.
+*/
+void bench_algorithms() {
+    std::cout << "******** algoritmi vs copia e scansione ********" << std::endl;
+
+    const unsigned int n = 1u << 20;
+    bench_fused<ring_queue<int, equal_int> >("ring_queue", n);
+    bench_fused<chunked_queue<int, equal_int> >("chunked_queue", n);
+    bench_fused<queue<int, equal_int> >("queue", n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Buffer di stream che scarta i caratteri
+
+    @description
+	Conta i caratteri ricevuti senza memorizzarli, per misurare il costo
+    della formattazione senza quello della scrittura.
+*/
+class discard_buffer : public std::streambuf {
+
+    unsigned long _count; ///< @brief Numero di caratteri ricevuti
+
+protected:
+
+    int_type overflow(int_type c) override {
+        ++_count;
+        return c;
+    }
+
+    std::streamsize xsputn(const char *, std::streamsize n) override {
+        _count += static_cast<unsigned long>(n);
+        return n;
+    }
+
+public:
+
+    discard_buffer() : _count(0) {}
+
+    unsigned long count() const {
+        return _count;
+    }
+};
+
+/**
+	@brief Stampa elemento per elemento con l'operatore di stream <<
+
+    @description
+	Stampa originale dell'operatore di stream << delle code, come termine
+    di confronto.
+*/
+template <typename Q>
+void print_by_element(std::ostream &os, const Q &q) {
+    os << "[";
+    for(typename Q::const_iterator i = q.begin(), ie = q.end(); i != ie; ++i) {
+        if(i != q.begin())
+            os << ", ";
+        os << *i;
+    }
+    os << "]";
+}
+
+/**
+	@brief Costo della stampa di una coda di n valori
+
+    @description
+	Confronta la stampa elemento per elemento con l'operatore di stream <<
+    (che usa il buffer e std::to_chars) e con la stampa limitata ai primi
+    e agli ultimi 10 elementi, su uno stream che scarta i caratteri
+    e su un std::ostringstream. Il risultato è espresso in milioni
+    di elementi al secondo e in MB/s di testo prodotto.
+
+    @tparam Q tipo della coda
+    @tparam V tipo del valore degli elementi della coda
+*/
+template <typename Q, typename V>
+void bench_dump(const char *name, unsigned int n) {
+    Q q;
+    for(unsigned int i = 0; i < n; ++i)
+        q.enqueue(static_cast<V>(static_cast<int>(i * 2654435761u)) / 7);
+
+    discard_buffer discard_old, discard_new;
+    std::ostream null_old(&discard_old), null_new(&discard_new);
+
+    stopwatch sw_old;
+    print_by_element(null_old, q);
+    double old_secs = sw_old.seconds();
+    stopwatch sw_new;
+    null_new << q;
+    double new_secs = sw_new.seconds();
+    if(discard_old.count() != discard_new.count())
+        std::cout << "  stampe diverse!" << std::endl;
+    double mb = discard_new.count() / 1e6;
+
+    std::cout << name << " (" << mb << " MB):" << std::endl;
+    std::cout << "  elemento per elemento: " << n / old_secs / 1e6 <<
+                 " M elementi/s, " << mb / old_secs << " MB/s" << std::endl;
+    std::cout << "  operator<< con buffer: " << n / new_secs / 1e6 <<
+                 " M elementi/s, " << mb / new_secs << " MB/s" << std::endl;
+
+    std::ostringstream string_old, string_new;
+    stopwatch sw_string_old;
+    print_by_element(string_old, q);
+    double string_old_secs = sw_string_old.seconds();
+    stopwatch sw_string_new;
+    string_new << q;
+    double string_new_secs = sw_string_new.seconds();
+    std::cout << "  ostringstream: " << n / string_old_secs / 1e6 <<
+                 " -> " << n / string_new_secs / 1e6 << " M elementi/s" <<
+                 std::endl;
+
+    stopwatch sw_limited;
+    for(int r = 0; r < 100; ++r)
+        null_new << text::print(q, 10, 10);
+    std::cout << "  primi e ultimi 10 elementi: " <<
+                 sw_limited.seconds() / 100 * 1e3 << " ms" << std::endl;
+}
+
+/**
+	@brief Benchmark della stampa delle code
+
+    @description
+	Stampa code di 10M interi e di 10M double con entrambe le stampe.
+*/
+void bench_format() {
+    std::cout << "******** stampa tramite buffer ********" << std::endl;
+
+    const unsigned int n = 10000000;
+    bench_dump<queue<int, equal_int>, int>("queue<int>", n);
+    bench_dump<ring_queue<int, equal_int>, int>("ring_queue<int>", n);
+    bench_dump<ring_queue<double, std::equal_to<double> >, double>(
+        "ring_queue<double>", n);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Lettura elemento per elemento con l'operatore di stream >>
+
+    @description
+	Lettore scritto a mano del formato [a, b, c] che legge ogni valore
+    con l'operatore di stream >> e lo inserisce singolarmente,
+    come termine di confronto.
+*/
+template <typename Q, typename V>
+bool load_by_element(std::istream &is, Q &q) {
+    char c;
+    if(!(is >> c) || c != '[')
+        return false;
+    if(is.peek() == ']')
+        return static_cast<bool>(is.get(c));
+    V value;
+    while(is >> value) {
+        q.enqueue(value);
+        if(!is.get(c) || c == ']')
+            break;
+        is.get(c);
+    }
+    return c == ']';
+}
+
+/**
+	@brief Costo della lettura di una coda di n valori da un file
+
+    @description
+	Scrive su un file temporaneo la stampa di una coda di n valori e la
+    rilegge con il lettore elemento per elemento, con l'operatore di
+    stream >> (std::from_chars e inserimento a blocchi) e con
+    parse_queue sul contenuto del file letto in memoria (lettura del
+    file compresa). Il risultato è espresso in MB/s e in milioni di
+    elementi al secondo.
+
+    @tparam Q tipo della coda
+    @tparam V tipo del valore degli elementi della coda
+*/
+template <typename Q, typename V>
+void bench_load(const char *name, unsigned int n) {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "queue_parse_fixture.txt";
+    {
+        Q q;
+        for(unsigned int i = 0; i < n; ++i)
+            q.enqueue(static_cast<V>(static_cast<int>(i * 2654435761u)) / 7);
+        std::ofstream out(path, std::ios_base::binary);
+        out << q;
+    }
+    double mb = std::filesystem::file_size(path) / 1e6;
+    std::cout << name << " (" << mb << " MB):" << std::endl;
+
+    auto show = [n, mb](const char *what, double secs, unsigned long size) {
+        std::cout << "  " << what << ": " << mb / secs << " MB/s, " <<
+                     n / secs / 1e6 << " M elementi/s" <<
+                     (size == n ? "" : " (letti male!)") << std::endl;
+    };
+
+    {
+        Q q;
+        std::ifstream in(path, std::ios_base::binary);
+        stopwatch sw;
+        bool ok = load_by_element<Q, V>(in, q);
+        show("elemento per elemento", sw.seconds(), ok ? q.size() : 0);
+    }
+    {
+        Q q;
+        std::ifstream in(path, std::ios_base::binary);
+        stopwatch sw;
+        in >> q;
+        show("operator>>", sw.seconds(), in ? q.size() : 0);
+    }
+    {
+        stopwatch sw;
+        std::ifstream in(path, std::ios_base::binary);
+        std::string text(std::filesystem::file_size(path), '\0');
+        in.read(text.data(), static_cast<std::streamsize>(text.size()));
+        queue<V, std::equal_to<V> > q = parse_queue<V>(text);
+        show("parse_queue (file in memoria)", sw.seconds(), q.size());
+    }
+
+    std::filesystem::remove(path);
+}
+
+/**
+	@brief Benchmark della lettura delle code
+
+    @description
+	Legge un file di circa 100 MB con 10M interi e uno con 4M double.
+*/
+void bench_parse() {
+    std::cout << "******** lettura testuale ********" << std::endl;
+
+    bench_load<queue<int, equal_int>, int>("queue<int>", 10000000);
+    bench_load<ring_queue<int, equal_int>, int>("ring_queue<int>", 10000000);
+    bench_load<ring_queue<double, std::equal_to<double> >, double>(
+        "ring_queue<double>", 4000000);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Costo del salvataggio e del ripristino di una coda di n valori
+
+    @description
+	Salva su un file temporaneo una coda di n valori e la ripristina,
+    con la stampa testuale (operatori di stream << e >>) e con
+    serialize/deserialize; come riferimento della velocità del disco
+    (o della cache dei file) misura la semplice lettura del file
+    binario a blocchi. Il risultato è espresso in MB/s del file binario
+    e in milioni di elementi al secondo.
+
+    @tparam Q tipo della coda
+    @tparam V tipo del valore degli elementi della coda
+*/
+template <typename Q, typename V>
+void bench_checkpoint(const char *name, unsigned int n, bool text) {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "queue_binary_fixture.bin";
+    Q q;
+    for(unsigned int i = 0; i < n; ++i) {
+        if constexpr(std::is_same<V, std::string>::value)
+            q.enqueue(std::to_string(i * 2654435761u));
+        else
+            q.enqueue(static_cast<V>(static_cast<int>(i * 2654435761u)) / 7);
+    }
+
+    stopwatch sw_save;
+    {
+        std::ofstream out(path, std::ios_base::binary);
+        serialize(out, q);
+    }
+    double save_secs = sw_save.seconds();
+    double mb = std::filesystem::file_size(path) / 1e6;
+    std::cout << name << " (" << mb << " MB):" << std::endl;
+
+    auto show = [n, mb](const char *what, double secs) {
+        std::cout << "  " << what << ": " << mb / secs << " MB/s, " <<
+                     n / secs / 1e6 << " M elementi/s" << std::endl;
+    };
+    show("serialize", save_secs);
+
+    {
+        std::ifstream in(path, std::ios_base::binary);
+        std::vector<char> block(binary::BLOCK);
+        stopwatch sw;
+        unsigned long total = 0;
+        std::streamsize got;
+        while((got = in.rdbuf()->sgetn(block.data(),
+                   static_cast<std::streamsize>(block.size()))) > 0)
+            total += static_cast<unsigned long>(got);
+        show("lettura del file", sw.seconds());
+        if(total != std::filesystem::file_size(path))
+            std::cout << "  lettura incompleta!" << std::endl;
+    }
+    {
+        std::ifstream in(path, std::ios_base::binary);
+        Q r;
+        stopwatch sw;
+        deserialize(in, r);
+        double secs = sw.seconds();
+        show("deserialize", secs);
+        if(r.size() != q.size() || r.get_tail() != q.get_tail())
+            std::cout << "  ripristino errato!" << std::endl;
+    }
+    if(text) {
+        stopwatch sw_print;
+        {
+            std::ofstream out(path, std::ios_base::binary);
+            out << q;
+        }
+        show("operator<<", sw_print.seconds());
+        std::ifstream in(path, std::ios_base::binary);
+        Q r;
+        stopwatch sw;
+        in >> r;
+        show("operator>>", sw.seconds());
+    }
+
+    std::filesystem::remove(path);
+}
+
+/**
+	@brief Benchmark della serializzazione binaria
+
+    @description
+	Salva e ripristina 100M interi (400 MB) in una coda circolare
+    e in una a blocchi, 20M interi in una coda e 2M stringhe, confrontando
+    il formato binario con quello testuale.
+*/
+void bench_binary() {
+    std::cout << "******** serializzazione binaria ********" << std::endl;
+
+    bench_checkpoint<ring_queue<int, equal_int>, int>("ring_queue<int>",
+                                                      100000000, true);
+    bench_checkpoint<chunked_queue<int, equal_int>, int>(
+        "chunked_queue<int>", 100000000, false);
+    bench_checkpoint<queue<int, equal_int>, int>("queue<int>", 20000000, true);
+    bench_checkpoint<ring_queue<std::string, equal_string>, std::string>(
+        "ring_queue<std::string>", 2000000, true);
+
+    std::cout << std::endl;
+}
+
+/**
+	@brief Benchmark disponibili
+*/
+struct benchmark_entry {
+    const char *name; ///< @brief Nome del benchmark
+    void (*run)(); ///< @brief Funzione del benchmark
+};
+
+int main(int argc, char *argv[]) {
+
+    const benchmark_entry benchmarks[] = {
+        {"chunked", bench_chunked},
+        {"ring", bench_ring},
+        {"pool", bench_pool},
+        {"pmr", bench_pmr},
+        {"move", bench_move},
+        {"poll", bench_poll},
+        {"clear", bench_clear},
+        {"splice", bench_splice},
+        {"spsc", bench_spsc},
+        {"mpmc", bench_mpmc},
+        {"blocking", bench_blocking},
+        {"executor", bench_executor},
+        {"sharded", bench_sharded},
+        {"combining", bench_combining},
+        {"async", bench_async},
+        {"multicast", bench_multicast},
+        {"multilevel", bench_multilevel},
+        {"delay", bench_delay},
+        {"hashed", bench_hashed},
+        {"simd", bench_simd},
+        {"parallel", bench_parallel},
+        {"algorithms", bench_algorithms},
+        {"format", bench_format},
+        {"parse", bench_parse},
+        {"binary", bench_binary}
+    };
+    const unsigned int count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    for(unsigned int i = 0; i < count; ++i) {
+        bool selected = (argc < 2);
+        for(int a = 1; a < argc; ++a)
+            if(std::strcmp(argv[a], benchmarks[i].name) == 0)
+                selected = true;
+        if(selected)
+            benchmarks[i].run();
+    }
+
+    return 0;
+}
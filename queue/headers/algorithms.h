@@ -0,0 +1,514 @@
+/**
+	@headerfile algorithms.h
+
+    @brief Algoritmi di filtro, trasformazione e riduzione sulle code
+
+    @description
+	File header con gli algoritmi che visitano una coda in un'unica passata,
+    senza copiarla: count_if, find_if, reduce, transform_into e remove_if,
+    per le classi queue, chunked_queue e ring_queue.
+    Ogni algoritmo ha una versione che accetta come secondo parametro
+    una politica di esecuzione (vedi execution.h): con execution::par
+    e execution::par_unseq la coda viene divisa in intervalli consecutivi,
+    ciascuno visitato da un thread, e i risultati parziali vengono combinati
+    in ordine FIFO.
+*/
+
+// Guardie del file header algorithms.h
+
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic
+#include <cstddef> // std::size_t
+#include <functional> // std::plus
+#include <iterator> // std::advance, std::make_move_iterator
+#include <optional> // std::optional
+#include <type_traits> // std::enable_if, std::remove_const, std::decay
+#include <utility> // std::move
+#include <vector> // std::vector
+#include "execution.h" // execution::seq, execution::par,
+                       // execution::detail::for_each_piece
+
+namespace execution {
+
+namespace detail {
+
+/**
+	@brief Coda supportata dagli algoritmi
+
+	@description
+    Trait vero per queue, chunked_queue e ring_queue, anche costanti.
+    Limita gli algoritmi di questo file alle code, così che non vengano
+    scelti al posto di quelli di <algorithm> che ricevono iteratori.
+*/
+template <typename C>
+struct is_queue_container : std::false_type {};
+
+template <typename C>
+struct is_queue_container<const C> : is_queue_container<C> {};
+
+template <typename T, typename E, typename A>
+struct is_queue_container<queue<T, E, A> > : std::true_type {};
+
+template <typename T, typename E, unsigned int N>
+struct is_queue_container<chunked_queue<T, E, N> > : std::true_type {};
+
+template <typename T, typename E>
+struct is_queue_container<ring_queue<T, E> > : std::true_type {};
+
+/**
+	@brief Visita sequenziale di tutti gli elementi di una coda
+
+	@description
+    Chiama f su ogni elemento, in ordine FIFO: per le code con memoria
+    contigua il ciclo scorre direttamente i tratti di for_each_span,
+    senza passare dagli iteratori.
+*/
+template <typename C, typename F>
+void for_each_value(C &q, F &f) {
+    if constexpr(is_contiguous<typename std::remove_const<C>::type>::value)
+        q.for_each_span([&f](auto p, std::size_t n) {
+            for(std::size_t i = 0; i < n; ++i)
+                f(p[i]);
+        });
+    else
+        for(auto i = q.begin(), ie = q.end(); i != ie; ++i)
+            f(*i);
+}
+
+/**
+	@brief Numero di thread di una politica di esecuzione
+
+	@return numero di thread da utilizzare per n elementi (1 per le politiche
+	        sequenziali)
+*/
+template <typename Policy>
+unsigned int policy_workers(Policy policy, std::size_t n) {
+    if constexpr(is_parallel_policy<Policy>::value)
+        return worker_count(policy.threads, n);
+    else
+        return 1;
+}
+
+} // namespace detail
+
+} // namespace execution
+
+// Conteggio
+
+/**
+	@brief Numero di elementi che soddisfano un predicato
+
+	@param q coda da visitare
+	@param pred predicato
+
+	@return numero di elementi di q per cui pred restituisce true
+*/
+template <typename C, typename P>
+typename std::enable_if<execution::detail::is_queue_container<C>::value,
+                        unsigned int>::type
+count_if(const C &q, P pred) {
+    unsigned int n = 0;
+    auto f = [&pred, &n](const auto &value) {
+        n += pred(value) ? 1 : 0;
+    };
+    execution::detail::for_each_value(q, f);
+    return n;
+}
+
+/**
+	@brief Numero di elementi che soddisfano un predicato, con una politica
+	       di esecuzione
+
+    @description
+	Con le politiche parallele ogni thread conta gli elementi del proprio
+    intervallo, con una propria copia di pred.
+
+	@param q coda da visitare
+	@param policy politica di esecuzione
+	@param pred predicato, chiamato in concorrenza da più thread
+
+	@return numero di elementi di q per cui pred restituisce true
+*/
+template <typename C, typename Policy, typename P>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value,
+                        unsigned int>::type
+count_if(const C &q, Policy policy, P pred) {
+    const unsigned int k = execution::detail::policy_workers(policy, q.size());
+    if(k == 1)
+        return count_if(q, pred);
+
+    std::vector<unsigned int> counts(k, 0);
+    execution::detail::for_each_piece(q, k,
+        [&pred, &counts](unsigned int w, std::size_t, auto first, auto last) {
+            P local_pred(pred);
+            unsigned int n = 0;
+            for(; first != last; ++first)
+                n += local_pred(*first) ? 1 : 0;
+            counts[w] += n;
+        });
+
+    unsigned int n = 0;
+    for(unsigned int c : counts)
+        n += c;
+    return n;
+}
+
+// Ricerca
+
+/**
+	@brief Ricerca del primo elemento che soddisfa un predicato
+
+	@param q coda in cui cercare (eventualmente costante)
+	@param pred predicato
+
+	@return iteratore al primo elemento, in ordine FIFO, per cui pred
+	        restituisce true, oppure q.end() se non esiste
+*/
+template <typename C, typename P>
+auto find_if(C &q, P pred) -> typename std::enable_if<
+    execution::detail::is_queue_container<C>::value, decltype(q.begin())>::type {
+    auto i = q.begin(), ie = q.end();
+    while(i != ie && !pred(*i))
+        ++i;
+    return i;
+}
+
+/**
+	@brief Ricerca del primo elemento che soddisfa un predicato, con una
+	       politica di esecuzione
+
+    @description
+	Con le politiche parallele ogni thread cerca nel proprio intervallo
+    e si ferma appena un thread ha trovato un elemento in una posizione
+    precedente; la posizione minima trovata viene poi convertita
+    in un iteratore avanzando dalla testa della coda.
+
+	@param q coda in cui cercare (eventualmente costante)
+	@param policy politica di esecuzione
+	@param pred predicato, chiamato in concorrenza da più thread
+
+	@return iteratore al primo elemento, in ordine FIFO, per cui pred
+	        restituisce true, oppure q.end() se non esiste
+*/
+template <typename C, typename Policy, typename P>
+auto find_if(C &q, Policy policy, P pred) -> typename std::enable_if<
+    execution::detail::is_queue_container<C>::value &&
+    execution::is_execution_policy<Policy>::value, decltype(q.begin())>::type {
+    const std::size_t n = q.size();
+    const unsigned int k = execution::detail::policy_workers(policy, n);
+    if(k == 1)
+        return find_if(q, pred);
+
+    std::atomic<std::size_t> best(n);
+    execution::detail::for_each_piece(q, k,
+        [&pred, &best](unsigned int, std::size_t offset, auto first,
+                       auto last) {
+            P local_pred(pred);
+            for(; first != last; ++first, ++offset) {
+                if(best.load(std::memory_order_relaxed) < offset)
+                    return;
+                if(local_pred(*first)) {
+                    std::size_t current = best.load();
+                    while(offset < current &&
+                          !best.compare_exchange_weak(current, offset)) {}
+                    return;
+                }
+            }
+        });
+
+    auto i = q.begin();
+    if(best.load() == n)
+        return q.end();
+    std::advance(i, best.load());
+    return i;
+}
+
+// Riduzione
+
+/**
+	@brief Riduzione degli elementi con un operatore binario
+
+    @description
+	Calcola op(...op(op(init, e0), e1)..., en) sugli elementi in ordine FIFO.
+
+	@param q coda da visitare
+	@param init valore iniziale
+	@param op operatore binario, chiamato con l'accumulatore e un elemento
+
+	@return risultato della riduzione (init se la coda è vuota)
+*/
+template <typename C, typename R, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        !execution::is_execution_policy<R>::value, R>::type
+reduce(const C &q, R init, F op) {
+    auto f = [&init, &op](const auto &value) {
+        init = op(std::move(init), value);
+    };
+    execution::detail::for_each_value(q, f);
+    return init;
+}
+
+/**
+	@overload reduce
+
+	@description
+	Somma gli elementi a init con l'operatore +.
+*/
+template <typename C, typename R>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        !execution::is_execution_policy<R>::value, R>::type
+reduce(const C &q, R init) {
+    return reduce(q, std::move(init), std::plus<>());
+}
+
+/**
+	@brief Riduzione degli elementi con un operatore binario, con una
+	       politica di esecuzione
+
+    @description
+	Con le politiche parallele ogni thread riduce il proprio intervallo
+    partendo dal suo primo elemento (convertito in R), e i risultati
+    parziali vengono combinati con init in ordine FIFO: op dev'essere
+    associativo e accettare come secondo argomento sia un elemento sia
+    un valore di tipo R, ma non serve che sia commutativo.
+
+	@param q coda da visitare
+	@param policy politica di esecuzione
+	@param init valore iniziale
+	@param op operatore binario associativo, chiamato in concorrenza da più
+	       thread
+
+	@return risultato della riduzione (init se la coda è vuota)
+*/
+template <typename C, typename Policy, typename R, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value, R>::type
+reduce(const C &q, Policy policy, R init, F op) {
+    const unsigned int k = execution::detail::policy_workers(policy, q.size());
+    if(k == 1)
+        return reduce(q, std::move(init), op);
+
+    std::vector<std::optional<R> > partial(k);
+    execution::detail::for_each_piece(q, k,
+        [&op, &partial](unsigned int w, std::size_t, auto first, auto last) {
+            F local_op(op);
+            std::optional<R> &acc = partial[w];
+            for(; first != last; ++first) {
+                if(acc)
+                    *acc = local_op(std::move(*acc), *first);
+                else
+                    acc.emplace(*first);
+            }
+        });
+
+    for(std::optional<R> &p : partial)
+        if(p)
+            init = op(std::move(init), std::move(*p));
+    return init;
+}
+
+/**
+	@overload reduce
+*/
+template <typename C, typename Policy, typename R>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value, R>::type
+reduce(const C &q, Policy policy, R init) {
+    return reduce(q, policy, std::move(init), std::plus<>());
+}
+
+// Trasformazione in una nuova coda
+
+/**
+	@brief Inserimento in un'altra coda dei valori trasformati degli elementi
+	       che soddisfano un predicato
+
+    @description
+	Inserisce in coda a out, in ordine FIFO, op(e) per ogni elemento e di q
+    per cui pred restituisce true, senza copiare q.
+    La coda di destinazione può avere un tipo di elemento diverso
+    ed essere qualsiasi classe con il metodo enqueue.
+
+	@param q coda da visitare
+	@param out coda in cui inserire i valori trasformati
+	@param pred predicato che gli elementi devono soddisfare
+	@param op operatore di trasformazione
+
+	@return numero di valori inseriti in out
+
+    @throw eccezione lanciata da pred, op o dall'inserimento in out
+           (i valori già inseriti restano in out)
+*/
+template <typename C, typename D, typename P, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        !execution::is_execution_policy<D>::value,
+                        unsigned int>::type
+transform_into(const C &q, D &out, P pred, F op) {
+    unsigned int n = 0;
+    auto f = [&out, &pred, &op, &n](const auto &value) {
+        if(pred(value)) {
+            out.enqueue(op(value));
+            ++n;
+        }
+    };
+    execution::detail::for_each_value(q, f);
+    return n;
+}
+
+/**
+	@overload transform_into
+
+	@description
+	Inserisce in out i valori trasformati di tutti gli elementi di q,
+    riservando prima lo spazio, se out ha il metodo reserve.
+*/
+template <typename C, typename D, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        !execution::is_execution_policy<D>::value,
+                        unsigned int>::type
+transform_into(const C &q, D &out, F op) {
+    unsigned int n = q.size();
+    if constexpr(requires { out.reserve(n); })
+        out.reserve(out.size() + n);
+    auto f = [&out, &op](const auto &value) {
+        out.enqueue(op(value));
+    };
+    execution::detail::for_each_value(q, f);
+    return n;
+}
+
+/**
+	@brief Inserimento in un'altra coda dei valori trasformati, con una
+	       politica di esecuzione
+
+    @description
+	Con le politiche parallele ogni thread calcola i valori trasformati
+    del proprio intervallo in un vettore locale; i vettori vengono poi
+    spostati in out, in ordine FIFO, dal thread chiamante, dopo aver
+    riservato lo spazio se out ha il metodo reserve.
+
+	@param q coda da visitare
+	@param policy politica di esecuzione
+	@param out coda in cui inserire i valori trasformati
+	@param pred predicato, chiamato in concorrenza da più thread
+	@param op operatore di trasformazione, chiamato in concorrenza da più
+	       thread
+
+	@return numero di valori inseriti in out
+*/
+template <typename C, typename Policy, typename D, typename P, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value,
+                        unsigned int>::type
+transform_into(const C &q, Policy policy, D &out, P pred, F op) {
+    const unsigned int k = execution::detail::policy_workers(policy, q.size());
+    if(k == 1)
+        return transform_into(q, out, pred, op);
+
+    typedef typename std::decay<decltype(op(*q.begin()))>::type result_type;
+    std::vector<std::vector<result_type> > results(k);
+    execution::detail::for_each_piece(q, k,
+        [&pred, &op, &results](unsigned int w, std::size_t, auto first,
+                               auto last) {
+            P local_pred(pred);
+            F local_op(op);
+            std::vector<result_type> &r = results[w];
+            for(; first != last; ++first)
+                if(local_pred(*first))
+                    r.push_back(local_op(*first));
+        });
+
+    unsigned int n = 0;
+    for(const std::vector<result_type> &r : results)
+        n += static_cast<unsigned int>(r.size());
+    if constexpr(requires { out.reserve(n); })
+        out.reserve(out.size() + n);
+    for(std::vector<result_type> &r : results)
+        out.enqueue(std::make_move_iterator(r.begin()),
+                    std::make_move_iterator(r.end()));
+    return n;
+}
+
+/**
+	@overload transform_into
+*/
+template <typename C, typename Policy, typename D, typename F>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value,
+                        unsigned int>::type
+transform_into(const C &q, Policy policy, D &out, F op) {
+    if(execution::detail::policy_workers(policy, q.size()) == 1)
+        return transform_into(q, out, op);
+    return transform_into(q, policy, out,
+                          [](const auto &) { return true; }, op);
+}
+
+// Rimozione
+
+/**
+	@brief Rimozione degli elementi che soddisfano un predicato
+
+    @description
+	Chiama il metodo remove_if della coda, che compatta gli elementi
+    mantenuti in un'unica passata, senza riallocare.
+
+	@param q coda da cui rimuovere gli elementi
+	@param pred predicato che gli elementi devono soddisfare per essere
+	       rimossi
+
+	@return numero di elementi rimossi
+*/
+template <typename C, typename P>
+typename std::enable_if<execution::detail::is_queue_container<C>::value,
+                        unsigned int>::type
+remove_if(C &q, P pred) {
+    return q.remove_if(pred);
+}
+
+/**
+	@brief Rimozione degli elementi che soddisfano un predicato, con una
+	       politica di esecuzione
+
+    @description
+	Con le politiche parallele il predicato viene valutato in parallelo,
+    registrando l'esito per ogni posizione; la compattazione, che sposta
+    gli elementi, resta un'unica passata sequenziale del metodo remove_if.
+
+	@param q coda da cui rimuovere gli elementi
+	@param policy politica di esecuzione
+	@param pred predicato, chiamato in concorrenza da più thread
+
+	@return numero di elementi rimossi
+*/
+template <typename C, typename Policy, typename P>
+typename std::enable_if<execution::detail::is_queue_container<C>::value &&
+                        execution::is_execution_policy<Policy>::value,
+                        unsigned int>::type
+remove_if(C &q, Policy policy, P pred) {
+    const unsigned int k = execution::detail::policy_workers(policy, q.size());
+    if(k == 1)
+        return q.remove_if(pred);
+
+    std::vector<unsigned char> marked(q.size());
+    execution::detail::for_each_piece(q, k,
+        [&pred, &marked](unsigned int, std::size_t offset, auto first,
+                         auto last) {
+            P local_pred(pred);
+            for(; first != last; ++first, ++offset)
+                marked[offset] = local_pred(*first) ? 1 : 0;
+        });
+
+    std::size_t position = 0;
+    return q.remove_if([&marked, &position](const auto &) {
+        return marked[position++] != 0;
+    });
+}
+
+#endif
+
+// Fine file header algorithms.h
@@ -0,0 +1,305 @@
+/**
+	@headerfile async_queue.h
+
+    @brief Dichiarazione e definizione della classe async_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    async_queue, una coda FIFO la cui rimozione è un'operazione
+    asincrona che sospende la coroutine chiamante (co_await) finché la coda
+    è vuota, senza bloccare alcun thread.
+*/
+
+// Guardie del file header async_queue.h
+
+#ifndef ASYNC_QUEUE_H
+#define ASYNC_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <coroutine> // std::coroutine_handle
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <optional> // std::optional
+#include <utility> // std::move, std::forward, std::declval
+#include "queue.h" // queue
+
+// Dichiarazione e definizione della classe template async_queue
+
+/**
+	@brief Coda FIFO con rimozione asincrona per coroutine
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T
+    come involucro di una queue, in cui `co_await q.dequeue()` restituisce
+    l'elemento più vecchio, sospendendo la coroutine finché la coda
+    è vuota.
+    Le coroutine sospese vengono accodate, in ordine FIFO, in una lista
+    concatenata i cui nodi sono gli oggetti awaiter, che risiedono
+    nel frame della coroutine stessa: una coroutine in attesa non occupa
+    alcun thread, non esegue polling e non richiede allocazioni.
+    Un inserimento con almeno una coroutine in attesa consegna il valore
+    direttamente alla più vecchia, senza passare dalla queue, e ne affida
+    la ripresa allo scheduler S fornito dall'utente (ad esempio un event
+    loop o un pool di thread): viene ripresa esattamente una coroutine
+    per ogni elemento inserito e nessuna coroutine viene ripresa
+    all'interno di enqueue.
+    Le operazioni sono protette da un mutex e possono essere chiamate
+    da qualsiasi thread.
+
+    @note La coda non è copiabile né assegnabile: le coroutine in attesa
+          ne conservano l'indirizzo.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam S tipo dello scheduler, un oggetto chiamabile con un argomento
+              di tipo std::coroutine_handle<> che ne pianifica la ripresa
+              senza lanciare eccezioni (la chiamata deve essere noexcept:
+              una coroutine a cui è già stato consegnato un valore
+              non può tornare in attesa)
+*/
+template <typename T, typename E, typename S>
+class async_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+public:
+
+    /**
+        @brief Operazione di rimozione asincrona
+
+        @description
+        Oggetto awaiter restituito da dequeue. Se la coda non è vuota,
+        la coroutine non viene sospesa; altrimenti l'awaiter si accoda
+        tra le coroutine in attesa e riceve il valore dal primo inserimento.
+    */
+    class dequeue_awaiter {
+
+        friend class async_queue; // classe amica che accoda l'awaiter
+
+        async_queue &_queue; ///< @brief Coda da cui rimuovere
+        std::coroutine_handle<> _handle; ///< @brief Coroutine sospesa
+        std::optional<value_type> _value; ///< @brief Valore rimosso
+        dequeue_awaiter *_next; ///< @brief Awaiter successivo nella lista
+                                ///< delle coroutine in attesa
+
+    public:
+
+        explicit dequeue_awaiter(async_queue &q) :
+            _queue(q), _next(nullptr) {} // initialization list
+
+        /**
+            @brief La coroutine viene sempre sospesa in await_suspend,
+                   che decide se riprenderla subito
+        */
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        /**
+            @brief Rimozione immediata o accodamento della coroutine
+
+            @return false se un elemento è stato rimosso (la coroutine
+                    prosegue senza sospendersi), true se la coroutine
+                    resta sospesa in attesa di un inserimento
+        */
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(_queue._mutex);
+            if(_queue._items.size() > 0) {
+                _value.emplace(_queue._items.dequeue());
+                return false;
+            }
+            _handle = handle;
+            _queue.link_waiter(this);
+            return true;
+        }
+
+        /**
+            @brief Valore rimosso, restituito dall'espressione co_await
+        */
+        value_type await_resume() {
+            return std::move(*_value);
+        }
+    };
+
+private:
+
+	// Dati membro privati della coda
+
+    std::mutex _mutex; ///< @brief Mutex che protegge la coda e la lista
+    queue<value_type, E> _items; ///< @brief Elementi non ancora consegnati
+    dequeue_awaiter *_first_waiter; ///< @brief Coroutine in attesa da più
+                                    ///< tempo
+    dequeue_awaiter *_last_waiter; ///< @brief Coroutine in attesa da meno
+                                   ///< tempo
+    size_type _waiting; ///< @brief Numero di coroutine in attesa
+    S _schedule; ///< @brief Scheduler delle coroutine riprese
+
+    static_assert(noexcept(std::declval<S &>()(std::coroutine_handle<>{})),
+                  "lo scheduler di async_queue deve essere noexcept");
+
+    // Funzioni private della coda
+
+    /**
+		@brief Accodamento di una coroutine in attesa
+
+        @param w awaiter della coroutine
+
+        @pre Il mutex è acquisito dal chiamante.
+	*/
+    void link_waiter(dequeue_awaiter *w) {
+        if(_last_waiter == nullptr)
+            _first_waiter = w;
+        else
+            _last_waiter->_next = w;
+        _last_waiter = w;
+        ++_waiting;
+    }
+
+    /**
+		@brief Consegna di un valore alla coroutine in attesa da più tempo,
+		       se presente, altrimenti inserimento nella queue
+
+		@description
+        Funzione privata che, se c'è almeno una coroutine in attesa,
+        le consegna il valore e ne pianifica la ripresa, dopo aver
+        rilasciato il mutex.
+
+        @param value valore da consegnare o inserire
+
+        @throw eccezione di allocazione di memoria (la coda rimane
+               allo stato precedente alla chiamata)
+	*/
+    template <typename V>
+    void deliver(V &&value) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(_first_waiter == nullptr) {
+            _items.enqueue(std::forward<V>(value));
+            return;
+        }
+        dequeue_awaiter *w = _first_waiter;
+        w->_value.emplace(std::forward<V>(value));
+        _first_waiter = w->_next;
+        if(_first_waiter == nullptr)
+            _last_waiter = nullptr;
+        --_waiting;
+        lock.unlock();
+        _schedule(w->_handle);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota.
+
+		@param schedule scheduler a cui affidare la ripresa delle coroutine
+	*/
+	explicit async_queue(const S &schedule) :
+	    _first_waiter(nullptr), _last_waiter(nullptr), _waiting(0),
+	    _schedule(schedule) { // initialization list
+	}
+
+	async_queue(const async_queue &other) = delete;
+
+	async_queue &operator=(const async_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+	    @pre Nessuna coroutine è in attesa sulla coda.
+	*/
+	virtual ~async_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti e non ancora consegnati
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size();
+    }
+
+    /**
+        @brief Numero di coroutine in attesa
+
+        @return numero di coroutine sospese in attesa di un elemento
+    */
+    size_type waiting() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _waiting;
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che consegna il valore, copiandolo,
+	    alla coroutine in attesa da più tempo, affidandone la ripresa
+	    allo scheduler, oppure, se nessuna coroutine è in attesa,
+	    lo inserisce nella coda.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(const value_type &value) {
+	    deliver(value);
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Consegna o inserisce il valore spostandolo.
+	*/
+	void enqueue(value_type &&value) {
+	    deliver(std::move(value));
+	}
+
+    /**
+        @brief Rimozione asincrona dell'elemento più vecchio
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce un'operazione
+        da attendere con co_await, il cui risultato è il valore
+        dell'elemento rimosso.
+
+        @return awaiter della rimozione
+    */
+    dequeue_awaiter dequeue() {
+        return dequeue_awaiter(*this);
+    }
+
+    /**
+        @brief Tentativo di rimozione sincrona dell'elemento più vecchio
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.try_dequeue(out);
+    }
+};
+
+#endif
+
+// Fine file header async_queue.h
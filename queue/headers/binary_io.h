@@ -0,0 +1,456 @@
+/**
+	@headerfile binary_io.h
+
+    @brief Serializzazione binaria delle code
+
+    @description
+	File header con la serializzazione binaria versionata delle code:
+    un'intestazione con il numero di elementi seguita dai valori.
+    I valori dei tipi banalmente copiabili vengono scritti e letti
+    a blocchi con un'unica copia di memoria (e, sulle code a memoria
+    contigua, direttamente dal buffer della coda), gli altri tramite
+    un codificatore specializzabile per tipo.
+    Utilizzato dalle funzioni serialize e deserialize delle code.
+*/
+
+// Guardie del file header binary_io.h
+
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+// Direttive per il pre-compilatore
+
+#include <array> // std::array
+#include <bit> // std::bit_cast
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+#include <ios> // std::streamsize
+#include <istream> // std::istream
+#include <iterator> // std::make_move_iterator
+#include <ostream> // std::ostream
+#include <string> // std::string
+#include <type_traits> // std::is_trivially_copyable, std::is_same,
+                       // std::is_default_constructible,
+                       // std::remove_cv, std::remove_reference
+#include <utility> // std::move
+#include <vector> // std::vector
+#include "queue_exceptions.h" // serialize_queue_exception
+
+namespace binary {
+
+/**
+	@brief Versione corrente del formato binario
+*/
+inline constexpr std::uint32_t FORMAT_VERSION = 1;
+
+/**
+	@brief Dimensione dei blocchi di scrittura e di lettura (64 KiB)
+*/
+inline constexpr std::size_t BLOCK = 64 * 1024;
+
+/**
+	@brief Scrittore binario con buffer
+
+	@description
+    Accumula i byte in un buffer di BLOCK byte e li scrive sullo stream
+    con un'unica chiamata per blocco; i tratti più grandi del buffer
+    vengono scritti direttamente. Il buffer viene svuotato
+    dal distruttore o dal metodo flush.
+*/
+class writer {
+
+    std::ostream &_os; ///< @brief Stream di output
+    std::vector<char> _buffer; ///< @brief Buffer dei byte da scrivere
+    std::size_t _used; ///< @brief Byte occupati nel buffer
+
+    void write_through(const char *data, std::size_t n) {
+        if(static_cast<std::size_t>(_os.rdbuf()->sputn(data,
+               static_cast<std::streamsize>(n))) != n) {
+            _os.setstate(std::ios_base::badbit);
+            throw serialize_queue_exception("scrittura sullo stream fallita");
+        }
+    }
+
+public:
+
+    /**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia uno scrittore sullo stream os.
+
+	    @param os stream di output
+	*/
+    explicit writer(std::ostream &os) :
+        _os(os), _buffer(BLOCK), _used(0) {} // initialization list
+
+    writer(const writer &other) = delete;
+    writer &operator=(const writer &other) = delete;
+
+    /**
+		@brief Distruttore
+
+	    @description
+		Scrive sullo stream i byte rimasti nel buffer; eventuali errori
+	    vengono ignorati (chiamare flush per rilevarli).
+	*/
+    ~writer() {
+        try {
+            flush();
+        }
+        catch(...) {}
+    }
+
+    /**
+		@brief Scrittura di n byte
+
+	    @param data byte da scrivere
+	    @param n numero di byte
+
+	    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+	*/
+    void put(const void *data, std::size_t n) {
+        const char *p = static_cast<const char *>(data);
+        if(n > _buffer.size() - _used) {
+            flush();
+            if(n >= _buffer.size()) {
+                write_through(p, n);
+                return;
+            }
+        }
+        std::memcpy(_buffer.data() + _used, p, n);
+        _used += n;
+    }
+
+    /**
+		@brief Scrittura dei byte di un valore banalmente copiabile
+
+	    @param value valore da scrivere
+	*/
+    template <typename T>
+    void put_value(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "put_value richiede un tipo banalmente copiabile");
+        put(&value, sizeof(T));
+    }
+
+    /**
+		@brief Scrittura sullo stream dei byte nel buffer
+
+	    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+	*/
+    void flush() {
+        if(_used != 0) {
+            std::size_t n = _used;
+            _used = 0;
+            write_through(_buffer.data(), n);
+        }
+    }
+};
+
+/**
+	@brief Lettore binario
+
+	@description
+    Legge dallo stream esattamente i byte richiesti (tramite il buffer
+    dello stream), così che i dati che seguono la coda restino
+    disponibili per letture successive.
+*/
+class reader {
+
+    std::istream &_is; ///< @brief Stream di input
+
+public:
+
+    /**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia un lettore dallo stream is.
+
+	    @param is stream di input
+	*/
+    explicit reader(std::istream &is) : _is(is) {} // initialization list
+
+    /**
+		@brief Lettura di n byte
+
+	    @param data destinazione dei byte letti
+	    @param n numero di byte
+
+	    @return true se sono stati letti tutti gli n byte
+	    @return false altrimenti (dati troncati)
+	*/
+    bool get(void *data, std::size_t n) {
+        if(static_cast<std::size_t>(_is.rdbuf()->sgetn(
+               static_cast<char *>(data), static_cast<std::streamsize>(n))) == n)
+            return true;
+        _is.setstate(std::ios_base::failbit | std::ios_base::eofbit);
+        return false;
+    }
+
+    /**
+		@brief Lettura dei byte di un valore banalmente copiabile
+
+	    @param value valore da leggere
+
+	    @return true se il valore è stato letto
+	    @return false altrimenti (dati troncati)
+	*/
+    template <typename T>
+    bool get_value(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "get_value richiede un tipo banalmente copiabile");
+        return get(&value, sizeof(T));
+    }
+};
+
+/**
+	@brief Codificatore binario dei valori degli elementi
+
+	@description
+    Scrive e legge il valore di un elemento:
+    - i tipi banalmente copiabili come i loro byte (in questo caso
+      serialize e deserialize usano direttamente la copia a blocchi);
+    - std::string come lunghezza a 64 bit seguita dai caratteri.
+    Per gli altri tipi va specializzato definendo le funzioni statiche
+    write(w, value) e read(r, out), dove read aggiunge il valore letto
+    in fondo al blocco out e restituisce false se i dati sono troncati.
+
+    @tparam T tipo del valore
+*/
+template <typename T>
+struct codec {
+    static void write(writer &w, const T &value) {
+        if constexpr(std::is_trivially_copyable<T>::value)
+            w.put_value(value);
+        else if constexpr(std::is_same<T, std::string>::value) {
+            w.put_value(static_cast<std::uint64_t>(value.size()));
+            w.put(value.data(), value.size());
+        }
+        else
+            static_assert(sizeof(T) == 0,
+                          "specializzare binary::codec per il tipo T");
+    }
+
+    static bool read(reader &r, std::vector<T> &out) {
+        if constexpr(std::is_trivially_copyable<T>::value) {
+            // std::bit_cast non richiede il costruttore di default di T
+            std::array<unsigned char, sizeof(T)> bytes;
+            if(!r.get(bytes.data(), sizeof(T)))
+                return false;
+            out.push_back(std::bit_cast<T>(bytes));
+            return true;
+        }
+        else if constexpr(std::is_same<T, std::string>::value) {
+            std::uint64_t n;
+            if(!r.get_value(n))
+                return false;
+            std::string s;
+            // lettura a blocchi: una lunghezza corrotta non deve
+            // causare un'allocazione enorme prima di scoprirlo
+            while(n != 0) {
+                std::size_t k = n < BLOCK ? static_cast<std::size_t>(n) : BLOCK;
+                std::size_t old = s.size();
+                s.resize(old + k);
+                if(!r.get(s.data() + old, k))
+                    return false;
+                n -= k;
+            }
+            out.push_back(std::move(s));
+            return true;
+        }
+        else
+            static_assert(sizeof(T) == 0,
+                          "specializzare binary::codec per il tipo T");
+    }
+};
+
+/**
+	@brief Intestazione del formato binario
+
+	@description
+    Precede gli elementi della coda; i campi sono scritti nell'ordine dei
+    byte della macchina, che viene verificato in lettura tramite byte_order.
+    element_size vale sizeof(T) se gli elementi sono scritti come byte
+    (tipi banalmente copiabili), 0 se sono scritti dal codificatore.
+*/
+struct header {
+    char magic[4]; ///< @brief Identificativo del formato "QUEB"
+    std::uint32_t version; ///< @brief Versione del formato
+    std::uint32_t byte_order; ///< @brief 0x01020304 nell'ordine della macchina
+    std::uint32_t element_size; ///< @brief Dimensione di un elemento o 0
+    std::uint64_t count; ///< @brief Numero di elementi
+};
+
+/**
+	@brief Valore dell'identificativo del formato
+*/
+inline constexpr char MAGIC[4] = {'Q', 'U', 'E', 'B'};
+
+/**
+	@brief Scrittura binaria di una coda
+
+	@description
+    Scrive l'intestazione e gli elementi della coda q in ordine FIFO.
+    Se il tipo degli elementi è banalmente copiabile i loro byte vengono
+    copiati a blocchi: sulle code con il metodo for_each_span i tratti
+    contigui del buffer vengono passati direttamente allo stream.
+
+    @tparam C tipo della coda
+
+	@param os stream di output
+	@param q coda da scrivere
+
+    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+*/
+template <typename C>
+void write_queue(std::ostream &os, const C &q) {
+    typedef typename std::remove_cv<
+        typename std::remove_reference<decltype(*q.begin())>::type>::type
+        value_type;
+    constexpr bool raw = std::is_trivially_copyable<value_type>::value;
+
+    header h;
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.byte_order = 0x01020304u;
+    h.element_size = raw ? static_cast<std::uint32_t>(sizeof(value_type)) : 0;
+    h.count = q.size();
+
+    writer w(os);
+    w.put_value(h);
+    if constexpr(raw && requires { q.for_each_span(
+                     [](const value_type *, unsigned int) {}); }) {
+        q.for_each_span([&w](const value_type *p, unsigned int n) {
+            w.put(p, static_cast<std::size_t>(n) * sizeof(value_type));
+        });
+    }
+    else {
+        for(auto i = q.begin(), ie = q.end(); i != ie; ++i)
+            codec<value_type>::write(w, *i);
+    }
+    w.flush();
+}
+
+/**
+	@brief Lettura binaria di una coda e inserimento dei suoi elementi
+
+	@description
+    Legge l'intestazione e gli elementi scritti da write_queue
+    e li inserisce in coda a q a blocchi, tramite l'inserimento di un
+    intervallo; se q ha il metodo reserve viene riservato lo spazio
+    per il primo blocco, e la coda cresce poi a ogni blocco, così che
+    un'intestazione con un numero di elementi errato non causi
+    un'allocazione sproporzionata ai dati presenti. Se il tipo degli elementi è banalmente
+    copiabile (e ha il costruttore di default) ogni blocco viene letto
+    dallo stream con un'unica chiamata, e viene inserito come intervallo
+    di puntatori, che le code a memoria contigua copiano con std::memcpy.
+    Dallo stream vengono letti solo i byte della coda.
+
+    @tparam C tipo della coda
+
+	@param is stream di input
+	@param q coda in cui inserire gli elementi
+
+	@return numero di elementi inseriti
+
+    @throw serialize_queue_exception se l'intestazione non è valida,
+           se la coda risultante non avrebbe una dimensione rappresentabile
+           o se i dati sono troncati (gli elementi dei blocchi già inseriti
+           restano in q)
+*/
+template <typename C>
+std::size_t read_queue_into(std::istream &is, C &q) {
+    typedef typename std::remove_cv<
+        typename std::remove_reference<decltype(*q.begin())>::type>::type
+        value_type;
+    constexpr bool raw = std::is_trivially_copyable<value_type>::value;
+    // std::vector<bool> non espone i propri byte
+    constexpr bool bulk = raw &&
+        std::is_default_constructible<value_type>::value &&
+        !std::is_same<value_type, bool>::value;
+
+    reader r(is);
+    header h;
+    if(!r.get_value(h))
+        throw serialize_queue_exception("intestazione troncata");
+    if(std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw serialize_queue_exception("formato non riconosciuto");
+    if(h.version == 0 || h.version > FORMAT_VERSION)
+        throw serialize_queue_exception("versione del formato non supportata");
+    if(h.byte_order != 0x01020304u)
+        throw serialize_queue_exception("ordine dei byte diverso");
+    if(h.element_size != (raw ? sizeof(value_type) : 0))
+        throw serialize_queue_exception("tipo degli elementi diverso");
+
+    if(h.count > 0xffffffffu - q.size())
+        throw serialize_queue_exception("numero di elementi troppo grande");
+
+    const std::size_t per_block =
+        BLOCK / sizeof(value_type) != 0 ? BLOCK / sizeof(value_type) : 1;
+    const std::size_t first_block =
+        h.count < per_block ? static_cast<std::size_t>(h.count) : per_block;
+    // il numero di elementi non è ancora verificato dai dati: si riserva
+    // solo il primo blocco
+    if constexpr(requires { q.reserve(0u); })
+        q.reserve(static_cast<unsigned int>(q.size() + first_block));
+    std::vector<value_type> batch;
+    // i blocchi letti come byte riusano sempre le stesse posizioni,
+    // inizializzate una sola volta
+    if constexpr(bulk)
+        batch.resize(first_block);
+    else
+        batch.reserve(first_block);
+    std::uint64_t left = h.count;
+    while(left != 0) {
+        std::size_t k = left < per_block ? static_cast<std::size_t>(left)
+                                         : per_block;
+        if constexpr(bulk) {
+            if(!r.get(batch.data(), k * sizeof(value_type)))
+                throw serialize_queue_exception("dati troncati");
+            q.enqueue(static_cast<const value_type *>(batch.data()),
+                      static_cast<const value_type *>(batch.data() + k));
+        }
+        else {
+            for(std::size_t i = 0; i < k; ++i)
+                if(!codec<value_type>::read(r, batch))
+                    throw serialize_queue_exception("dati troncati");
+            q.enqueue(std::make_move_iterator(batch.begin()),
+                      std::make_move_iterator(batch.end()));
+            batch.clear();
+        }
+        left -= k;
+    }
+
+    return static_cast<std::size_t>(h.count);
+}
+
+/**
+	@brief Lettura binaria di una coda che ne sostituisce il contenuto
+
+	@description
+    Legge con read_queue_into una nuova coda che sostituisce q;
+    se la lettura fallisce q non viene modificata.
+
+    @tparam C tipo della coda
+
+	@param is stream di input
+	@param q coda da sostituire
+
+    @throw serialize_queue_exception se l'intestazione non è valida
+           o i dati sono troncati
+*/
+template <typename C>
+void read_queue(std::istream &is, C &q) {
+    C tmp;
+    read_queue_into(is, tmp);
+    q = std::move(tmp);
+}
+
+} // namespace binary
+
+#endif
+
+// Fine file header binary_io.h
@@ -0,0 +1,521 @@
+/**
+	@headerfile blocking_queue.h
+
+    @brief Dichiarazione e definizione della classe blocking_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    blocking_queue, una coda FIFO a capacità limitata, condivisa tra thread,
+    in cui l'inserimento attende finché la coda è piena e la rimozione
+    attende finché la coda è vuota, senza consumare CPU.
+*/
+
+// Guardie del file header blocking_queue.h
+
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <mutex> // std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::duration
+#include <utility> // std::move, std::forward
+#include "ring_queue.h" // ring_queue
+
+// Dichiarazione e definizione della classe template blocking_queue
+
+/**
+	@brief Coda FIFO bloccante a capacità limitata
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    a capacità limitata, che può essere utilizzata da un numero qualsiasi
+    di thread produttori e consumatori.
+    Gli elementi sono memorizzati in una ring_queue, il cui buffer viene
+    allocato una sola volta alla costruzione, protetta da un mutex.
+    Un produttore che trova la coda piena attende sulla variabile
+    condizione _not_full, un consumatore che trova la coda vuota attende
+    sulla variabile condizione _not_empty: i thread in attesa sono sospesi
+    dal sistema operativo e non consumano CPU (la pressione dei consumatori
+    lenti si propaga così ai produttori).
+    Le notifiche vengono inviate solo se è presente almeno un thread
+    in attesa e dopo il rilascio del mutex, in modo che il thread risvegliato
+    non si blocchi subito sul mutex; gli inserimenti e le rimozioni
+    a blocchi inviano una sola notifica per blocco.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class blocking_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+	// Dati membro privati della coda
+
+	mutable std::mutex _mutex; ///< @brief Mutex che protegge la coda
+	std::condition_variable _not_empty; ///< @brief Attesa dei consumatori
+	std::condition_variable _not_full; ///< @brief Attesa dei produttori
+	ring_queue<T, E> _queue; ///< @brief Elementi della coda
+	size_type _capacity; ///< @brief Numero massimo di elementi
+	size_type _waiting_consumers; ///< @brief Consumatori in attesa
+	size_type _waiting_producers; ///< @brief Produttori in attesa
+
+    // Funzioni private della coda
+
+    /**
+		@brief Attesa di una condizione, senza limite di tempo
+
+		@description
+        Funzione privata che sospende il thread chiamante sulla variabile
+        condizione finché il predicato non è vero, tenendo aggiornato
+        il contatore dei thread in attesa.
+
+        @param lock lock del mutex, posseduto dal chiamante
+        @param cv variabile condizione su cui attendere
+        @param waiting contatore dei thread in attesa su cv
+        @param ready predicato da attendere
+	*/
+    template <typename P>
+    void wait(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+              size_type &waiting, P ready) {
+        if(!ready()) {
+            ++waiting;
+            cv.wait(lock, ready);
+            --waiting;
+        }
+    }
+
+    /**
+		@brief Attesa di una condizione, con limite di tempo
+
+		@param lock lock del mutex, posseduto dal chiamante
+        @param cv variabile condizione su cui attendere
+        @param waiting contatore dei thread in attesa su cv
+        @param ready predicato da attendere
+        @param timeout tempo massimo di attesa
+
+        @return true se il predicato è vero, false se il tempo è scaduto
+	*/
+    template <typename P, typename Rep, typename Period>
+    bool wait_for(std::unique_lock<std::mutex> &lock,
+                  std::condition_variable &cv, size_type &waiting, P ready,
+                  const std::chrono::duration<Rep, Period> &timeout) {
+        if(ready())
+            return true;
+        ++waiting;
+        bool result = cv.wait_for(lock, timeout, ready);
+        --waiting;
+        return result;
+    }
+
+    /**
+		@brief Inserimento di un elemento con il mutex già acquisito
+
+		@description
+        Funzione privata che inserisce l'elemento e rilascia il mutex,
+        notificando poi un consumatore, se ce n'è almeno uno in attesa.
+
+        @param lock lock del mutex, posseduto dal chiamante
+        @param value valore dell'elemento da inserire
+
+        @pre La coda non dev'essere piena.
+	*/
+    template <typename V>
+    void push_and_notify(std::unique_lock<std::mutex> &lock, V &&value) {
+        _queue.enqueue(std::forward<V>(value));
+        bool notify = _waiting_consumers > 0;
+        lock.unlock();
+        if(notify)
+            _not_empty.notify_one();
+    }
+
+    /**
+		@brief Rimozione di un elemento con il mutex già acquisito
+
+		@description
+        Funzione privata che rimuove l'elemento più vecchio, spostandone
+        il valore nel parametro, e rilascia il mutex, notificando poi
+        un produttore, se ce n'è almeno uno in attesa.
+
+        @param lock lock del mutex, posseduto dal chiamante
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @pre La coda non dev'essere vuota.
+	*/
+    void pop_and_notify(std::unique_lock<std::mutex> &lock, value_type &out) {
+        _queue.try_dequeue(out);
+        bool notify = _waiting_producers > 0;
+        lock.unlock();
+        if(notify)
+            _not_full.notify_one();
+    }
+
+    /**
+		@brief Inserimento bloccante
+	*/
+    template <typename V>
+    void blocking_push(V &&value) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        wait(lock, _not_full, _waiting_producers,
+             [this]() { return _queue.size() < _capacity; });
+        push_and_notify(lock, std::forward<V>(value));
+    }
+
+    /**
+		@brief Inserimento non bloccante
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+    template <typename V>
+    bool try_push(V &&value) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(_queue.size() == _capacity)
+            return false;
+        push_and_notify(lock, std::forward<V>(value));
+        return true;
+    }
+
+    /**
+		@brief Inserimento con limite di tempo
+
+		@return true se l'elemento è stato inserito, false se il tempo
+		        è scaduto con la coda ancora piena
+	*/
+    template <typename V, typename Rep, typename Period>
+    bool timed_push(V &&value,
+                    const std::chrono::duration<Rep, Period> &timeout) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(!wait_for(lock, _not_full, _waiting_producers,
+                     [this]() { return _queue.size() < _capacity; }, timeout))
+            return false;
+        push_and_notify(lock, std::forward<V>(value));
+        return true;
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota di capacità limitata,
+	    riservando subito lo spazio per tutti gli elementi.
+
+		@param capacity numero massimo di elementi contenuti nella coda
+		       (almeno 1)
+
+		@throw eccezione di allocazione di memoria
+	*/
+	explicit blocking_queue(size_type capacity) :
+	    _capacity(capacity > 0 ? capacity : 1), _waiting_consumers(0),
+	    _waiting_producers(0) { // initialization list
+
+	    _queue.reserve(_capacity);
+	}
+
+	blocking_queue(const blocking_queue &other) = delete;
+
+	blocking_queue &operator=(const blocking_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+	    @pre Nessun thread sta utilizzando o attendendo la coda.
+	*/
+	virtual ~blocking_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda al momento
+                della chiamata
+    */
+    size_type size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    /**
+        @brief Capacità della coda
+
+        @return numero massimo di elementi contenuti nella coda
+    */
+    size_type capacity() const {
+        return _capacity;
+    }
+
+	/**
+		@brief Inserimento bloccante di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, copiandone il valore; se la coda è piena, il thread
+	    chiamante viene sospeso finché un consumatore non libera una posizione.
+
+		@param value valore dell'elemento da inserire nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+	*/
+	void enqueue(const value_type &value) {
+		blocking_push(value);
+	}
+
+	/**
+		@brief Inserimento bloccante di un singolo elemento per spostamento
+
+		@overload enqueue
+
+		@param value valore dell'elemento da spostare nella coda
+	*/
+	void enqueue(value_type &&value) {
+		blocking_push(std::move(value));
+	}
+
+	/**
+		@brief Inserimento bloccante di un insieme di elementi presi da una
+		       sequenza identificata da due iteratori
+
+		@overload enqueue
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce nella coda, in ordine,
+	    gli elementi della sequenza: ad ogni acquisizione del mutex
+	    viene inserito il maggior numero possibile di elementi, attendendo
+	    solo quando la coda è piena, e i consumatori in attesa vengono
+	    notificati una sola volta per ogni gruppo di elementi inseriti.
+	    Gli elementi di produttori concorrenti possono essere intercalati
+	    tra un gruppo e il successivo.
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+
+		@param begin iteratore che punta all'inizio della sequenza
+		@param end iteratore che punta alla fine della sequenza
+	*/
+	template <typename IterT>
+	void enqueue(IterT begin, IterT end) {
+		while(begin != end) {
+		    std::unique_lock<std::mutex> lock(_mutex);
+		    wait(lock, _not_full, _waiting_producers,
+		         [this]() { return _queue.size() < _capacity; });
+		    size_type inserted = 0;
+		    while(begin != end && _queue.size() < _capacity) {
+		        _queue.enqueue(static_cast<value_type>(*begin));
+		        ++begin;
+		        ++inserted;
+		    }
+		    bool notify = _waiting_consumers > 0;
+		    lock.unlock();
+		    if(notify) {
+		        if(inserted > 1)
+		            _not_empty.notify_all();
+		        else
+		            _not_empty.notify_one();
+		    }
+		}
+	}
+
+	/**
+		@brief Tentativo di inserimento di un singolo elemento
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda solo se la coda non è piena, senza attendere.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+	bool try_enqueue(const value_type &value) {
+		return try_push(value);
+	}
+
+	/**
+		@brief Tentativo di inserimento di un singolo elemento per spostamento
+
+		@overload try_enqueue
+
+		@param value valore dell'elemento da spostare nella coda
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+	bool try_enqueue(value_type &&value) {
+		return try_push(std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento con limite di tempo
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, attendendo al più il tempo indicato che un consumatore
+	    liberi una posizione.
+
+		@param value valore dell'elemento da inserire nella coda
+		@param timeout tempo massimo di attesa
+
+		@return true se l'elemento è stato inserito, false se il tempo
+		        è scaduto con la coda ancora piena
+	*/
+	template <typename Rep, typename Period>
+	bool enqueue_for(const value_type &value,
+	                 const std::chrono::duration<Rep, Period> &timeout) {
+		return timed_push(value, timeout);
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento per spostamento con limite
+		       di tempo
+
+		@overload enqueue_for
+
+		@description
+	    Il valore viene spostato solo se l'elemento viene inserito.
+
+		@param value valore dell'elemento da spostare nella coda
+		@param timeout tempo massimo di attesa
+
+		@return true se l'elemento è stato inserito, false se il tempo
+		        è scaduto con la coda ancora piena
+	*/
+	template <typename Rep, typename Period>
+	bool enqueue_for(value_type &&value,
+	                 const std::chrono::duration<Rep, Period> &timeout) {
+		return timed_push(std::move(value), timeout);
+	}
+
+    /**
+        @brief Rimozione bloccante dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda e ne restituisce il valore; se la coda è vuota, il thread
+        chiamante viene sospeso finché un produttore non inserisce
+        un elemento. A differenza della classe queue, una coda vuota
+        non provoca il lancio di eccezioni.
+
+        @return valore dell'elemento rimosso
+
+        @post Il numero di elementi inseriti nella coda viene decrementato
+              di un'unità.
+    */
+    value_type dequeue() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        wait(lock, _not_empty, _waiting_consumers,
+             [this]() { return _queue.size() > 0; });
+        value_type removed_value = _queue.dequeue();
+        bool notify = _waiting_producers > 0;
+        lock.unlock();
+        if(notify)
+            _not_full.notify_one();
+        return removed_value;
+    }
+
+    /**
+        @brief Tentativo di rimozione dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio della coda, spostandone il valore
+        nel parametro passato per riferimento, senza attendere.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(_queue.size() == 0)
+            return false;
+        pop_and_notify(lock, out);
+        return true;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda con limite
+               di tempo
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda, spostandone il valore nel parametro passato
+        per riferimento, attendendo al più il tempo indicato che un produttore
+        inserisca un elemento.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+        @param timeout tempo massimo di attesa
+
+        @return true se un elemento è stato rimosso, false se il tempo
+                è scaduto con la coda ancora vuota
+    */
+    template <typename Rep, typename Period>
+    bool dequeue_for(value_type &out,
+                     const std::chrono::duration<Rep, Period> &timeout) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(!wait_for(lock, _not_empty, _waiting_consumers,
+                     [this]() { return _queue.size() > 0; }, timeout))
+            return false;
+        pop_and_notify(lock, out);
+        return true;
+    }
+
+    /**
+        @brief Rimozione bloccante di un gruppo di elementi
+
+        @description
+        Metodo dell'interfaccia pubblica che attende che la coda contenga
+        almeno un elemento e ne rimuove poi, in ordine, fino a max,
+        spostandone i valori nell'iteratore di output; i produttori in attesa
+        vengono notificati una sola volta per l'intero gruppo.
+        Se max è 0 restituisce subito 0, senza attendere.
+
+        @tparam OutIt tipo dell'iteratore di output
+
+        @param out iteratore di output in cui spostare i valori rimossi
+        @param max numero massimo di elementi da rimuovere
+
+        @return numero di elementi rimossi
+    */
+    template <typename OutIt>
+    size_type dequeue_bulk(OutIt out, size_type max) {
+        if(max == 0)
+            return 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        wait(lock, _not_empty, _waiting_consumers,
+             [this]() { return _queue.size() > 0; });
+        size_type removed = 0;
+        while(removed < max && _queue.size() > 0) {
+            *out = _queue.dequeue();
+            ++out;
+            ++removed;
+        }
+        bool notify = _waiting_producers > 0;
+        lock.unlock();
+        if(notify) {
+            if(removed > 1)
+                _not_full.notify_all();
+            else
+                _not_full.notify_one();
+        }
+        return removed;
+    }
+};
+
+#endif
+
+// Fine file header blocking_queue.h
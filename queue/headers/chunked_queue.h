@@ -0,0 +1,1593 @@
+/**
+	@headerfile chunked_queue.h
+
+    @brief Dichiarazione e definizione della classe chunked_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    chunked_queue, una coda FIFO con la stessa interfaccia della classe queue
+    ma con gli elementi memorizzati in blocchi contigui, di una funzione
+    globale transformif e della ridefinizione dell'operatore di stream <<
+    per la classe chunked_queue.
+*/
+
+// Guardie del file header chunked_queue.h
+
+#ifndef CHUNKED_QUEUE_H
+#define CHUNKED_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <ostream> // std::ostream
+#include <istream> // std::istream
+#include <iterator> // std::forward_iterator_tag, std::make_move_iterator
+#include <cstddef> // std::ptrdiff_t
+#include <cstring> // std::memcpy
+#include <new> // placement new
+#include <utility> // std::swap, std::move, std::forward
+#include <type_traits> // std::is_trivially_destructible,
+                       // std::is_trivially_copyable, std::is_same
+#include <exception> // std::exception_ptr, std::current_exception,
+                     // std::rethrow_exception
+#include "simd_search.h" // is_simd_searchable, simd::find, simd::count
+#include "text_format.h" // text::write_sequence
+#include "binary_io.h" // binary::write_queue, binary::read_queue
+#include "text_parse.h" // text::read_sequence
+#include "queue_exceptions.h" // empty_queue_exception,
+                              // queue_iterator_out_of_bounds_exception
+
+// Dichiarazione e definizione della classe template chunked_queue
+
+/**
+	@brief Coda FIFO a blocchi
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    con la stessa interfaccia e la stessa semantica della classe queue.
+    A differenza di queue, che alloca un elemento dinamico per ogni
+    inserimento, gli elementi sono memorizzati in blocchi (chunk) di N
+    posizioni contigue, concatenati tra loro in una lista.
+    Un nuovo blocco viene allocato solo ogni N inserimenti e un blocco
+    viene deallocato solo quando tutti i suoi elementi sono stati rimossi.
+    Inoltre, l'ultimo blocco svuotato viene conservato come blocco di riserva,
+    così che un ciclo stazionario di inserimenti e rimozioni non richieda
+    alcuna allocazione.
+    Le operazioni d'inserimento e rimozione sono eseguite in tempo costante.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam N numero di posizioni di ciascun blocco (default 128)
+*/
+template <typename T, typename E, unsigned int N = 128>
+class chunked_queue {
+
+    static_assert(N > 0, "Un blocco deve contenere almeno una posizione.");
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+    /**
+        @brief Sequenze copiabili in blocco
+
+        @description
+        Vale true se IterT è un puntatore al tipo degli elementi e questo
+        è banalmente copiabile: l'inserimento di un intervallo copia allora
+        i valori con std::memcpy invece che uno alla volta.
+    */
+    template <typename IterT>
+    struct is_bulk_copyable : std::integral_constant<bool,
+        std::is_trivially_copyable<value_type>::value &&
+        (std::is_same<IterT, value_type *>::value ||
+         std::is_same<IterT, const value_type *>::value)> {};
+
+    // Strutture di supporto interne private della coda
+
+	/**
+		@brief Blocco della coda
+
+		@description
+	    Struttura di supporto interna privata della coda che implementa
+	    un blocco di N posizioni contigue, non inizializzate, in cui vengono
+	    costruiti i valori degli elementi, e il puntatore al blocco successivo.
+	    I valori sono costruiti e distrutti esplicitamente dalla coda:
+	    il blocco non conosce quali delle sue posizioni sono occupate.
+	*/
+	struct chunk {
+
+		alignas(value_type) unsigned char storage[N * sizeof(value_type)];
+		                          ///< @brief Memoria delle N posizioni
+		chunk *next; ///< @brief Puntatore al blocco successivo della coda
+
+		/**
+			@brief Costruttore di default
+
+			@description
+		    Costruttore di default per istanziare un blocco vuoto, senza
+		    alcun blocco successivo.
+		*/
+		chunk() : next(nullptr) {} // initialization list
+
+		/**
+			@brief Accesso a una posizione del blocco
+
+			@param i indice della posizione (0 <= i < N)
+
+			@return puntatore al valore nella posizione i
+		*/
+		value_type *slot(size_type i) {
+			return reinterpret_cast<value_type *>(storage) + i;
+		}
+
+		/**
+			@brief Accesso in sola lettura a una posizione del blocco
+
+			@param i indice della posizione (0 <= i < N)
+
+			@return puntatore costante al valore nella posizione i
+		*/
+		const value_type *slot(size_type i) const {
+			return reinterpret_cast<const value_type *>(storage) + i;
+		}
+
+	}; // struct chunk
+
+	// Dati membro privati della coda
+
+	chunk *_head; ///< @brief Puntatore al blocco in testa alla coda
+	size_type _head_index; ///< @brief Posizione dell'elemento in testa
+	                       ///< all'interno del blocco in testa
+	chunk *_tail; ///< @brief Puntatore al blocco in coda alla coda
+	size_type _tail_index; ///< @brief Posizione successiva a quella
+	                       ///< dell'elemento in coda all'interno del blocco
+	                       ///< in coda
+	size_type _size; ///< @brief Numero di elementi inseriti nella coda
+	chunk *_spare; ///< @brief Blocco vuoto di riserva (oppure nullptr)
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi della coda
+
+    /*
+        Invarianti della coda:
+        se _head == nullptr la coda non possiede alcun blocco;
+        se _size == 0 e _head != nullptr, allora _head == _tail e
+        _head_index == _tail_index == 0;
+        se _size > 0 gli elementi occupano, in ordine FIFO, le posizioni
+        da (_head, _head_index) compresa a (_tail, _tail_index) esclusa,
+        con 1 <= _tail_index <= N e tutti i blocchi intermedi pieni.
+    */
+
+    // Funzioni private della coda
+
+    /**
+		@brief Acquisizione di un blocco vuoto
+
+		@description
+        Funzione privata che restituisce il blocco di riserva, se presente,
+        oppure istanzia un nuovo blocco dinamico nell'heap.
+
+        @return puntatore a un blocco vuoto, senza blocco successivo
+
+		@throw eccezione di allocazione di memoria
+	*/
+    chunk *acquire_chunk() {
+        chunk *c = _spare;
+        if(c != nullptr) {
+            _spare = nullptr;
+            c->next = nullptr;
+            return c;
+        }
+        return new chunk();
+    }
+
+    /**
+		@brief Rilascio di un blocco vuoto
+
+		@description
+        Funzione privata che conserva il blocco come blocco di riserva,
+        se non ne è già presente uno, oppure lo dealloca.
+
+        @param c puntatore al blocco da rilasciare, i cui valori sono già
+               stati distrutti
+	*/
+    void release_chunk(chunk *c) {
+        if(_spare == nullptr)
+            _spare = c;
+        else
+            delete c;
+    }
+
+    /**
+		@brief Distruzione dei valori di un tratto della coda
+
+		@description
+        Funzione privata che distrugge count valori consecutivi a partire
+        dalla posizione i del blocco c, proseguendo nei blocchi successivi.
+        I blocchi non vengono deallocati.
+
+        @param c blocco da cui iniziare la distruzione
+        @param i posizione da cui iniziare la distruzione
+        @param count numero di valori da distruggere
+	*/
+    static void destroy_values(chunk *c, size_type i, size_type count) {
+        while(count > 0) {
+            if(i == N) {
+                c = c->next;
+                i = 0;
+            }
+            c->slot(i)->~value_type();
+            ++i;
+            --count;
+        }
+    }
+
+    /**
+		@brief Ripristino della coda a uno stato precedente
+
+		@description
+        Funzione privata che riporta la coda allo stato in cui il blocco in coda
+        era t, la posizione successiva all'elemento in coda era ti e il numero
+        di elementi era s, distruggendo i valori inseriti successivamente
+        e deallocando i blocchi aggiunti nel frattempo.
+        Utilizzata per garantire che un inserimento multiplo fallito lasci
+        la coda allo stato precedente alla chiamata, e da remove_if per
+        eliminare gli elementi rimasti dopo la compattazione.
+
+        @param t blocco in coda nello stato da ripristinare (oppure nullptr)
+        @param ti posizione successiva all'elemento in coda nello stato
+               da ripristinare
+        @param s numero di elementi nello stato da ripristinare
+	*/
+    void rollback(chunk *t, size_type ti, size_type s) {
+        chunk *first = (t != nullptr) ? t : _head;
+        size_type first_index = (t != nullptr) ? ti : 0;
+        destroy_values(first, first_index, _size - s);
+
+        chunk *c = (t != nullptr) ? t->next : _head;
+        while(c != nullptr) {
+            chunk *next = c->next;
+            delete c;
+            c = next;
+        }
+
+        if(t == nullptr)
+            _head = nullptr;
+        else
+            t->next = nullptr;
+        _tail = t;
+        _tail_index = ti;
+        _size = s;
+    }
+
+    /**
+		@brief Scambio dei dati membro con un'altra coda
+
+		@param other coda con cui scambiare i dati membro
+	*/
+    void swap_members(chunked_queue &other) {
+        std::swap(_head, other._head);
+        std::swap(_head_index, other._head_index);
+        std::swap(_tail, other._tail);
+        std::swap(_tail_index, other._tail_index);
+        std::swap(_size, other._size);
+        std::swap(_spare, other._spare);
+    }
+
+    /**
+		@brief Costruzione di un nuovo valore in coda alla coda
+
+		@description
+        Funzione privata che costruisce un nuovo valore nella prima posizione
+        libera del blocco in coda, inoltrandone gli argomenti al costruttore
+        del tipo T.
+        Se il blocco in coda è pieno (o la coda non possiede blocchi),
+        il valore viene costruito in un nuovo blocco, che viene concatenato
+        alla coda solo dopo che la costruzione è andata a buon fine.
+
+        Nel caso in cui venga lanciata un'eccezione, la coda rimane allo stato
+        precedente alla chiamata e l'eccezione viene propagata alla funzione
+        chiamante.
+
+        @tparam Args tipi degli argomenti del costruttore del tipo T
+
+        @param args argomenti del costruttore del tipo T
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+        @throw eccezione di allocazione di memoria
+	*/
+    template <typename... Args>
+    void construct_back(Args&&... args) {
+		if(_tail == nullptr || _tail_index == N) {
+		    chunk *c = acquire_chunk();
+		    try {
+		        new (c->slot(0)) value_type(std::forward<Args>(args)...);
+		    }
+		    catch(...) {
+		        release_chunk(c);
+		        throw;
+		    }
+
+		    if(_tail == nullptr) {
+		        _head = c;
+		        _head_index = 0;
+		    }
+		    else
+		        _tail->next = c;
+		    _tail = c;
+		    _tail_index = 1;
+		}
+		else {
+		    new (_tail->slot(_tail_index))
+		        value_type(std::forward<Args>(args)...);
+		    ++_tail_index;
+		}
+
+		_size++;
+    }
+
+    /**
+		@brief Rimozione dell'elemento in testa alla coda
+
+		@description
+        Funzione privata che distrugge il valore dell'elemento in testa
+        alla coda, rilasciando il blocco in testa
+        se si svuota.
+
+        @pre La coda non dev'essere vuota.
+
+        @post Il numero di elementi inseriti nella coda viene decrementato
+              di un'unità.
+	*/
+    void pop_head() {
+        _head->slot(_head_index)->~value_type();
+        ++_head_index;
+        _size--;
+
+        if(_size == 0) {
+            _head_index = 0;
+            _tail_index = 0;
+        }
+        else if(_head_index == N) {
+            chunk *old = _head;
+            _head = _head->next;
+            _head_index = 0;
+            release_chunk(old);
+        }
+    }
+
+    /**
+		@brief Deallocazione del blocco di riserva
+	*/
+    void trim_spare() {
+        delete _spare;
+        _spare = nullptr;
+    }
+
+    /**
+		@brief Ricerca di un valore in un tratto contiguo di un blocco
+
+		@description
+        Funzione privata che cerca il primo elemento uguale al valore dato
+        tra gli n elementi a partire da p. Se il funtore E equivale a ==
+        e T è un tipo aritmetico supportato (is_simd_searchable),
+        i confronti sono vettoriali; altrimenti il funtore viene chiamato
+        su un elemento alla volta.
+
+		@param p puntatore al primo elemento del tratto
+		@param n numero di elementi del tratto
+		@param value valore da cercare
+
+		@return indice nel tratto del primo elemento uguale, oppure n
+	*/
+    size_type find_in(const value_type *p, size_type n,
+                      const value_type &value) const {
+        if constexpr(is_simd_searchable<T, E>::value)
+            return static_cast<size_type>(simd::find(p, n, value));
+        else {
+            for(size_type i = 0; i < n; ++i)
+                if(_equals(p[i], value))
+                    return i;
+            return n;
+        }
+    }
+
+    /**
+		@brief Conteggio di un valore in un tratto contiguo di un blocco
+
+		@param p puntatore al primo elemento del tratto
+		@param n numero di elementi del tratto
+		@param value valore da contare
+
+		@return numero di elementi del tratto uguali al valore
+	*/
+    size_type count_in(const value_type *p, size_type n,
+                       const value_type &value) const {
+        if constexpr(is_simd_searchable<T, E>::value)
+            return static_cast<size_type>(simd::count(p, n, value));
+        else {
+            size_type c = 0;
+            for(size_type i = 0; i < n; ++i)
+                if(_equals(p[i], value))
+                    ++c;
+            return c;
+        }
+    }
+
+    /**
+		@brief Localizzazione del primo elemento di un certo valore
+
+		@description
+        Funzione privata che scandisce la coda blocco per blocco,
+        cercando il valore in ogni tratto di posizioni contigue.
+
+		@param value valore da cercare
+		@param c blocco dell'elemento trovato
+		@param i posizione dell'elemento trovato nel blocco
+		@param left numero di elementi dall'elemento trovato (compreso)
+		       alla fine della coda
+
+		@return true se l'elemento è stato trovato, false altrimenti
+	*/
+    bool locate(const value_type &value, chunk *&c, size_type &i,
+                size_type &left) const {
+        c = _head;
+        i = _head_index;
+        left = _size;
+
+        while(left > 0) {
+            size_type last = (N - i < left) ? N : i + left;
+            size_type j = find_in(c->slot(i), last - i, value);
+            if(j < last - i) {
+                i += j;
+                left -= j;
+                return true;
+            }
+            left -= last - i;
+            c = c->next;
+            i = 0;
+        }
+
+        return false;
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di default per istanziare una coda vuota.
+	    La coda vuota non possiede alcun blocco: il primo blocco viene
+	    allocato al primo inserimento.
+	*/
+	chunked_queue() :
+	    _head(nullptr), _head_index(0), _tail(nullptr), _tail_index(0),
+	    _size(0), _spare(nullptr) {} // initialization list
+
+	/**
+		@brief Costruttore di copia/Copy Constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di copia/Copy Constructor della coda, che permette
+	    di istanziare una coda con i valori presi da un'altra coda,
+	    mantenendo l'ordine originale.
+
+	    Nel caso in cui venga lanciata un'eccezione durante l'inserimento
+	    degli elementi, la coda corrente viene eliminata completamente
+	    e l'eccezione viene propagata alla funzione chiamante.
+
+		@param other coda da copiare per istanziare quella corrente
+
+		@throw eccezione di allocazione di memoria
+	*/
+	chunked_queue(const chunked_queue &other) :
+	    _head(nullptr), _head_index(0), _tail(nullptr), _tail_index(0),
+	    _size(0), _spare(nullptr) { // initialization list
+
+        try {
+            enqueue(other.begin(), other.end());
+        }
+        catch(...) {
+            clear();
+            trim_spare();
+            throw;
+        }
+	}
+
+	/**
+		@brief Costruttore di spostamento/Move Constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di spostamento/Move Constructor della coda, che permette
+	    di istanziare una coda acquisendo in tempo costante i blocchi
+	    di un'altra coda, senza copiarne i valori.
+	    La coda da spostare rimane vuota.
+
+		@param other coda da spostare per istanziare quella corrente
+	*/
+	chunked_queue(chunked_queue &&other) noexcept :
+	    _head(nullptr), _head_index(0), _tail(nullptr), _tail_index(0),
+	    _size(0), _spare(nullptr) { // initialization list
+
+	    swap_members(other);
+	}
+
+	/**
+		@brief Operatore di assegnamento (METODO FONDAMENTALE)
+
+		@description
+	    Operatore di assegnamento della coda, che permette la copia tra code.
+	    La copia avviene tramite una coda temporanea, i cui dati membro
+	    vengono scambiati con quelli della coda corrente.
+
+		@param other coda come sorgente da copiare (operando di destra)
+
+		@return riferimento alla coda corrente (this)
+
+		@throw eccezione di allocazione di memoria
+	*/
+	chunked_queue &operator=(const chunked_queue &other) {
+		if(this != &other) {
+			chunked_queue tmp(other);
+			swap_members(tmp);
+		}
+		return *this;
+	}
+
+	/**
+		@brief Operatore di assegnamento per spostamento (METODO FONDAMENTALE)
+
+		@description
+	    Operatore di assegnamento per spostamento della coda, che permette
+	    di acquisire in tempo costante i blocchi di un'altra coda,
+	    senza copiarne i valori.
+	    Gli elementi della coda corrente vengono rimossi e la coda spostata
+	    rimane vuota.
+
+		@param other coda come sorgente da spostare (operando di destra)
+
+		@return riferimento alla coda corrente (this)
+	*/
+	chunked_queue &operator=(chunked_queue &&other) noexcept {
+		if(this != &other) {
+			chunked_queue tmp(std::move(other));
+			swap_members(tmp);
+		}
+		return *this;
+	}
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore della coda, che distrugge tutti i valori e dealloca
+	    tutti i blocchi della coda.
+	*/
+	virtual ~chunked_queue() {
+		clear();
+		trim_spare();
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        return _size;
+    }
+
+    /**
+		@brief Rimozione dell'intero contenuto della coda
+
+		@description
+        Metodo dell'interfaccia pubblica che rimuove tutti gli elementi
+        della coda, che rimane vuota e utilizzabile.
+        La distruzione dei valori avviene blocco per blocco (ed è del tutto
+        omessa se il tipo T ha un distruttore banale) e ogni blocco viene
+        deallocato con un'unica operazione; un blocco viene conservato
+        come blocco di riserva per i successivi inserimenti.
+
+        @post Il numero di elementi inseriti nella coda è pari a 0.
+        @post La memoria allocata dai blocchi della coda viene deallocata,
+	          ad eccezione del blocco di riserva.
+	*/
+    void clear() {
+        if(!std::is_trivially_destructible<value_type>::value && _size > 0)
+            destroy_values(_head, _head_index, _size);
+
+        while(_head != nullptr) {
+            chunk *next = _head->next;
+            release_chunk(_head);
+            _head = next;
+        }
+
+        _tail = nullptr;
+        _head_index = 0;
+        _tail_index = 0;
+        _size = 0;
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, costruendone il valore nella prima posizione libera
+	    del blocco in coda.
+	    Se il blocco in coda è pieno (o la coda non possiede blocchi),
+	    il valore viene costruito in un nuovo blocco, che viene concatenato
+	    alla coda solo dopo che la costruzione è andata a buon fine.
+	    L'operazione di inserimento è eseguita in tempo costante.
+
+	    Nel caso in cui venga lanciata un'eccezione (di allocazione di memoria
+	    o dalla copia del valore), la coda rimane allo stato precedente
+	    alla chiamata e l'eccezione viene propagata alla funzione chiamante.
+
+		@param value valore dell'elemento da inserire nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(const value_type &value) {
+		construct_back(value);
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda per spostamento
+
+		@overload enqueue
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, spostandone il valore anziché copiarlo.
+	    Per il resto, si comporta come l'inserimento per copia.
+
+		@param value valore dell'elemento da spostare nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(value_type &&value) {
+		construct_back(std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento costruito sul posto
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, costruendone il valore direttamente nel blocco in coda
+	    a partire dagli argomenti del costruttore del tipo T,
+	    senza istanziare alcun valore temporaneo.
+	    Nel caso in cui venga lanciata un'eccezione, la coda rimane allo stato
+	    precedente alla chiamata.
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		construct_back(std::forward<Args>(args)...);
+	}
+
+    /**
+        @brief Inserimento nella coda di un insieme di elementi presi da una
+               sequenza identificata da due iteratori
+
+        @overload enqueue
+
+        @description
+        Metodo dell'interfaccia pubblica che inserisce nella coda gli elementi
+        di una sequenza generica identificata da due iteratori, convertendoli
+        nel tipo T tramite static_cast<T>.
+        Se gli iteratori sono puntatori a valori banalmente copiabili,
+        la sequenza viene copiata con uno std::memcpy per ogni blocco.
+        Nel caso in cui venga lanciata un'eccezione durante l'inserimento,
+        gli elementi già inseriti vengono rimossi, la coda rimane allo stato
+        precedente alla chiamata e l'eccezione viene propagata alla funzione
+        chiamante.
+
+        @pre Il tipo del valore degli elementi della sequenza deve essere
+             convertibile nel tipo del valore degli elementi della coda.
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+                di elementi da inserire nella coda
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+        @throw eccezione di allocazione di memoria
+    */
+    template <typename IterT>
+    void enqueue(IterT begin, IterT end) {
+        chunk *old_tail = _tail;
+        size_type old_tail_index = _tail_index;
+        size_type old_size = _size;
+
+        try {
+            if constexpr(is_bulk_copyable<IterT>::value) {
+                while(begin != end) {
+                    if(_tail == nullptr || _tail_index == N) {
+                        chunk *c = acquire_chunk();
+                        if(_tail == nullptr) {
+                            _head = c;
+                            _head_index = 0;
+                        }
+                        else
+                            _tail->next = c;
+                        _tail = c;
+                        _tail_index = 0;
+                    }
+                    size_type k = N - _tail_index;
+                    if(static_cast<size_type>(end - begin) < k)
+                        k = static_cast<size_type>(end - begin);
+                    std::memcpy(static_cast<void *>(_tail->slot(_tail_index)),
+                                begin, k * sizeof(value_type));
+                    _tail_index += k;
+                    _size += k;
+                    begin += k;
+                }
+            }
+            else {
+                while(begin != end) {
+                    enqueue(static_cast<value_type>(*begin));
+                    ++begin;
+                }
+            }
+        }
+        catch(...) {
+            rollback(old_tail, old_tail_index, old_size);
+            throw;
+        }
+    }
+
+    /**
+        @brief Concatenamento di un'altra coda in coda alla coda corrente
+
+        @description
+        Metodo dell'interfaccia pubblica che sposta tutti gli elementi
+        di un'altra coda in coda alla coda corrente, mantenendone l'ordine.
+        Se la coda corrente è vuota, i blocchi delle due code vengono scambiati in tempo
+        costante; altrimenti, i valori vengono spostati uno alla volta.
+        In ogni caso, l'altra coda rimane vuota.
+
+        @param other coda da concatenare
+
+        @post Il numero di elementi inseriti nella coda viene incrementato
+              di tante unità quanti erano gli elementi dell'altra coda.
+
+        @throw eccezione di allocazione di memoria
+    */
+    void splice(chunked_queue &&other) {
+        if(this == &other || other._size == 0)
+            return;
+        if(_size == 0)
+            swap_members(other);
+        else {
+            enqueue(std::make_move_iterator(other.begin()),
+                    std::make_move_iterator(other.end()));
+        }
+        other.clear();
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda (l'elemento in testa alla coda) e ne restituisce il valore,
+        spostandolo anziché copiarlo.
+        Quando il blocco in testa si svuota, viene rilasciato (conservandolo
+        eventualmente come blocco di riserva).
+        Se la coda si svuota, il blocco in testa viene mantenuto e riutilizzato
+        dai successivi inserimenti.
+        L'operazione di rimozione è eseguita in tempo costante.
+
+        @pre La coda non dev'essere vuota.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        value_type removed_value(std::move(*_head->slot(_head_index)));
+        pop_head();
+
+        return removed_value;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda senza eccezioni
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio della coda (l'elemento in testa
+        alla coda), spostandone il valore nel parametro passato per riferimento.
+        A differenza di dequeue, se la coda è vuota non viene lanciata alcuna
+        eccezione: la funzione restituisce false e il parametro non viene
+        modificato. È quindi adatta a consumatori che interrogano
+        ripetutamente la coda.
+        Se lo spostamento del valore lancia un'eccezione, la coda rimane
+        allo stato precedente alla chiamata.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+
+        @post Se la coda non era vuota, il numero di elementi inseriti
+              nella coda viene decrementato di un'unità.
+    */
+    bool try_dequeue(value_type &out) {
+        if(_size == 0)
+            return false;
+        out = std::move(*_head->slot(_head_index));
+        pop_head();
+        return true;
+    }
+
+	/**
+		@brief Accesso in lettura all'elemento più recente della coda
+
+	    @pre La coda non dev'essere vuota.
+
+		@return valore dell'elemento più recente della coda
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    value_type &get_tail() const {
+	    if(_size == 0)
+	        throw empty_queue_exception("Impossibile leggere l'elemento piu' "
+                                        "recente: la coda e' vuota.");
+	    return *_tail->slot(_tail_index - 1);
+	}
+
+    /**
+        @brief Accesso in scrittura all'elemento più recente della coda
+
+        @pre La coda non dev'essere vuota.
+
+        @param value valore da assegnare all'elemento più recente della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_tail(const value_type &value) {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile assegnare il valore "
+                                        "all'elemento piu' recente: "
+                                        "la coda e' vuota.");
+        *_tail->slot(_tail_index - 1) = value;
+    }
+
+    /**
+		@brief Accesso in lettura all'elemento più vecchio della coda
+
+	    @pre La coda non dev'essere vuota.
+
+		@return valore dell'elemento più vecchio della coda
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    value_type &get_head() const {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile leggere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        return *_head->slot(_head_index);
+    }
+
+    /**
+        @brief Accesso in scrittura all'elemento più vecchio della coda
+
+        @pre La coda non dev'essere vuota.
+
+        @param value valore da assegnare all'elemento più vecchio della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_head(const value_type &value) {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile assegnare il valore "
+                                        "all'elemento piu' vecchio: "
+                                        "la coda e' vuota.");
+        *_head->slot(_head_index) = value;
+    }
+
+    /**
+		@brief Esistenza nella coda di almeno un elemento di un certo valore
+               dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina se la coda corrente
+        contiene almeno un elemento di un certo valore dato.
+        La scansione procede blocco per blocco su posizioni contigue.
+        Se il funtore E equivale a == (is_plain_equality) e T è un tipo
+        aritmetico a 32 o 64 bit, ogni blocco viene confrontato
+        con istruzioni vettoriali SSE2 o AVX2.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+	*/
+    bool contains(const value_type &value) const {
+        chunk *c;
+        size_type i, left;
+        return locate(value, c, i, left);
+    }
+
+    /**
+		@brief Numero di elementi di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che conta gli elementi uguali
+        al valore dato, blocco per blocco, con gli stessi confronti
+        di contains.
+
+		@param value valore degli elementi da contare
+
+		@return numero di elementi della coda del valore dato
+	*/
+    size_type count(const value_type &value) const {
+        const chunk *c = _head;
+        size_type i = _head_index;
+        size_type left = _size;
+        size_type n = 0;
+
+        while(left > 0) {
+            size_type last = (N - i < left) ? N : i + left;
+            n += count_in(c->slot(i), last - i, value);
+            left -= last - i;
+            c = c->next;
+            i = 0;
+        }
+
+        return n;
+    }
+
+    /**
+		@brief Rimozione degli elementi che soddisfano un predicato
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove dalla coda gli elementi
+        che soddisfano il predicato, con un'unica passata e senza allocare
+        blocchi: gli elementi mantenuti vengono spostati verso la testa,
+        nel loro ordine FIFO, poi gli ultimi elementi rimasti vengono
+        distrutti e i blocchi rimasti vuoti deallocati.
+        Il predicato viene chiamato una sola volta per ogni elemento,
+        in ordine FIFO.
+
+		@param pred predicato che gli elementi devono soddisfare per essere
+               rimossi
+
+		@return numero di elementi rimossi
+
+        @throw eccezione lanciata da pred: gli elementi già esaminati
+               restano rimossi, gli altri vengono mantenuti
+	*/
+    template <typename P>
+    size_type remove_if(P pred) {
+        std::exception_ptr error;
+        chunk *rc = _head, *wc = _head;
+        size_type ri = _head_index, wi = _head_index;
+        size_type kept = 0;
+
+        for(size_type left = _size; left > 0; --left, ++ri) {
+            if(ri == N) {
+                rc = rc->next;
+                ri = 0;
+            }
+            value_type &value = *rc->slot(ri);
+            bool remove = false;
+            if(!error) {
+                try {
+                    remove = pred(value);
+                }
+                catch(...) {
+                    error = std::current_exception();
+                }
+            }
+            if(remove)
+                continue;
+            if(wi == N) {
+                wc = wc->next;
+                wi = 0;
+            }
+            if(wc != rc || wi != ri)
+                *wc->slot(wi) = std::move(value);
+            ++wi;
+            ++kept;
+        }
+
+        size_type removed = _size - kept;
+        if(kept == 0)
+            clear();
+        else if(removed > 0)
+            rollback(wc, wi, kept);
+        if(error)
+            std::rethrow_exception(error);
+        return removed;
+    }
+
+    // Supporto agli iteratori della coda
+
+    class const_iterator; // forward declaration dell'iteratore costante
+
+    /**
+		@brief Iteratore della coda in lettura e scrittura di tipo forward
+
+	    @description
+		Iteratore della coda in lettura e scrittura di tipo forward.
+		Gli elementi sono ritornati seguendo la logica FIFO.
+		L'iteratore conosce il blocco e la posizione dell'elemento puntato
+		e il numero di elementi rimanenti fino alla fine della coda.
+	*/
+    class iterator {
+
+        chunk *_c; ///< @brief Puntatore al blocco dell'elemento puntato
+        size_type _i; ///< @brief Posizione dell'elemento nel blocco
+        size_type _left; ///< @brief Numero di elementi rimanenti (compreso
+                         ///< quello puntato)
+
+    public:
+
+        // Traits dell'iteratore
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef T                         value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef T*                        pointer; ///< @brief Tipo puntatore
+        typedef T&                        reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        iterator() : _c(nullptr), _i(0), _left(0) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return *_c->slot(_i);
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore dell'elemento puntato dall'iteratore
+		*/
+        pointer operator->() const {
+            return _c->slot(_i);
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@return riferimento all'iteratore corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator& operator++() {
+            if(_c == nullptr)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            advance();
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore corrente prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator operator++(int) {
+            iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+
+			@return true se i due iteratori puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator==(const iterator &other) const {
+            return (_c == other._c && _i == other._i);
+        }
+
+        /**
+			@brief Operatore di diversità
+
+			@return true se i due iteratori non puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+        friend class const_iterator;
+
+        /**
+			@brief Operatore di uguaglianza con un iteratore costante
+		*/
+        bool operator==(const const_iterator &other) const {
+            return (_c == other._c && _i == other._i);
+        }
+
+        /**
+			@brief Operatore di diversità con un iteratore costante
+		*/
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class chunked_queue; // per permettere alla classe container
+                                    // di utilizzare il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param c blocco dell'elemento puntato
+			@param i posizione dell'elemento nel blocco
+			@param left numero di elementi rimanenti
+		*/
+        iterator(chunk *c, size_type i, size_type left) :
+            _c(c), _i(i), _left(left) {} // initialization list
+
+        /**
+			@brief Avanzamento all'elemento successivo
+		*/
+        void advance() {
+            if(--_left == 0) {
+                _c = nullptr;
+                _i = 0;
+            }
+            else if(++_i == N) {
+                _c = _c->next;
+                _i = 0;
+            }
+        }
+
+    }; // class iterator
+
+    /**
+		@brief Iteratore che punta all'inizio della coda
+
+		@return iteratore che punta all'inizio della coda
+	*/
+    iterator begin() {
+        if(_size == 0)
+            return iterator();
+        return iterator(_head, _head_index, _size);
+    }
+
+    /**
+		@brief Iteratore che punta alla fine della coda
+
+		@return iteratore che punta alla fine della coda
+	*/
+    iterator end() {
+        return iterator();
+    }
+
+    /**
+		@brief Iteratore costante della coda di tipo forward
+
+	    @description
+		Iteratore costante (in sola lettura) della coda di tipo forward.
+		Gli elementi sono ritornati seguendo la logica FIFO.
+	*/
+    class const_iterator {
+
+        const chunk *_c; ///< @brief Puntatore al blocco dell'elemento puntato
+        size_type _i; ///< @brief Posizione dell'elemento nel blocco
+        size_type _left; ///< @brief Numero di elementi rimanenti (compreso
+                         ///< quello puntato)
+
+    public:
+
+        // Traits dell'iteratore costante
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef const T                   value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef const T*                  pointer; ///< @brief Tipo puntatore
+        typedef const T&                  reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        const_iterator() : _c(nullptr), _i(0), _left(0) {} // initialization list
+
+        /**
+			@brief Costruttore di conversione da iteratore in lettura e
+                   scrittura a iteratore costante
+
+			@param other iteratore in lettura e scrittura da convertire
+		*/
+        const_iterator(const iterator &other) :
+            _c(other._c), _i(other._i),
+            _left(other._left) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore costante dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return *_c->slot(_i);
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore costante dell'elemento puntato
+		*/
+        pointer operator->() const {
+            return _c->slot(_i);
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@return riferimento all'iteratore costante corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator& operator++() {
+            if(_c == nullptr)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore "
+                                                             "costante: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            if(--_left == 0) {
+                _c = nullptr;
+                _i = 0;
+            }
+            else if(++_i == N) {
+                _c = _c->next;
+                _i = 0;
+            }
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore costante prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+		*/
+        bool operator==(const const_iterator &other) const {
+            return (_c == other._c && _i == other._i);
+        }
+
+        /**
+			@brief Operatore di diversità
+		*/
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+        friend class iterator;
+
+        /**
+			@brief Operatore di uguaglianza con un iteratore in lettura
+                   e scrittura
+		*/
+        bool operator==(const iterator &other) const {
+            return (_c == other._c && _i == other._i);
+        }
+
+        /**
+			@brief Operatore di diversità con un iteratore in lettura
+                   e scrittura
+		*/
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class chunked_queue; // per permettere alla classe container
+                                    // di utilizzare il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param c blocco dell'elemento puntato
+			@param i posizione dell'elemento nel blocco
+			@param left numero di elementi rimanenti
+		*/
+        const_iterator(const chunk *c, size_type i, size_type left) :
+            _c(c), _i(i), _left(left) {} // initialization list
+
+    }; // class const_iterator
+
+    /**
+		@brief Iteratore costante che punta all'inizio della coda
+
+		@return iteratore costante che punta all'inizio della coda
+	*/
+    const_iterator begin() const {
+        if(_size == 0)
+            return const_iterator();
+        return const_iterator(_head, _head_index, _size);
+    }
+
+    /**
+		@brief Iteratore costante che punta alla fine della coda
+
+		@return iteratore costante che punta alla fine della coda
+	*/
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    /**
+		@brief Visita dei tratti contigui della coda
+
+		@description
+        Metodo dell'interfaccia pubblica che chiama f(p, n) sul tratto
+        di posizioni contigue occupato dagli elementi in ciascun blocco,
+        in ordine FIFO. Permette agli algoritmi di lavorare su memoria
+        contigua, ad esempio dividendola tra più thread o lasciando
+        che il compilatore vettorizzi i cicli.
+
+		@tparam F tipo della funzione da chiamare
+
+		@param f funzione chiamata con il puntatore al primo elemento
+		       e il numero di elementi di ogni tratto
+	*/
+    template <typename F>
+    void for_each_span(F f) {
+        chunk *c = _head;
+        size_type i = _head_index;
+        size_type left = _size;
+
+        while(left > 0) {
+            size_type last = (N - i < left) ? N : i + left;
+            f(c->slot(i), last - i);
+            left -= last - i;
+            c = c->next;
+            i = 0;
+        }
+    }
+
+    /**
+		@overload for_each_span
+
+		@description
+        Versione per le code costanti: f riceve puntatori costanti.
+	*/
+    template <typename F>
+    void for_each_span(F f) const {
+        const chunk *c = _head;
+        size_type i = _head_index;
+        size_type left = _size;
+
+        while(left > 0) {
+            size_type last = (N - i < left) ? N : i + left;
+            f(c->slot(i), last - i);
+            left -= last - i;
+            c = c->next;
+            i = 0;
+        }
+    }
+
+    /**
+		@brief Ricerca del primo elemento di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce un iteratore
+        al primo elemento (il più vecchio) uguale al valore dato,
+        con gli stessi confronti di contains.
+
+		@param value valore dell'elemento da cercare
+
+		@return iteratore al primo elemento del valore dato, oppure end()
+	*/
+    iterator find(const value_type &value) {
+        chunk *c;
+        size_type i, left;
+        if(!locate(value, c, i, left))
+            return iterator();
+        return iterator(c, i, left);
+    }
+
+    /**
+		@overload find
+
+		@return iteratore costante al primo elemento del valore dato,
+		        oppure end()
+	*/
+    const_iterator find(const value_type &value) const {
+        chunk *c;
+        size_type i, left;
+        if(!locate(value, c, i, left))
+            return const_iterator();
+        return const_iterator(c, i, left);
+    }
+
+}; // class chunked_queue
+
+// Funzioni globali
+
+/**
+	@brief Trasformazione dei valori degli elementi della coda a blocchi
+           che soddisfano un predicato
+
+    @description
+	Versione della funzione globale transformif per la classe chunked_queue.
+    Se Qi è un elemento della coda:
+    Qi = F(Qi) se P(Qi) == true
+    Qi = Qi    se P(Qi) == false
+
+    @tparam Q tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam N numero di posizioni di ciascun blocco della coda
+    @tparam P tipo del predicato
+    @tparam F tipo dell'operatore generico
+
+	@param q coda di cui modificare i valori contenuti
+	@param pred predicato che i valori devono soddisfare per essere modificati
+    @param op operatore generico con cui modificare i valori
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q, P pred, F op) {
+	typename chunked_queue<Q, E, N>::iterator i, ie;
+
+	for(i = q.begin(), ie = q.end(); i != ie; ++i)
+		if(pred(*i))
+			*i = op(*i);
+}
+
+// Operatori globali
+
+/**
+	@brief Ridefinizione dell'operatore di stream << per la coda a blocchi
+
+    @description
+	Ridefinizione dell'operatore di stream << per la stampa del contenuto
+	della coda a blocchi, nello stesso formato della classe queue.
+
+	@param os oggetto di stream di output
+	@param q coda da stampare
+
+	@return riferimento allo stream di output
+*/
+template <typename T, typename E, unsigned int N>
+std::ostream &operator<<(std::ostream &os, const chunked_queue<T, E, N> &q) {
+    return text::write_sequence(os, q.begin(), q.end(), q.size());
+}
+
+/**
+	@brief Ridefinizione dell'operatore di stream >> per la coda a blocchi
+
+    @description
+	Ridefinizione dell'operatore di stream >> per la lettura della coda
+	a blocchi nello stesso formato della classe queue; il contenuto
+	della coda viene sostituito solo se il testo è valido.
+
+	@param is oggetto di stream di input
+	@param q coda da leggere
+
+	@return riferimento allo stream di input
+*/
+template <typename T, typename E, unsigned int N>
+std::istream &operator>>(std::istream &is, chunked_queue<T, E, N> &q) {
+    return text::read_sequence(is, q);
+}
+
+/**
+	@brief Serializzazione binaria della coda a blocchi
+
+    @description
+	Funzione globale che scrive sullo stream os la coda a blocchi q nel
+    formato binario versionato di binary::write_queue: un'intestazione con
+    il numero di elementi seguita dai valori. Se il tipo degli elementi è
+    banalmente copiabile i valori vengono copiati a blocchi, direttamente
+    dai blocchi della coda; per gli altri tipi va specializzato
+    binary::codec (std::string è già supportato). Lo stream va aperto in
+    modalità binaria.
+
+	@param os oggetto di stream di output
+	@param q coda da scrivere
+
+    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+*/
+template <typename T, typename E, unsigned int N>
+void serialize(std::ostream &os, const chunked_queue<T, E, N> &q) {
+    binary::write_queue(os, q);
+}
+
+/**
+	@brief Deserializzazione binaria della coda a blocchi
+
+    @description
+	Funzione globale che legge dallo stream is una coda a blocchi scritta da
+    serialize e la sostituisce al contenuto di q; se i dati non sono validi
+    q non viene modificata. Dallo stream vengono letti solo i byte della
+    coda.
+
+	@param is oggetto di stream di input
+	@param q coda da sostituire
+
+    @throw serialize_queue_exception se l'intestazione non è valida
+           o i dati sono troncati
+*/
+template <typename T, typename E, unsigned int N>
+void deserialize(std::istream &is, chunked_queue<T, E, N> &q) {
+    binary::read_queue(is, q);
+}
+
+#endif
+
+// Fine file header chunked_queue.h
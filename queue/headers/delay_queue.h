@@ -0,0 +1,717 @@
+/**
+	@headerfile delay_queue.h
+
+    @brief Dichiarazione e definizione della classe delay_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    delay_queue, una coda di elementi con scadenza, in cui la rimozione
+    restituisce solo gli elementi già scaduti, implementata con una ruota
+    temporale gerarchica (hierarchical timing wheel).
+*/
+
+// Guardie del file header delay_queue.h
+
+#ifndef DELAY_QUEUE_H
+#define DELAY_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <array> // std::array
+#include <bit> // std::bit_width, std::countr_zero
+#include <chrono> // std::chrono::steady_clock, std::chrono::milliseconds
+#include <cstdint> // std::uint64_t
+#include <new> // placement new, operator delete
+#include <utility> // std::move, std::forward
+#include "queue_exceptions.h" // empty_queue_exception
+
+// Dichiarazione e definizione della classe template delay_queue
+
+/**
+	@brief Coda con scadenza
+
+	@description
+    Classe template che implementa una coda di elementi generici T, ciascuno
+    dei quali ha una scadenza (un istante dell'orologio Clock): la rimozione
+    restituisce solo gli elementi la cui scadenza è già trascorsa,
+    in ordine di scadenza e, a parità di scadenza, in ordine di inserimento.
+    Il tempo è discretizzato in tick di durata pari alla risoluzione
+    della coda, a partire dall'istante di costruzione: la scadenza
+    di un elemento viene arrotondata per eccesso al tick successivo,
+    in modo che l'elemento non venga mai restituito in anticipo.
+    Gli elementi in attesa sono conservati in una ruota temporale gerarchica
+    di LEVELS livelli da SLOTS posizioni: un elemento si trova nel livello
+    corrispondente alla cifra (in base SLOTS) più significativa in cui
+    la sua scadenza differisce dal tick corrente, nella posizione indicata
+    da quella cifra. Quando il tempo avanza fino all'inizio di una posizione
+    di un livello superiore, i suoi elementi vengono ridistribuiti (cascade)
+    nei livelli inferiori; quando raggiunge una posizione del livello 0,
+    i suoi elementi scadono e passano nella lista degli elementi pronti.
+    Ogni elemento viene ridistribuito al più LEVELS - 1 volte, spostando
+    il nodo senza copiarne il valore: inserimento e scadenza costano tempo
+    costante ammortizzato, qualunque sia il numero di elementi in attesa.
+    Una maschera di bit per livello tiene traccia delle posizioni non vuote,
+    così l'avanzamento salta le posizioni vuote invece di visitare
+    ogni tick.
+    La memoria dei nodi rimossi viene conservata in un pool interno
+    (fino a POOL_CAPACITY nodi) e riutilizzata dai successivi inserimenti.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam Clock orologio delle scadenze (default std::chrono::steady_clock)
+*/
+template <typename T, typename E, typename Clock = std::chrono::steady_clock>
+class delay_queue {
+
+public:
+
+    // Tipi pubblici della coda
+
+    typedef typename Clock::time_point time_point; ///< @brief Istante
+                                                   ///< dell'orologio
+    typedef typename Clock::duration duration; ///< @brief Intervallo di tempo
+                                               ///< dell'orologio
+
+private:
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+    typedef std::uint64_t tick_type; ///< @brief Tipo di supporto privato per
+                                     ///< rappresentare un istante in tick
+    typedef std::uint64_t mask_type; ///< @brief Tipo di supporto privato per
+                                     ///< rappresentare una parola della
+                                     ///< maschera delle posizioni non vuote
+
+    static const unsigned int SLOT_BITS = 8; ///< @brief Bit di una cifra
+    static const size_type SLOTS = 1u << SLOT_BITS; ///< @brief Posizioni
+                                                    ///< di un livello
+    static const size_type LEVELS = 64 / SLOT_BITS; ///< @brief Livelli della
+                                                    ///< ruota (coprono tutti
+                                                    ///< i tick)
+    static const size_type MASK_WORDS = SLOTS / 64; ///< @brief Parole della
+                                                    ///< maschera di un livello
+
+	/**
+		@brief Nodo della coda
+
+		@description
+	    Struttura di supporto interna privata della coda che contiene
+	    il valore di un elemento, la sua scadenza in tick e il puntatore
+	    al nodo successivo della stessa posizione della ruota
+	    (oppure della lista degli elementi pronti).
+	*/
+	struct node {
+		value_type value; ///< @brief Valore dell'elemento
+		tick_type deadline; ///< @brief Scadenza dell'elemento in tick
+		node *next; ///< @brief Puntatore al nodo successivo
+
+		/**
+			@brief Costruttore sul posto del valore
+
+			@tparam Args tipi degli argomenti del costruttore del tipo T
+
+			@param d scadenza dell'elemento in tick
+			@param args argomenti del costruttore del tipo T
+		*/
+		template <typename... Args>
+		explicit node(tick_type d, Args&&... args) :
+		    value(std::forward<Args>(args)...), deadline(d),
+		    next(nullptr) {} // initialization list
+	};
+
+	/**
+		@brief Lista FIFO di nodi
+
+		@description
+	    Struttura di supporto interna privata della coda che rappresenta
+	    una posizione della ruota o la lista degli elementi pronti:
+	    l'inserimento in fondo e la concatenazione di un'altra lista
+	    avvengono in tempo costante.
+	*/
+	struct node_list {
+		node *head; ///< @brief Primo nodo della lista
+		node *tail; ///< @brief Ultimo nodo della lista
+
+		node_list() : head(nullptr), tail(nullptr) {} // initialization list
+
+		bool empty() const {
+			return head == nullptr;
+		}
+
+		void push_back(node *n) {
+			n->next = nullptr;
+			if(head == nullptr)
+				head = n;
+			else
+				tail->next = n;
+			tail = n;
+		}
+
+		void append(node_list &other) {
+			if(other.head == nullptr)
+				return;
+			if(head == nullptr)
+				head = other.head;
+			else
+				tail->next = other.head;
+			tail = other.tail;
+			other.head = nullptr;
+			other.tail = nullptr;
+		}
+
+		node *pop_front() {
+			node *n = head;
+			head = n->next;
+			if(head == nullptr)
+				tail = nullptr;
+			return n;
+		}
+	};
+
+	/**
+		@brief Livello della ruota temporale
+	*/
+	struct level {
+		std::array<node_list, SLOTS> slots; ///< @brief Posizioni del livello
+		std::array<mask_type, MASK_WORDS> nonempty; ///< @brief Bit s a 1
+		                                            ///< se la posizione s
+		                                            ///< non è vuota
+
+		level() : nonempty() {} // initialization list
+	};
+
+	// Dati membro privati della coda
+
+	std::array<level, LEVELS> _wheel; ///< @brief Livelli della ruota
+	node_list _ready; ///< @brief Elementi scaduti, in ordine di scadenza
+	tick_type _now; ///< @brief Tick fino a cui è avanzata la ruota
+	time_point _origin; ///< @brief Istante corrispondente al tick 0
+	duration _resolution; ///< @brief Durata di un tick
+	size_type _size; ///< @brief Numero di elementi inseriti nella coda
+	size_type _ready_size; ///< @brief Numero di elementi scaduti
+	node *_pool; ///< @brief Lista dei nodi liberi del pool
+	size_type _pool_size; ///< @brief Numero di nodi liberi nel pool
+	E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+	           ///< del valore di due elementi della coda
+
+    // Funzioni private della coda
+
+    /**
+		@brief Cifra di un tick in un livello
+
+		@param t tick
+		@param l livello
+
+		@return cifra (in base SLOTS) del tick nel livello l
+	*/
+    static size_type digit(tick_type t, size_type l) {
+        return static_cast<size_type>(t >> (l * SLOT_BITS)) & (SLOTS - 1);
+    }
+
+    /**
+		@brief Posizione non vuota successiva in un livello
+
+		@param l livello
+		@param from posizione da cui iniziare la ricerca (inclusa)
+
+		@return prima posizione non vuota del livello l a partire da from,
+		        oppure SLOTS se non esiste
+	*/
+    size_type next_slot(size_type l, size_type from) const {
+        const std::array<mask_type, MASK_WORDS> &m = _wheel[l].nonempty;
+        for(size_type w = from / 64; w < MASK_WORDS; ++w) {
+            mask_type bits = m[w];
+            if(w == from / 64)
+                bits &= ~mask_type(0) << (from % 64);
+            if(bits != 0)
+                return w * 64 + static_cast<size_type>(std::countr_zero(bits));
+        }
+        return SLOTS;
+    }
+
+    /**
+		@brief Conversione di una scadenza in tick
+
+		@description
+        La scadenza viene arrotondata per eccesso al tick successivo;
+        una scadenza precedente all'istante di costruzione corrisponde
+        al tick 0.
+
+		@param deadline scadenza
+
+		@return tick della scadenza
+	*/
+    tick_type deadline_tick(time_point deadline) const {
+        if(deadline <= _origin)
+            return 0;
+        duration d = deadline - _origin;
+        return static_cast<tick_type>((d + _resolution - duration(1)) /
+                                      _resolution);
+    }
+
+    /**
+		@brief Conversione dell'istante corrente in tick
+
+		@description
+        L'istante viene arrotondato per difetto al tick precedente.
+
+		@param now istante corrente
+
+		@return tick dell'istante corrente
+	*/
+    tick_type now_tick(time_point now) const {
+        if(now <= _origin)
+            return 0;
+        return static_cast<tick_type>((now - _origin) / _resolution);
+    }
+
+    /**
+		@brief Istanziamento di un nuovo nodo
+
+		@description
+        Funzione privata che istanzia un nuovo nodo, riutilizzando la memoria
+        di un nodo libero del pool se disponibile. Nel caso in cui
+        la costruzione del valore lanci un'eccezione, la memoria viene
+        restituita al pool e l'eccezione viene propagata.
+
+		@throw eccezione di allocazione di memoria
+	*/
+    template <typename... Args>
+    node *create_node(tick_type deadline, Args&&... args) {
+        if(_pool == nullptr)
+            return new node(deadline, std::forward<Args>(args)...);
+        node *p = _pool;
+        _pool = p->next;
+        --_pool_size;
+        void *raw = p;
+        try {
+            return new(raw) node(deadline, std::forward<Args>(args)...);
+        }
+        catch(...) {
+            release_memory(static_cast<node *>(raw));
+            throw;
+        }
+    }
+
+    /**
+		@brief Rilascio della memoria di un nodo già distrutto
+
+		@param p puntatore alla memoria del nodo
+	*/
+    void release_memory(node *p) {
+        if(_pool_size < POOL_CAPACITY) {
+            p->next = _pool;
+            _pool = p;
+            ++_pool_size;
+        }
+        else
+            ::operator delete(static_cast<void *>(p));
+    }
+
+    /**
+		@brief Distruzione di un nodo
+
+		@param n puntatore al nodo da distruggere
+	*/
+    void destroy_node(node *n) {
+        n->~node();
+        release_memory(n);
+    }
+
+    /**
+		@brief Distruzione dei nodi di una lista
+
+		@param list lista da svuotare
+	*/
+    void destroy_list(node_list &list) {
+        while(!list.empty())
+            destroy_node(list.pop_front());
+    }
+
+    /**
+		@brief Collocamento di un nodo rispetto al tick corrente
+
+		@description
+        Funzione privata che inserisce un nodo nella lista degli elementi
+        pronti, se è già scaduto, altrimenti nella posizione della ruota
+        indicata dalla cifra più significativa in cui la sua scadenza
+        differisce dal tick corrente.
+
+		@param n puntatore al nodo da collocare
+	*/
+    void place(node *n) {
+        if(n->deadline <= _now) {
+            _ready.push_back(n);
+            ++_ready_size;
+            return;
+        }
+        const size_type l = static_cast<size_type>(
+            std::bit_width(n->deadline ^ _now) - 1) / SLOT_BITS;
+        const size_type s = digit(n->deadline, l);
+        _wheel[l].slots[s].push_back(n);
+        _wheel[l].nonempty[s / 64] |= mask_type(1) << (s % 64);
+    }
+
+    /**
+		@brief Avanzamento della ruota fino a un tick
+
+		@description
+        Funzione privata che avanza il tick corrente fino a t, visitando
+        in ordine solo le posizioni non vuote. In ogni livello le posizioni
+        non vuote hanno cifra maggiore di quella del tick corrente, e tutte
+        le posizioni del livello l iniziano prima di quelle del livello
+        l + 1: la prima posizione non vuota, cercata dal livello 0 in su,
+        è quindi il prossimo evento. Una posizione del livello 0 scade
+        per intero; una posizione di un livello superiore viene
+        ridistribuita rispetto al suo istante iniziale.
+
+		@param t tick fino a cui avanzare
+	*/
+    void advance(tick_type t) {
+        while(_now < t) {
+            size_type l = 0;
+            size_type s = SLOTS;
+            for(; l < LEVELS; ++l) {
+                const size_type d = digit(_now, l);
+                if(d + 1 < SLOTS && (s = next_slot(l, d + 1)) < SLOTS)
+                    break;
+            }
+            if(l == LEVELS) {
+                _now = t;
+                return;
+            }
+
+            // istante iniziale della posizione s del livello l
+            const unsigned int shift = l * SLOT_BITS;
+            const tick_type high = shift + SLOT_BITS >= 64 ? 0 :
+                (_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            const tick_type start = high | (tick_type(s) << shift);
+            if(start > t) {
+                _now = t;
+                return;
+            }
+
+            _now = start;
+            node_list slot;
+            slot.append(_wheel[l].slots[s]);
+            _wheel[l].nonempty[s / 64] &= ~(mask_type(1) << (s % 64));
+            if(l == 0) {
+                for(node *n = slot.head; n != nullptr; n = n->next)
+                    ++_ready_size;
+                _ready.append(slot);
+            }
+            else
+                while(!slot.empty())
+                    place(slot.pop_front());
+        }
+    }
+
+    /**
+		@brief Rimozione del primo elemento scaduto
+
+		@pre La lista degli elementi pronti non dev'essere vuota.
+	*/
+    void pop_ready() {
+        destroy_node(_ready.pop_front());
+        --_ready_size;
+        --_size;
+    }
+
+public:
+
+    /**
+        @brief Numero massimo di nodi liberi conservati nel pool
+    */
+    static const size_type POOL_CAPACITY = 4096;
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di default che istanzia una coda vuota con risoluzione
+	    di un millisecondo; il tick 0 corrisponde all'istante
+	    di costruzione.
+	*/
+	delay_queue() :
+	    _now(0), _origin(Clock::now()),
+	    _resolution(std::chrono::duration_cast<duration>(
+	        std::chrono::milliseconds(1))),
+	    _size(0), _ready_size(0), _pool(nullptr),
+	    _pool_size(0) {} // initialization list
+
+	// Costruttori secondari della coda
+
+	/**
+		@brief Costruttore secondario
+
+		@description
+	    Costruttore secondario che istanzia una coda vuota con la risoluzione
+	    data. Con LEVELS livelli la ruota copre tutti i 2^64 tick,
+	    qualunque sia la risoluzione.
+
+	    @note Questo costruttore è definito explicit per evitare conversioni
+	          di tipo implicite da duration a delay_queue.
+
+		@param resolution durata di un tick (almeno un'unità dell'orologio)
+	*/
+	explicit delay_queue(duration resolution) :
+	    _now(0), _origin(Clock::now()),
+	    _resolution(resolution > duration(0) ? resolution : duration(1)),
+	    _size(0), _ready_size(0), _pool(nullptr),
+	    _pool_size(0) {} // initialization list
+
+	delay_queue(const delay_queue &other) = delete;
+
+	delay_queue &operator=(const delay_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distrugge gli elementi ancora presenti e dealloca i nodi del pool.
+	*/
+	virtual ~delay_queue() {
+	    clear();
+	    while(_pool != nullptr) {
+	        node *next = _pool->next;
+	        ::operator delete(static_cast<void *>(_pool));
+	        _pool = next;
+	    }
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda, scaduti e non
+    */
+    size_type size() const {
+        return _size;
+    }
+
+    /**
+        @brief Numero di elementi scaduti
+
+        @return numero di elementi scaduti all'ultimo avanzamento della coda
+                (a opera di advance, dequeue o try_dequeue)
+    */
+    size_type ready_size() const {
+        return _ready_size;
+    }
+
+    /**
+        @brief Risoluzione della coda
+
+        @return durata di un tick
+    */
+    duration resolution() const {
+        return _resolution;
+    }
+
+    /**
+        @brief Svuotamento della coda
+
+        @description
+        Distrugge tutti gli elementi, scaduti e non, restituendone
+        la memoria al pool. Il tick corrente non cambia.
+
+        @post La coda è vuota.
+    */
+    void clear() {
+        destroy_list(_ready);
+        for(size_type l = 0; l < LEVELS; ++l)
+            for(size_type s = next_slot(l, 0); s < SLOTS;
+                s = s + 1 < SLOTS ? next_slot(l, s + 1) : SLOTS) {
+                destroy_list(_wheel[l].slots[s]);
+                _wheel[l].nonempty[s / 64] &= ~(mask_type(1) << (s % 64));
+            }
+        _size = 0;
+        _ready_size = 0;
+    }
+
+	/**
+		@brief Inserimento di un elemento con scadenza
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un elemento
+	    con la scadenza data, copiandone il valore, in tempo costante.
+	    Un elemento con scadenza già trascorsa rispetto all'ultimo
+	    avanzamento della coda è subito pronto.
+
+		@param deadline scadenza dell'elemento
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+	*/
+	void enqueue(time_point deadline, const value_type &value) {
+	    emplace(deadline, value);
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Inserisce il valore spostandolo nel nuovo elemento.
+	*/
+	void enqueue(time_point deadline, value_type &&value) {
+	    emplace(deadline, std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un elemento con ritardo
+
+		@description
+	    Inserisce un elemento che scade dopo il ritardo dato, a partire
+	    dall'istante corrente dell'orologio.
+
+		@param delay ritardo dell'elemento
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue_after(duration delay, const value_type &value) {
+	    emplace(Clock::now() + delay, value);
+	}
+
+	/**
+		@brief Inserimento di un elemento costruito sul posto
+
+	    @tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param deadline scadenza dell'elemento
+		@param args argomenti del costruttore del tipo T
+
+		@throw eccezione di allocazione di memoria o lanciata dal costruttore
+		       (la coda rimane allo stato precedente alla chiamata)
+	*/
+	template <typename... Args>
+	void emplace(time_point deadline, Args&&... args) {
+	    place(create_node(deadline_tick(deadline),
+	                      std::forward<Args>(args)...));
+	    ++_size;
+	}
+
+    /**
+        @brief Avanzamento della coda fino a un istante
+
+        @description
+        Metodo dell'interfaccia pubblica che fa scadere tutti gli elementi
+        la cui scadenza non supera l'istante dato. Il tempo della coda
+        non torna mai indietro: un istante precedente all'ultimo avanzamento
+        non ha effetto.
+
+        @param now istante corrente
+
+        @return numero di elementi scaduti
+    */
+    size_type advance(time_point now) {
+        advance(now_tick(now));
+        return _ready_size;
+    }
+
+    /**
+        @brief Rimozione del primo elemento scaduto
+
+        @description
+        Metodo dell'interfaccia pubblica che avanza la coda fino all'istante
+        corrente dell'orologio e rimuove l'elemento con la scadenza
+        più vecchia tra quelli scaduti, restituendone il valore.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se nessun elemento è scaduto
+    */
+    value_type dequeue() {
+        return dequeue(Clock::now());
+    }
+
+    /**
+        @overload dequeue
+
+        @param now istante corrente, già letto dal chiamante
+    */
+    value_type dequeue(time_point now) {
+        advance(now_tick(now));
+        if(_ready_size == 0)
+            throw empty_queue_exception("Impossibile rimuovere l'elemento: "
+                                        "nessun elemento e' scaduto.");
+        value_type removed_value(std::move(_ready.head->value));
+        pop_ready();
+        return removed_value;
+    }
+
+    /**
+        @brief Tentativo di rimozione del primo elemento scaduto
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se nessun
+                elemento è scaduto
+    */
+    bool try_dequeue(value_type &out) {
+        return try_dequeue(Clock::now(), out);
+    }
+
+    /**
+        @overload try_dequeue
+
+        @param now istante corrente, già letto dal chiamante
+        @param out valore in cui spostare il valore dell'elemento rimosso
+    */
+    bool try_dequeue(time_point now, value_type &out) {
+        advance(now_tick(now));
+        if(_ready_size == 0)
+            return false;
+        out = std::move(_ready.head->value);
+        pop_ready();
+        return true;
+    }
+
+	/**
+		@brief Verifica dell'esistenza di un elemento di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina se la coda contiene
+        un elemento del valore dato, scaduto o non, visitando solo
+        le posizioni non vuote della ruota.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+	*/
+    bool contains(const value_type &value) const {
+        for(const node *n = _ready.head; n != nullptr; n = n->next)
+            if(_equals(n->value, value))
+                return true;
+        for(size_type l = 0; l < LEVELS; ++l)
+            for(size_type s = next_slot(l, 0); s < SLOTS;
+                s = s + 1 < SLOTS ? next_slot(l, s + 1) : SLOTS)
+                for(const node *n = _wheel[l].slots[s].head; n != nullptr;
+                    n = n->next)
+                    if(_equals(n->value, value))
+                        return true;
+        return false;
+    }
+};
+
+#endif
+
+// Fine file header delay_queue.h
@@ -0,0 +1,628 @@
+/**
+	@headerfile execution.h
+
+    @brief Politiche di esecuzione e versioni parallele di transformif
+
+    @description
+	File header con le politiche di esecuzione degli algoritmi sulle code,
+    con la suddivisione di una coda in intervalli assegnati a thread
+    diversi e con le versioni di transformif che accettano una politica
+    di esecuzione o un numero di thread, per le classi queue, chunked_queue
+    e ring_queue.
+*/
+
+// Guardie del file header execution.h
+
+#ifndef EXECUTION_H
+#define EXECUTION_H
+
+// Direttive per il pre-compilatore
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t,
+                   // std::uint64_t
+#include <cstring> // std::memcpy
+#include <future> // std::async, std::future
+#include <thread> // std::thread::hardware_concurrency
+#include <type_traits> // std::remove_const, std::is_pointer,
+                       // std::is_trivially_copyable, std::is_void,
+                       // std::is_base_of
+#include <utility> // std::pair
+#include <vector> // std::vector
+#include "queue.h" // queue
+#include "chunked_queue.h" // chunked_queue
+#include "ring_queue.h" // ring_queue
+
+// Politiche di esecuzione
+
+/**
+	@brief Politiche di esecuzione degli algoritmi sulle code
+
+	@description
+    Namespace con le politiche che indicano come un algoritmo può visitare
+    gli elementi di una coda, sul modello di quelle di std::execution
+    (che in libstdc++ richiedono la libreria TBB):
+    - seq: un solo thread, un elemento alla volta, in ordine FIFO;
+    - unseq: un solo thread; se l'operatore è speculativo (vedi
+      is_speculative_op) i cicli sui tratti contigui (ring_queue,
+      chunked_queue) sono scritti senza salti condizionati, in modo che
+      il compilatore possa vettorizzarli, altrimenti il ciclo è quello
+      sequenziale;
+    - par: gli elementi vengono divisi in intervalli di dimensione simile,
+      ciascuno visitato da un thread;
+    - par_unseq: come par, con i cicli vettorizzabili di unseq.
+    Le politiche parallele indicano il numero di thread (0 significa
+    std::thread::hardware_concurrency); con pochi elementi vengono usati
+    meno thread, in modo che ognuno visiti almeno MIN_GRAIN elementi.
+*/
+namespace execution {
+
+/**
+	@brief Etichetta di operatore speculativo
+
+	@description
+    Un operatore F che deriva da speculative_op_tag dichiara che op(x)
+    si può valutare su qualsiasi valore, anche su quelli che non
+    soddisfano il predicato di transformif (non lancia eccezioni, non ha
+    effetti collaterali e non ha comportamenti indefiniti): le politiche
+    vettorizzabili possono allora calcolare op su un intero blocco
+    di elementi e scegliere poi il valore da scrivere.
+*/
+struct speculative_op_tag {};
+
+/**
+	@brief Operatore valutabile su tutti gli elementi
+
+	@description
+    Trait vero per gli operatori che derivano da speculative_op_tag.
+    Può essere specializzato per gli operatori che non si possono
+    modificare.
+
+    @tparam F tipo dell'operatore
+*/
+template <typename F>
+struct is_speculative_op : std::is_base_of<speculative_op_tag, F> {};
+
+/**
+	@brief Esecuzione sequenziale
+*/
+struct sequenced_policy {};
+
+/**
+	@brief Esecuzione sequenziale vettorizzabile
+*/
+struct unsequenced_policy {};
+
+/**
+	@brief Esecuzione parallela
+*/
+struct parallel_policy {
+    unsigned int threads; ///< @brief Numero di thread (0: tutti i core)
+
+    /**
+		@brief Costruttore
+
+		@param t numero di thread (0: std::thread::hardware_concurrency)
+	*/
+    explicit constexpr parallel_policy(unsigned int t = 0) :
+        threads(t) {} // initialization list
+};
+
+/**
+	@brief Esecuzione parallela vettorizzabile
+*/
+struct parallel_unsequenced_policy {
+    unsigned int threads; ///< @brief Numero di thread (0: tutti i core)
+
+    /**
+		@brief Costruttore
+
+		@param t numero di thread (0: std::thread::hardware_concurrency)
+	*/
+    explicit constexpr parallel_unsequenced_policy(unsigned int t = 0) :
+        threads(t) {} // initialization list
+};
+
+inline constexpr sequenced_policy seq{}; ///< @brief Politica sequenziale
+inline constexpr unsequenced_policy unseq{}; ///< @brief Politica
+                                             ///< vettorizzabile
+inline constexpr parallel_policy par{}; ///< @brief Politica parallela
+                                        ///< su tutti i core
+inline constexpr parallel_unsequenced_policy par_unseq{}; ///< @brief Politica
+                                                          ///< parallela
+                                                          ///< vettorizzabile
+
+/**
+	@brief Politica di esecuzione
+
+	@description
+    Trait vero per i tipi delle politiche di esecuzione.
+*/
+template <typename P>
+struct is_execution_policy : std::false_type {};
+
+template <typename P>
+struct is_execution_policy<const P> : is_execution_policy<P> {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<unsequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+/**
+	@brief Politica di esecuzione parallela
+
+	@description
+    Trait vero per parallel_policy e parallel_unsequenced_policy, che hanno
+    il dato membro threads.
+*/
+template <typename P>
+struct is_parallel_policy : std::false_type {};
+
+template <>
+struct is_parallel_policy<parallel_policy> : std::true_type {};
+
+template <>
+struct is_parallel_policy<parallel_unsequenced_policy> : std::true_type {};
+
+/**
+	@brief Numero minimo di elementi assegnati a un thread
+*/
+inline constexpr std::size_t MIN_GRAIN = 4096;
+
+/**
+	@brief Supporto interno degli algoritmi paralleli
+*/
+namespace detail {
+
+/**
+	@brief Memoria contigua di una coda
+
+	@description
+    Trait vero per le code che espongono i propri elementi come tratti
+    di memoria contigua tramite for_each_span.
+*/
+template <typename C>
+struct is_contiguous : std::false_type {};
+
+template <typename T, typename E, unsigned int N>
+struct is_contiguous<chunked_queue<T, E, N> > : std::true_type {};
+
+template <typename T, typename E>
+struct is_contiguous<ring_queue<T, E> > : std::true_type {};
+
+/**
+	@brief Numero di thread da utilizzare
+
+	@param threads numero di thread richiesto (0: tutti i core)
+	@param n numero di elementi da visitare
+
+	@return numero di thread, tra 1 e threads, tale che ognuno visiti
+	        almeno MIN_GRAIN elementi
+*/
+inline unsigned int worker_count(unsigned int threads, std::size_t n) {
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+    std::size_t by_grain = n / MIN_GRAIN;
+    if(by_grain < threads)
+        threads = static_cast<unsigned int>(by_grain);
+    return threads == 0 ? 1 : threads;
+}
+
+/**
+	@brief Esecuzione di una funzione su più thread
+
+	@description
+    Chiama f(w) per ogni w da 0 a k - 1: f(0) sul thread chiamante,
+    le altre su thread avviati con std::async. Attende la fine di tutte
+    le chiamate; un'eccezione lanciata da una di esse viene propagata
+    al chiamante.
+
+	@param k numero di thread
+	@param f funzione da chiamare con l'indice del thread
+*/
+template <typename F>
+void run_workers(unsigned int k, F &f) {
+    std::vector<std::future<void> > workers;
+    workers.reserve(k - 1);
+    for(unsigned int w = 1; w < k; ++w)
+        workers.push_back(std::async(std::launch::async, [&f, w]() {
+            f(w);
+        }));
+    f(0);
+    for(std::future<void> &worker : workers)
+        worker.get();
+}
+
+/**
+	@brief Visita di una coda divisa in k intervalli
+
+	@description
+    Divide gli elementi della coda in k intervalli consecutivi di dimensione
+    simile e chiama body(w, offset, first, last) per gli elementi assegnati
+    al thread w, su k thread; offset è la posizione FIFO dell'elemento
+    puntato da first (0 è la testa della coda).
+    Per le code con memoria contigua, first e last sono puntatori e body
+    può essere chiamata più volte per lo stesso w (una per ogni tratto
+    contiguo dell'intervallo), in ordine FIFO; i tratti vengono raccolti
+    con for_each_span e ogni thread cerca l'inizio del proprio intervallo.
+    Per queue, first e last sono iteratori e body viene chiamata una volta
+    per thread; gli iteratori di confine vengono trovati con un'unica
+    scansione della lista.
+
+	@pre La coda non dev'essere modificata da altri thread durante
+	     la visita.
+
+	@param q coda da visitare (eventualmente costante)
+	@param k numero di thread
+	@param body funzione da chiamare sugli intervalli
+*/
+template <typename C, typename Body>
+void for_each_piece(C &q, unsigned int k, Body body) {
+    const std::size_t n = q.size();
+
+    if constexpr(is_contiguous<typename std::remove_const<C>::type>::value) {
+        typedef decltype(&*q.begin()) pointer;
+        std::vector<std::pair<pointer, std::size_t> > spans;
+        q.for_each_span([&spans](pointer p, std::size_t len) {
+            spans.push_back(std::make_pair(p, len));
+        });
+
+        auto work = [&](unsigned int w) {
+            std::size_t lo = n * w / k, hi = n * (w + 1) / k;
+            std::size_t offset = 0;
+            for(std::size_t s = 0; s < spans.size() && offset < hi; ++s) {
+                std::size_t begin = offset, end = offset + spans[s].second;
+                offset = end;
+                if(end <= lo)
+                    continue;
+                pointer p = spans[s].first;
+                std::size_t from = (begin < lo) ? lo : begin;
+                body(w, from, p + (from - begin),
+                     p + ((end > hi ? hi : end) - begin));
+            }
+        };
+        run_workers(k, work);
+    }
+    else {
+        typedef decltype(q.begin()) iterator;
+        std::vector<iterator> bounds;
+        bounds.reserve(k + 1);
+        iterator i = q.begin();
+        std::size_t position = 0;
+        for(unsigned int w = 0; w < k; ++w) {
+            for(std::size_t target = n * w / k; position < target; ++position)
+                ++i;
+            bounds.push_back(i);
+        }
+        bounds.push_back(q.end());
+
+        auto work = [&](unsigned int w) {
+            body(w, n * w / k, bounds[w], bounds[w + 1]);
+        };
+        run_workers(k, work);
+    }
+}
+
+/**
+	@brief Parola intera della stessa dimensione di un tipo
+
+	@description
+    Tipo intero senza segno usato per selezionare un valore tra due
+    con operazioni bit a bit; void se nessun intero ha la dimensione S.
+*/
+template <std::size_t S>
+struct blend_word { typedef void type; };
+
+template <>
+struct blend_word<1> { typedef std::uint8_t type; };
+
+template <>
+struct blend_word<2> { typedef std::uint16_t type; };
+
+template <>
+struct blend_word<4> { typedef std::uint32_t type; };
+
+template <>
+struct blend_word<8> { typedef std::uint64_t type; };
+
+/**
+	@brief Numero di elementi di un blocco del ciclo vettorizzabile
+
+	@description
+    Con -O2 GCC vettorizza solo i cicli il cui numero di iterazioni
+    è noto e multiplo della larghezza dei vettori: il tratto viene quindi
+    trasformato a blocchi di BLOCK elementi, più un blocco finale.
+*/
+inline constexpr std::size_t BLOCK = 64;
+
+/**
+	@brief Trasformazione senza salti condizionati di un blocco contiguo
+
+	@description
+    Ogni elemento viene riscritto con op(x) oppure con x stesso, scelto
+    con una maschera di bit ricavata da pred(x): senza la selezione
+    bit a bit, per i float GCC non elimina il salto condizionato
+    (i confronti possono sollevare eccezioni di virgola mobile).
+    op viene valutato su tutti gli elementi e deve quindi essere
+    speculativo.
+*/
+template <typename T, typename P, typename F>
+inline void transform_block(T *p, std::size_t n, P &pred, F &op) {
+    typedef typename blend_word<sizeof(T)>::type word;
+    for(std::size_t i = 0; i < n; ++i) {
+        const T x = p[i];
+        const T y = op(x);
+        const bool selected = pred(x);
+        if constexpr(std::is_void<word>::value)
+            p[i] = selected ? y : x;
+        else {
+            word wx, wy;
+            std::memcpy(&wx, &x, sizeof(T));
+            std::memcpy(&wy, &y, sizeof(T));
+            const word mask = word(0) - static_cast<word>(selected);
+            const word r = static_cast<word>((wx & ~mask) | (wy & mask));
+            std::memcpy(p + i, &r, sizeof(T));
+        }
+    }
+}
+
+/**
+	@brief Trasformazione di un intervallo di elementi
+
+	@description
+    Applica op agli elementi dell'intervallo che soddisfano pred.
+    Se Unsequenced è vero, l'intervallo è contiguo (puntatori), il tipo
+    degli elementi è banalmente copiabile e op è speculativo, gli elementi
+    vengono trasformati a blocchi con transform_block, senza salti
+    condizionati; in tutti gli altri casi il ciclo è quello sequenziale
+    e op viene valutato solo sugli elementi che soddisfano pred.
+
+	@param first inizio dell'intervallo
+	@param last fine dell'intervallo
+	@param pred predicato
+	@param op operatore
+*/
+template <bool Unsequenced, typename It, typename P, typename F>
+void transform_range(It first, It last, P &pred, F &op) {
+    typedef typename std::remove_reference<decltype(*first)>::type value_type;
+    if constexpr(Unsequenced && std::is_pointer<It>::value &&
+                 std::is_trivially_copyable<value_type>::value &&
+                 is_speculative_op<F>::value) {
+        // copie locali: le scritture sugli elementi non possono modificarle
+        P local_pred(pred);
+        F local_op(op);
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        std::size_t i = 0;
+        for(; i + BLOCK <= n; i += BLOCK)
+            transform_block(first + i, BLOCK, local_pred, local_op);
+        transform_block(first + i, n - i, local_pred, local_op);
+    }
+    else {
+        for(; first != last; ++first)
+            if(pred(*first))
+                *first = op(*first);
+    }
+}
+
+/**
+	@brief Versione parallela di transformif per una coda qualsiasi
+
+	@param q coda di cui modificare i valori
+	@param threads numero di thread richiesto (0: tutti i core)
+	@param pred predicato, chiamato in concorrenza da più thread
+	@param op operatore, chiamato in concorrenza da più thread
+*/
+template <bool Unsequenced, typename C, typename P, typename F>
+void parallel_transformif(C &q, unsigned int threads, P pred, F op) {
+    const unsigned int k = worker_count(threads, q.size());
+    for_each_piece(q, k, [&pred, &op](unsigned int, std::size_t, auto first,
+                                      auto last) {
+        P local_pred(pred);
+        F local_op(op);
+        transform_range<Unsequenced>(first, last, local_pred, local_op);
+    });
+}
+
+/**
+	@brief Versione sequenziale vettorizzabile di transformif
+
+	@param q coda di cui modificare i valori
+	@param pred predicato
+	@param op operatore
+*/
+template <typename C, typename P, typename F>
+void unsequenced_transformif(C &q, P pred, F op) {
+    if constexpr(is_contiguous<C>::value)
+        q.for_each_span([&pred, &op](auto p, std::size_t n) {
+            transform_range<true>(p, p + n, pred, op);
+        });
+    else
+        transform_range<false>(q.begin(), q.end(), pred, op);
+}
+
+} // namespace detail
+
+} // namespace execution
+
+// Funzioni globali
+
+/**
+	@brief Trasformazione dei valori che soddisfano un predicato, con una
+	       politica di esecuzione
+
+    @description
+	Versioni della funzione globale transformif che accettano, come secondo
+    parametro, una politica di esecuzione (execution::seq, execution::unseq,
+    execution::par, execution::par_unseq) oppure il numero di thread
+    (equivalente a execution::parallel_policy(threads)).
+    Con le politiche parallele la coda viene divisa in intervalli
+    consecutivi di dimensione simile, ciascuno trasformato da un thread:
+    per chunked_queue e ring_queue gli intervalli sono tratti di memoria
+    contigua, mentre per queue i confini vengono trovati con una scansione
+    preliminare della lista, che resta sequenziale.
+    Ogni thread utilizza una propria copia di pred e op, che devono poter
+    essere chiamati in concorrenza e non devono dipendere dall'ordine
+    di visita.
+    Con le politiche vettorizzabili, se op è speculativo (deriva da
+    execution::speculative_op_tag) i tratti contigui di elementi
+    banalmente copiabili vengono trasformati senza salti condizionati,
+    valutando op anche sui valori che non soddisfano pred (il risultato
+    viene scartato); per gli altri operatori, per queue e per gli altri
+    tipi la trasformazione è quella sequenziale e op viene valutato solo
+    sui valori che soddisfano pred.
+
+    @tparam Q tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam P tipo del predicato
+    @tparam F tipo dell'operatore generico
+
+	@param q coda di cui modificare i valori contenuti
+	@param policy politica di esecuzione
+	@param pred predicato che i valori devono soddisfare per essere modificati
+    @param op operatore generico con cui modificare i valori
+
+    @throw eccezione di creazione dei thread, oppure lanciata da pred o op
+           (gli elementi già trasformati restano trasformati)
+*/
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q, execution::sequenced_policy, P pred,
+                 F op) {
+    transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q, execution::unsequenced_policy, P pred,
+                 F op) {
+    execution::detail::unsequenced_transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q, execution::parallel_policy policy, P pred,
+                 F op) {
+    execution::detail::parallel_transformif<false>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q,
+                 execution::parallel_unsequenced_policy policy, P pred, F op) {
+    execution::detail::parallel_transformif<true>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q, unsigned int threads, P pred, F op) {
+    execution::detail::parallel_transformif<false>(q, threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q, execution::sequenced_policy,
+                 P pred, F op) {
+    transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q, execution::unsequenced_policy,
+                 P pred, F op) {
+    execution::detail::unsequenced_transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q,
+                 execution::parallel_policy policy, P pred, F op) {
+    execution::detail::parallel_transformif<false>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q,
+                 execution::parallel_unsequenced_policy policy, P pred, F op) {
+    execution::detail::parallel_transformif<true>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, unsigned int N, typename P, typename F>
+void transformif(chunked_queue<Q, E, N> &q, unsigned int threads, P pred,
+                 F op) {
+    execution::detail::parallel_transformif<false>(q, threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q, execution::sequenced_policy, P pred,
+                 F op) {
+    transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q, execution::unsequenced_policy, P pred,
+                 F op) {
+    execution::detail::unsequenced_transformif(q, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q, execution::parallel_policy policy,
+                 P pred, F op) {
+    execution::detail::parallel_transformif<false>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q,
+                 execution::parallel_unsequenced_policy policy, P pred, F op) {
+    execution::detail::parallel_transformif<true>(q, policy.threads, pred, op);
+}
+
+/**
+	@overload transformif
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q, unsigned int threads, P pred, F op) {
+    execution::detail::parallel_transformif<false>(q, threads, pred, op);
+}
+
+#endif
+
+// Fine file header execution.h
@@ -0,0 +1,403 @@
+/**
+	@headerfile executor.h
+
+    @brief Dichiarazione e definizione della classe executor
+
+    @description
+	File header con dichiarazione e definizione della classe executor,
+    un pool di thread che esegue task indipendenti, bilanciando il carico
+    tra i thread tramite work stealing.
+*/
+
+// Guardie del file header executor.h
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <exception> // std::exception_ptr, std::current_exception,
+                     // std::rethrow_exception
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::unique_lock, std::lock_guard
+#include <thread> // std::thread, std::this_thread::yield
+#include <utility> // std::forward
+#include <vector> // std::vector
+#include "queue.h" // queue
+#include "work_stealing_deque.h" // work_stealing_deque
+
+// Dichiarazione e definizione della classe executor
+
+/**
+	@brief Pool di thread con work stealing
+
+	@description
+    Classe che implementa un pool di thread che eseguono i task sottomessi
+    con submit. Ogni thread possiede una work_stealing_deque:
+    un task sottomesso da un thread del pool (tipicamente un task che
+    genera sotto-task, come nel fork/join) viene inserito nella coda
+    del thread stesso, senza lock; un task sottomesso da un thread esterno
+    viene inserito in una queue condivisa, protetta da un mutex.
+    Ogni thread esegue prima i task della propria coda, dal più recente,
+    poi quelli della coda condivisa e infine sottrae i task più vecchi
+    dalle code degli altri thread, a partire da una vittima casuale.
+    I thread senza lavoro, dopo alcuni tentativi, si sospendono su una
+    variabile condizione, senza consumare CPU, e vengono risvegliati
+    solo se un task viene sottomesso mentre sono sospesi.
+    wait_all attende il completamento di tutti i task sottomessi,
+    compresi quelli sottomessi dai task stessi.
+
+    @note Il pool non è copiabile né assegnabile.
+*/
+class executor {
+
+public:
+
+    typedef std::function<void()> task_type; ///< @brief Tipo dei task
+
+	typedef unsigned int size_type; ///< @brief Tipo per rappresentare
+                                    ///< il numero di task e di thread
+
+private:
+
+    /**
+        @brief Funtore per l'uguaglianza tra puntatori a task
+    */
+    struct equal_task {
+        bool operator()(const task_type *t1, const task_type *t2) const {
+            return t1 == t2;
+        }
+    };
+
+    /**
+        @brief Thread del pool con la propria coda di task
+    */
+    struct worker {
+        work_stealing_deque<task_type *> tasks; ///< @brief Coda dei task
+        std::thread thread; ///< @brief Thread del pool
+        unsigned int seed; ///< @brief Stato del generatore delle vittime
+    };
+
+    /**
+        @brief Numero di tentativi di ricerca di un task prima di sospendere
+               un thread senza lavoro
+    */
+    static const unsigned int SPIN_ROUNDS = 16;
+
+	// Dati membro privati del pool
+
+    std::vector<std::unique_ptr<worker>> _workers; ///< @brief Thread del pool
+
+    std::mutex _injection_mutex; ///< @brief Mutex della coda condivisa
+    queue<task_type *, equal_task> _injection; ///< @brief Coda dei task
+                                               ///< sottomessi da thread esterni
+    std::atomic<size_type> _injected; ///< @brief Numero di task nella coda
+                                      ///< condivisa
+
+    std::atomic<size_type> _queued; ///< @brief Numero di task sottomessi
+                                    ///< e non ancora prelevati da un thread
+    std::atomic<size_type> _pending; ///< @brief Numero di task sottomessi
+                                     ///< e non ancora completati
+    std::atomic<size_type> _sleeping; ///< @brief Numero di thread sospesi
+
+    std::mutex _idle_mutex; ///< @brief Mutex delle variabili condizione
+    std::condition_variable _idle; ///< @brief Attesa di nuovi task
+    std::condition_variable _done; ///< @brief Attesa del completamento
+                                   ///< di tutti i task
+    bool _stop; ///< @brief Richiesta di terminazione dei thread
+    std::exception_ptr _error; ///< @brief Prima eccezione lanciata da un task
+
+    // Identità del thread corrente, se appartiene a un pool
+    static inline thread_local executor *_current = nullptr;
+    static inline thread_local size_type _current_index = 0;
+
+    // Funzioni private del pool
+
+    /**
+		@brief Ricerca di un task da eseguire
+
+		@description
+        Funzione privata che preleva un task dalla coda del thread index,
+        altrimenti dalla coda condivisa, altrimenti dalle code degli altri
+        thread, a partire da una vittima scelta a caso.
+
+        @param index indice del thread chiamante
+        @param out puntatore in cui copiare il task prelevato
+
+        @return true se è stato prelevato un task
+	*/
+    bool find_task(size_type index, task_type *&out) {
+        worker &self = *_workers[index];
+        if(self.tasks.pop(out))
+            return taken();
+
+        if(_injected.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(_injection_mutex);
+            if(_injection.try_dequeue(out)) {
+                _injected.fetch_sub(1, std::memory_order_relaxed);
+                return taken();
+            }
+        }
+
+        const size_type n = static_cast<size_type>(_workers.size());
+        // generatore xorshift: la vittima iniziale varia ad ogni ricerca
+        self.seed ^= self.seed << 13;
+        self.seed ^= self.seed >> 17;
+        self.seed ^= self.seed << 5;
+        const size_type start = self.seed % n;
+        for(size_type i = 0; i < n; ++i) {
+            const size_type victim = (start + i) % n;
+            if(victim != index && _workers[victim]->tasks.steal(out))
+                return taken();
+        }
+        return false;
+    }
+
+    /**
+		@brief Registrazione del prelievo di un task
+
+        @return true
+	*/
+    bool taken() {
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+		@brief Esecuzione e deallocazione di un task
+
+		@description
+        Funzione privata che esegue il task, memorizzando la prima
+        eccezione lanciata da un task, e notifica wait_all (e i thread
+        sospesi, se il pool è in terminazione) quando non ci sono più
+        task da completare.
+
+        @param task task da eseguire
+	*/
+    void run(task_type *task) {
+        try {
+            (*task)();
+        }
+        catch(...) {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            if(!_error)
+                _error = std::current_exception();
+        }
+        delete task;
+
+        if(_pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _done.notify_all();
+            if(_stop)
+                _idle.notify_all();
+        }
+    }
+
+    /**
+		@brief Ciclo di esecuzione di un thread del pool
+
+		@description
+        Funzione privata eseguita da ogni thread del pool: esegue i task
+        finché ce ne sono, poi si sospende finché non viene sottomesso
+        un nuovo task. Termina quando è stata richiesta la terminazione
+        e tutti i task sono stati completati.
+
+        @param index indice del thread
+	*/
+    void work(size_type index) {
+        _current = this;
+        _current_index = index;
+        task_type *task;
+        size_type rounds = 0;
+
+        while(true) {
+            if(find_task(index, task)) {
+                run(task);
+                rounds = 0;
+                continue;
+            }
+            if(++rounds < SPIN_ROUNDS) {
+                std::this_thread::yield();
+                continue;
+            }
+            rounds = 0;
+
+            std::unique_lock<std::mutex> lock(_idle_mutex);
+            // l'incremento di _sleeping precede la lettura di _queued,
+            // submit incrementa _queued prima di leggere _sleeping:
+            // almeno uno dei due thread vede l'altro
+            _sleeping.fetch_add(1);
+            _idle.wait(lock, [this]() {
+                return _queued.load() > 0 || (_stop && _pending.load() == 0);
+            });
+            _sleeping.fetch_sub(1);
+            if(_stop && _pending.load() == 0)
+                return;
+        }
+    }
+
+    /**
+		@brief Terminazione dei thread del pool
+
+		@description
+        Funzione privata che richiede la terminazione dei thread e ne attende
+        la fine, dopo il completamento di tutti i task sottomessi.
+	*/
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _stop = true;
+        }
+        _idle.notify_all();
+        for(std::unique_ptr<worker> &w : _workers)
+            if(w->thread.joinable())
+                w->thread.join();
+    }
+
+public:
+
+    // Interfaccia pubblica del pool
+
+	// Metodi fondamentali del pool
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che avvia i thread del pool.
+
+		@param threads numero di thread del pool (almeno 1); per default,
+		       il numero di CPU disponibili
+
+		@throw eccezione di allocazione di memoria o di creazione dei thread
+		       (i thread già avviati vengono terminati)
+	*/
+	explicit executor(size_type threads = std::thread::hardware_concurrency()) :
+	    _injected(0), _queued(0), _pending(0), _sleeping(0),
+	    _stop(false) { // initialization list
+
+	    if(threads == 0)
+	        threads = 1;
+	    try {
+	        for(size_type i = 0; i < threads; ++i) {
+	            _workers.push_back(std::unique_ptr<worker>(new worker()));
+	            _workers.back()->seed = 2463534242u + i;
+	        }
+	        for(size_type i = 0; i < threads; ++i)
+	            _workers[i]->thread = std::thread(&executor::work, this, i);
+	    }
+	    catch(...) {
+	        shutdown();
+	        throw;
+	    }
+	}
+
+	executor(const executor &other) = delete;
+
+	executor &operator=(const executor &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore del pool, che attende il completamento di tutti i task
+	    sottomessi e la terminazione dei thread. Un'eventuale eccezione
+	    lanciata da un task e non ancora riportata da wait_all viene
+	    ignorata.
+
+	    @pre Non viene chiamato da un task del pool.
+	*/
+	virtual ~executor() {
+	    shutdown();
+	}
+
+	// Fine metodi fondamentali del pool
+
+	// Ulteriori metodi dell'interfaccia pubblica del pool
+
+    /**
+        @brief Numero di thread del pool
+
+        @return numero di thread del pool
+    */
+    size_type thread_count() const {
+        return static_cast<size_type>(_workers.size());
+    }
+
+	/**
+		@brief Sottomissione di un task
+
+		@description
+	    Metodo dell'interfaccia pubblica che sottomette un task al pool.
+	    Se chiamato da un task del pool, il task viene inserito, senza lock,
+	    nella coda del thread che lo esegue, altrimenti nella coda condivisa.
+	    Se almeno un thread è sospeso, ne viene risvegliato uno.
+
+	    @tparam F tipo del task, un oggetto chiamabile senza argomenti
+
+		@param f task da eseguire
+
+		@throw eccezione di allocazione di memoria (il task non viene
+		       sottomesso)
+	*/
+	template <typename F>
+	void submit(F &&f) {
+	    std::unique_ptr<task_type> task(new task_type(std::forward<F>(f)));
+	    _pending.fetch_add(1);
+	    // _queued viene incrementato prima di rendere visibile il task:
+	    // chi lo preleva lo decrementa, e non deve poterlo fare prima
+	    _queued.fetch_add(1);
+	    try {
+	        if(_current == this)
+	            _workers[_current_index]->tasks.push(task.get());
+	        else {
+	            std::lock_guard<std::mutex> lock(_injection_mutex);
+	            _injection.enqueue(task.get());
+	            _injected.fetch_add(1, std::memory_order_relaxed);
+	        }
+	    }
+	    catch(...) {
+	        _queued.fetch_sub(1);
+	        _pending.fetch_sub(1);
+	        throw;
+	    }
+	    task.release();
+
+	    if(_sleeping.load() > 0) {
+	        // il mutex garantisce che il thread che si sta sospendendo
+	        // sia già in attesa sulla variabile condizione
+	        { std::lock_guard<std::mutex> lock(_idle_mutex); }
+	        _idle.notify_one();
+	    }
+	}
+
+	/**
+		@brief Attesa del completamento di tutti i task
+
+		@description
+	    Metodo dell'interfaccia pubblica che sospende il thread chiamante
+	    finché tutti i task sottomessi, compresi quelli sottomessi dai task
+	    durante l'attesa, non sono stati completati.
+
+		@throw la prima eccezione lanciata da un task dall'ultima chiamata
+		       di wait_all
+
+	    @pre Non viene chiamato da un task del pool.
+	*/
+	void wait_all() {
+	    std::unique_lock<std::mutex> lock(_idle_mutex);
+	    _done.wait(lock, [this]() { return _pending.load() == 0; });
+	    if(_error) {
+	        std::exception_ptr error = _error;
+	        _error = nullptr;
+	        std::rethrow_exception(error);
+	    }
+	}
+};
+
+#endif
+
+// Fine file header executor.h
@@ -0,0 +1,397 @@
+/**
+	@headerfile flat_combining_queue.h
+
+    @brief Dichiarazione e definizione della classe flat_combining_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    flat_combining_queue, una coda condivisa tra thread in cui le richieste
+    di inserimento e rimozione dei thread vengono applicate a blocchi
+    da un unico thread combinatore (flat combining).
+*/
+
+// Guardie del file header flat_combining_queue.h
+
+#ifndef FLAT_COMBINING_QUEUE_H
+#define FLAT_COMBINING_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed,
+                  // std::memory_order_acquire, std::memory_order_release
+#include <cstddef> // std::size_t
+#include <exception> // std::exception_ptr, std::current_exception,
+                     // std::rethrow_exception
+#include <memory> // std::unique_ptr
+#include <optional> // std::optional
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move, std::forward
+#include "queue.h" // queue
+#include "queue_exceptions.h" // empty_queue_exception
+
+// Dichiarazione e definizione della classe template flat_combining_queue
+
+/**
+	@brief Coda FIFO con flat combining
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    condivisa tra un numero qualsiasi di thread, come involucro di una queue.
+    Ogni operazione viene pubblicata come richiesta in una posizione
+    di un array di richieste, ciascuna su una propria linea di cache;
+    il thread che riesce ad acquisire il ruolo di combinatore scorre
+    l'array e applica alla queue, uno dopo l'altro, tutti gli inserimenti
+    e le rimozioni pubblicati, mentre gli altri thread attendono
+    sulla propria posizione che la richiesta venga completata.
+    La queue è così modificata da un solo thread alla volta, senza
+    che la sua testa e la sua coda migrino tra le cache dei thread
+    ad ogni operazione, e il combinatore acquisisce il ruolo una volta
+    per un intero blocco di richieste.
+    Ogni thread occupa una posizione solo per la durata dell'operazione,
+    partendo da una posizione preferita stabile: il numero di posizioni
+    limita i thread che pubblicano contemporaneamente senza attese,
+    non il numero totale di thread.
+
+    @note La coda non è copiabile né assegnabile: è pensata per essere
+          condivisa, per riferimento, tra i thread.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class flat_combining_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+    /**
+        @brief Dimensione presunta di una linea di cache, in byte
+    */
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+        @brief Numero massimo di passate del combinatore sull'array
+               delle richieste
+    */
+    static const unsigned int COMBINING_PASSES = 3;
+
+    /**
+        @brief Stato di una richiesta
+    */
+    enum request_state {
+        idle, ///< @brief Nessuna richiesta pubblicata
+        enqueue_request, ///< @brief Inserimento pubblicato
+        dequeue_request, ///< @brief Rimozione pubblicata
+        completed ///< @brief Richiesta completata dal combinatore
+    };
+
+    /**
+        @brief Posizione dell'array delle richieste
+    */
+    struct alignas(CACHE_LINE) slot {
+        std::atomic<bool> owned; ///< @brief Posizione occupata da un thread
+        std::atomic<int> state; ///< @brief Stato della richiesta
+        std::optional<value_type> value; ///< @brief Valore da inserire
+                                         ///< o valore rimosso
+        std::exception_ptr error; ///< @brief Eccezione lanciata dalla queue
+
+        slot() : owned(false), state(idle) {} // initialization list
+    };
+
+    /**
+        @brief Occupazione di una posizione per la durata di un'operazione
+
+        @description
+        Al termine dell'operazione, anche in caso di eccezione, la posizione
+        viene svuotata e rilasciata.
+    */
+    struct slot_guard {
+        slot &s; ///< @brief Posizione occupata
+
+        explicit slot_guard(flat_combining_queue &q) :
+            s(q.acquire_slot()) {} // initialization list
+
+        slot_guard(const slot_guard &other) = delete;
+
+        slot_guard &operator=(const slot_guard &other) = delete;
+
+        ~slot_guard() {
+            s.value.reset();
+            s.error = nullptr;
+            s.owned.store(false, std::memory_order_release);
+        }
+    };
+
+	// Dati membro privati della coda
+
+    std::unique_ptr<slot[]> _slots; ///< @brief Array delle richieste
+    size_type _slot_count; ///< @brief Numero di posizioni dell'array
+
+    alignas(CACHE_LINE) std::atomic<bool> _combining; ///< @brief Ruolo di
+                                                      ///< combinatore
+                                                      ///< acquisito
+    queue<value_type, E> _queue; ///< @brief Coda modificata dal combinatore
+    std::atomic<size_type> _size; ///< @brief Numero di elementi
+
+    // Funzioni private della coda
+
+    /**
+		@brief Identificativo del thread corrente
+
+		@description
+        Funzione privata che assegna a ogni thread, alla prima chiamata,
+        un numero progressivo, usato per scegliere la posizione preferita
+        nell'array delle richieste.
+	*/
+    static size_type thread_ticket() {
+        static std::atomic<size_type> next_ticket(0);
+        static thread_local size_type ticket =
+            next_ticket.fetch_add(1, std::memory_order_relaxed);
+        return ticket;
+    }
+
+    /**
+		@brief Occupazione di una posizione dell'array delle richieste
+
+		@description
+        Funzione privata che occupa la prima posizione libera a partire
+        da quella preferita dal thread chiamante.
+
+        @return posizione occupata
+	*/
+    slot &acquire_slot() {
+        size_type i = thread_ticket() % _slot_count;
+        while(true) {
+            slot &s = _slots[i];
+            if(!s.owned.load(std::memory_order_relaxed) &&
+               !s.owned.exchange(true, std::memory_order_acquire))
+                return s;
+            if(++i == _slot_count) {
+                i = 0;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+		@brief Applicazione di una richiesta pubblicata alla queue
+
+		@description
+        Funzione privata, eseguita dal combinatore, che esegue la richiesta
+        e ne pubblica il completamento. Un'eccezione lanciata dalla queue
+        viene consegnata al thread che ha pubblicato la richiesta.
+
+        @param s posizione della richiesta
+        @param request stato della richiesta pubblicata
+	*/
+    void apply(slot &s, int request) {
+        try {
+            if(request == enqueue_request) {
+                _queue.enqueue(std::move(*s.value));
+                s.value.reset();
+                _size.store(_queue.size(), std::memory_order_relaxed);
+            }
+            else if(_queue.size() > 0) {
+                s.value.emplace(_queue.dequeue());
+                _size.store(_queue.size(), std::memory_order_relaxed);
+            }
+        }
+        catch(...) {
+            s.error = std::current_exception();
+        }
+        s.state.store(completed, std::memory_order_release);
+    }
+
+    /**
+		@brief Combinazione delle richieste pubblicate
+
+		@description
+        Funzione privata, eseguita dal thread che ha acquisito il ruolo
+        di combinatore, che scorre l'array delle richieste applicando
+        quelle pubblicate, finché una passata non ne trova alcuna
+        (al più COMBINING_PASSES passate).
+	*/
+    void combine() {
+        for(unsigned int pass = 0; pass < COMBINING_PASSES; ++pass) {
+            bool applied = false;
+            for(size_type i = 0; i < _slot_count; ++i) {
+                slot &s = _slots[i];
+                int request = s.state.load(std::memory_order_acquire);
+                if(request == enqueue_request || request == dequeue_request) {
+                    apply(s, request);
+                    applied = true;
+                }
+            }
+            if(!applied)
+                break;
+        }
+    }
+
+    /**
+		@brief Pubblicazione di una richiesta e attesa del suo completamento
+
+		@description
+        Funzione privata che pubblica la richiesta nella posizione
+        e attende che sia completata, eseguendo la combinazione
+        se il ruolo di combinatore è libero.
+
+        @param s posizione occupata dal thread chiamante
+        @param request richiesta da pubblicare
+
+        @throw eccezione lanciata dalla queue durante l'esecuzione
+               della richiesta
+	*/
+    void publish(slot &s, request_state request) {
+        s.state.store(request, std::memory_order_release);
+        while(s.state.load(std::memory_order_acquire) != completed) {
+            if(!_combining.load(std::memory_order_relaxed) &&
+               !_combining.exchange(true, std::memory_order_acquire)) {
+                combine();
+                _combining.store(false, std::memory_order_release);
+            }
+            else
+                std::this_thread::yield();
+        }
+        s.state.store(idle, std::memory_order_relaxed);
+        if(s.error)
+            std::rethrow_exception(s.error);
+    }
+
+    /**
+		@brief Inserimento tramite una richiesta
+	*/
+    template <typename V>
+    void push(V &&value) {
+        slot_guard guard(*this);
+        guard.s.value.emplace(std::forward<V>(value));
+        publish(guard.s, enqueue_request);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota.
+
+		@param slots numero di posizioni dell'array delle richieste (almeno 1),
+		       cioè il numero di thread che possono pubblicare una richiesta
+		       contemporaneamente
+
+		@throw eccezione di allocazione di memoria
+	*/
+	explicit flat_combining_queue(size_type slots = 64) :
+	    _slots(nullptr), _slot_count(slots > 0 ? slots : 1),
+	    _combining(false), _size(0) { // initialization list
+
+	    _slots.reset(new slot[_slot_count]);
+	}
+
+	flat_combining_queue(const flat_combining_queue &other) = delete;
+
+	flat_combining_queue &operator=(const flat_combining_queue &other) =
+	    delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+	    @pre Nessun thread sta utilizzando la coda.
+	*/
+	virtual ~flat_combining_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce, senza attendere
+        il combinatore, il numero di elementi inseriti nella coda dopo
+        l'ultima richiesta applicata.
+        Se chiamato mentre altri thread operano sulla coda, il valore
+        restituito è solo indicativo.
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, copiandone il valore.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+	*/
+	void enqueue(const value_type &value) {
+	    push(value);
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Inserisce il valore spostandolo nella coda.
+	*/
+	void enqueue(value_type &&value) {
+	    push(std::move(value));
+	}
+
+    /**
+        @brief Tentativo di rimozione dell'elemento più vecchio
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio, spostandone il valore nel parametro.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        slot_guard guard(*this);
+        publish(guard.s, dequeue_request);
+        if(!guard.s.value.has_value())
+            return false;
+        out = std::move(*guard.s.value);
+        return true;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        slot_guard guard(*this);
+        publish(guard.s, dequeue_request);
+        if(!guard.s.value.has_value())
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        return std::move(*guard.s.value);
+    }
+};
+
+#endif
+
+// Fine file header flat_combining_queue.h
@@ -0,0 +1,488 @@
+/**
+	@headerfile hashed_queue.h
+
+    @brief Dichiarazione e definizione della classe hashed_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    hashed_queue, una coda FIFO con un indice hash secondario che rende
+    contains un'operazione in tempo costante atteso, e delle relative
+    funzioni e operatori globali.
+*/
+
+// Guardie del file header hashed_queue.h
+
+#ifndef HASHED_QUEUE_H
+#define HASHED_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <functional> // std::hash
+#include <ostream> // std::ostream
+#include <unordered_map> // std::unordered_map
+#include <utility> // std::move, std::forward, std::swap
+#include "queue.h" // queue
+#include "text_format.h" // text::write_sequence
+#include "queue_exceptions.h" // empty_queue_exception
+
+// Dichiarazione e definizione della classe template hashed_queue
+
+/**
+	@brief Coda FIFO con indice hash
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    memorizzati in una queue, affiancata da un indice hash che associa
+    a ogni valore distinto il numero dei suoi elementi nella coda.
+    L'indice usa H come funzione hash e il funtore E della coda come
+    confronto di uguaglianza: contains e count diventano operazioni
+    in tempo costante atteso invece che lineare, al prezzo di una copia
+    del valore di ogni elemento distinto e di un aggiornamento dell'indice
+    per ogni inserimento, rimozione e sovrascrittura.
+    Poiché ogni modifica di un valore deve aggiornare l'indice, la coda
+    espone solo iteratori costanti: i valori si modificano tramite
+    set_head, set_tail e transformif.
+
+    @pre H ed E devono essere coerenti: due valori uguali secondo E
+         devono avere lo stesso hash secondo H.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam H funtore hash del valore di un elemento (default std::hash<T>)
+*/
+template <typename T, typename E, typename H = std::hash<T> >
+class hashed_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+    typedef std::unordered_map<T, size_type, H, E> index_type; ///< @brief
+                                                               ///< Tipo
+                                                               ///< dell'indice
+
+	// Dati membro privati della coda
+
+    queue<T, E> _queue; ///< @brief Elementi della coda, in ordine FIFO
+    index_type _index; ///< @brief Numero di elementi per ogni valore distinto
+
+    // Funzioni private della coda
+
+    /**
+		@brief Registrazione di un valore nell'indice
+
+		@param value valore da registrare
+
+		@throw eccezione di allocazione di memoria (l'indice rimane
+		       allo stato precedente alla chiamata)
+	*/
+    void index(const value_type &value) {
+        ++_index.try_emplace(value, 0).first->second;
+    }
+
+    /**
+		@brief Cancellazione di un valore dall'indice
+
+		@param i posizione del valore nell'indice
+	*/
+    void unindex(typename index_type::iterator i) {
+        if(--i->second == 0)
+            _index.erase(i);
+    }
+
+    /**
+		@overload unindex
+
+		@param value valore da cancellare (presente nell'indice)
+	*/
+    void unindex(const value_type &value) {
+        unindex(_index.find(value));
+    }
+
+    /**
+		@brief Sovrascrittura di un elemento mantenendo aggiornato l'indice
+
+		@description
+        Funzione privata che registra il nuovo valore, cerca il vecchio
+        valore nell'indice (dopo l'eventuale rehash dovuto alla
+        registrazione) e solo dopo la sovrascrittura lo cancella:
+        se l'assegnamento lancia un'eccezione, l'indice rimane coerente
+        con la coda.
+
+		@param target riferimento all'elemento da sovrascrivere
+		@param value nuovo valore dell'elemento
+	*/
+    void overwrite(value_type &target, const value_type &value) {
+        index(value);
+        typename index_type::iterator old = _index.find(target);
+        try {
+            target = value;
+        }
+        catch(...) {
+            unindex(value);
+            throw;
+        }
+        unindex(old);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+    typedef typename queue<T, E>::const_iterator const_iterator; ///< @brief
+                                                                 ///< Iteratore
+                                                                 ///< costante
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+	*/
+	hashed_queue() {}
+
+	/*
+        Copy constructor, move constructor e operatori di assegnamento
+        coincidono con quelli di default, che copiano o spostano la coda
+        e l'indice insieme; vanno dichiarati perché il distruttore virtuale
+        sopprimerebbe quelli di spostamento.
+    */
+
+	hashed_queue(const hashed_queue &other) = default;
+
+	hashed_queue(hashed_queue &&other) = default;
+
+	hashed_queue &operator=(const hashed_queue &other) = default;
+
+	hashed_queue &operator=(hashed_queue &&other) = default;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+	*/
+	virtual ~hashed_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        return _queue.size();
+    }
+
+    /**
+        @brief Numero di valori distinti nella coda
+
+        @return numero di valori distinti nella coda (voci dell'indice)
+    */
+    size_type distinct() const {
+        return static_cast<size_type>(_index.size());
+    }
+
+    /**
+        @brief Svuotamento della coda
+
+        @post La coda e l'indice sono vuoti.
+    */
+    void clear() {
+        _queue.clear();
+        _index.clear();
+    }
+
+    /**
+        @brief Scambio del contenuto con un'altra coda
+
+        @param other coda con cui scambiare il contenuto
+    */
+    void swap(hashed_queue &other) {
+        _queue.swap(other._queue);
+        _index.swap(other._index);
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un elemento in fondo
+	    alla coda e ne registra il valore nell'indice.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria (la coda e l'indice
+		       rimangono allo stato precedente alla chiamata)
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+	*/
+	void enqueue(const value_type &value) {
+	    index(value);
+	    try {
+	        _queue.enqueue(value);
+	    }
+	    catch(...) {
+	        unindex(value);
+	        throw;
+	    }
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Registra una copia del valore nell'indice e sposta il valore
+	    nel nuovo elemento.
+	*/
+	void enqueue(value_type &&value) {
+	    typename index_type::iterator i =
+	        _index.try_emplace(value, 0).first;
+	    ++i->second;
+	    try {
+	        _queue.enqueue(std::move(value));
+	    }
+	    catch(...) {
+	        unindex(i);
+	        throw;
+	    }
+	}
+
+	/**
+		@brief Inserimento di un elemento costruito a partire dagli argomenti
+		       del costruttore del tipo T
+
+	    @tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+		@throw eccezione di allocazione di memoria o lanciata dal costruttore
+	*/
+	template <typename... Args>
+	void emplace(Args&&... args) {
+	    enqueue(value_type(std::forward<Args>(args)...));
+	}
+
+    /**
+        @brief Inserimento nella coda di un insieme di elementi presi da una
+               sequenza identificata da due iteratori
+
+        @overload enqueue
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+        @throw eccezione di allocazione di memoria (gli elementi
+               già inseriti rimangono nella coda)
+    */
+    template <typename IterT>
+    void enqueue(IterT begin, IterT end) {
+        for(; begin != end; ++begin)
+            enqueue(static_cast<value_type>(*begin));
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        value_type removed_value = _queue.dequeue();
+        unindex(removed_value);
+        return removed_value;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda senza eccezioni
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        if(!_queue.try_dequeue(out))
+            return false;
+        unindex(out);
+        return true;
+    }
+
+	/**
+		@brief Accesso in lettura all'elemento più recente della coda
+
+		@return riferimento costante al valore dell'elemento più recente
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    const value_type &get_tail() const {
+        return _queue.get_tail();
+    }
+
+    /**
+        @brief Accesso in scrittura all'elemento più recente della coda
+
+        @param value valore da assegnare all'elemento più recente della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_tail(const value_type &value) {
+        overwrite(_queue.get_tail(), value);
+    }
+
+	/**
+		@brief Accesso in lettura all'elemento più vecchio della coda
+
+		@return riferimento costante al valore dell'elemento più vecchio
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    const value_type &get_head() const {
+        return _queue.get_head();
+    }
+
+    /**
+        @brief Accesso in scrittura all'elemento più vecchio della coda
+
+        @param value valore da assegnare all'elemento più vecchio della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_head(const value_type &value) {
+        overwrite(_queue.get_head(), value);
+    }
+
+	/**
+		@brief Esistenza nella coda di almeno un elemento di un certo valore
+               dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina, con una ricerca
+        nell'indice in tempo costante atteso, se la coda contiene almeno
+        un elemento del valore dato.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+	*/
+    bool contains(const value_type &value) const {
+        return _index.find(value) != _index.end();
+    }
+
+	/**
+		@brief Numero di elementi di un certo valore dato
+
+		@param value valore degli elementi da contare
+
+		@return numero di elementi della coda del valore dato
+	*/
+    size_type count(const value_type &value) const {
+        typename index_type::const_iterator i = _index.find(value);
+        return i == _index.end() ? 0 : i->second;
+    }
+
+    /**
+		@brief Modifica sul posto dei valori che soddisfano un predicato
+
+		@description
+        Metodo dell'interfaccia pubblica utilizzato dalla funzione globale
+        transformif: ogni valore modificato viene sovrascritto tramite
+        lo stesso percorso di set_head e set_tail, mantenendo aggiornato
+        l'indice.
+
+		@param pred predicato che i valori devono soddisfare
+		@param op operatore con cui modificare i valori
+	*/
+    template <typename P, typename F>
+    void transform_if(P pred, F op) {
+        for(typename queue<T, E>::iterator i = _queue.begin(),
+            ie = _queue.end(); i != ie; ++i)
+            if(pred(*i))
+                overwrite(*i, op(*i));
+    }
+
+    /**
+		@brief Iteratore costante che punta all'inizio della coda
+
+		@return iteratore costante che punta all'elemento più vecchio
+	*/
+    const_iterator begin() const {
+        return _queue.begin();
+    }
+
+    /**
+		@brief Iteratore costante che punta alla fine della coda
+
+		@return iteratore costante che punta alla fine della coda
+	*/
+    const_iterator end() const {
+        return _queue.end();
+    }
+};
+
+// Funzioni globali
+
+/**
+	@brief Trasformazione dei valori degli elementi della coda con indice
+           che soddisfano un predicato
+
+    @description
+	Versione della funzione globale transformif per la classe hashed_queue,
+    che mantiene aggiornato l'indice.
+
+    @tparam Q tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam H funtore hash del valore di un elemento
+    @tparam P tipo del predicato
+    @tparam F tipo dell'operatore generico
+
+	@param q coda di cui modificare i valori contenuti
+	@param pred predicato che i valori devono soddisfare per essere modificati
+    @param op operatore generico con cui modificare i valori
+*/
+template <typename Q, typename E, typename H, typename P, typename F>
+void transformif(hashed_queue<Q, E, H> &q, P pred, F op) {
+    q.transform_if(pred, op);
+}
+
+// Operatori globali
+
+/**
+	@brief Ridefinizione dell'operatore di stream << per la coda con indice
+
+    @description
+	Ridefinizione dell'operatore di stream << per la stampa del contenuto
+	della coda con indice, nello stesso formato della classe queue.
+
+	@param os oggetto di stream di output
+	@param q coda da stampare
+
+	@return riferimento allo stream di output
+*/
+template <typename T, typename E, typename H>
+std::ostream &operator<<(std::ostream &os, const hashed_queue<T, E, H> &q) {
+    return text::write_sequence(os, q.begin(), q.end(), q.size());
+}
+
+/**
+	@brief Scambio del contenuto di due code con indice
+
+	@param q1 prima coda
+	@param q2 seconda coda
+*/
+template <typename T, typename E, typename H>
+void swap(hashed_queue<T, E, H> &q1, hashed_queue<T, E, H> &q2) {
+    q1.swap(q2);
+}
+
+#endif
+
+// Fine file header hashed_queue.h
@@ -0,0 +1,634 @@
+/**
+	@headerfile mpmc_queue.h
+
+    @brief Dichiarazione e definizione della classe mpmc_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    mpmc_queue, una coda FIFO concatenata priva di lock, condivisa
+    da più thread produttori e più thread consumatori (algoritmo
+    di Michael e Scott), con recupero sicuro della memoria tramite
+    hazard pointer.
+*/
+
+// Guardie del file header mpmc_queue.h
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed,
+                  // std::memory_order_acquire, std::memory_order_release
+#include <vector> // std::vector
+#include <algorithm> // std::sort, std::binary_search
+#include <new> // placement new
+#include <utility> // std::move, std::forward
+#include "queue_exceptions.h" // empty_queue_exception
+
+// Dichiarazione e definizione della classe template mpmc_queue
+
+/**
+	@brief Coda FIFO concatenata a più produttori e più consumatori
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    concatenati come nella classe queue, che può essere utilizzata
+    senza lock da un numero qualsiasi di thread produttori e consumatori.
+    La coda segue l'algoritmo di Michael e Scott: la testa punta sempre
+    a un elemento sentinella, il cui successore è l'elemento più vecchio;
+    l'inserimento concatena il nuovo elemento con un'operazione
+    compare-and-swap sul puntatore al successivo dell'ultimo elemento,
+    la rimozione avanza la testa con un compare-and-swap, e ciascun thread
+    aiuta ad avanzare il puntatore alla coda se lo trova in ritardo.
+
+    La memoria degli elementi rimossi viene recuperata tramite hazard pointer:
+    prima di accedere a un elemento, un thread lo pubblica in uno dei propri
+    hazard pointer e verifica che sia ancora raggiungibile; un elemento
+    rimosso viene "ritirato" e deallocato solo quando nessun hazard pointer
+    lo protegge. In questo modo, dequeue non dealloca mai un elemento
+    che un altro thread sta ancora leggendo, e gli indirizzi degli elementi
+    non possono essere riutilizzati durante un compare-and-swap (problema ABA).
+
+    @note Il funtore E non è utilizzato dalle operazioni concorrenti:
+          è mantenuto per uniformità di interfaccia con le altre code.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class mpmc_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+    /**
+        @brief Numero di hazard pointer per thread
+    */
+    static const size_type HAZARDS_PER_RECORD = 2;
+
+    // Strutture di supporto interne private della coda
+
+	/**
+		@brief Elemento della coda
+
+		@description
+	    Struttura di supporto interna privata della coda, che implementa
+	    un suo elemento.
+	    Il valore è memorizzato in una locazione non inizializzata: è costruito
+	    all'inserimento e distrutto quando l'elemento diventa la sentinella,
+	    mentre la memoria dell'elemento viene deallocata solo quando
+	    l'elemento, rimosso dalla coda, non è più protetto da alcun hazard
+	    pointer.
+	*/
+	struct element {
+
+		alignas(value_type) unsigned char storage[sizeof(value_type)];
+		                          ///< @brief Memoria del valore dell'elemento
+		std::atomic<element *> next; ///< @brief Puntatore all'elemento
+		                             ///< successivo della coda
+
+		/**
+			@brief Costruttore di default
+
+			@description
+		    Costruttore di default per istanziare un elemento senza valore
+		    (sentinella) e senza elemento successivo.
+		*/
+		element() : next(nullptr) {} // initialization list
+
+		/**
+			@brief Accesso al valore dell'elemento
+
+			@return puntatore al valore dell'elemento
+		*/
+		value_type *value() {
+			return reinterpret_cast<value_type *>(storage);
+		}
+	}; // struct element
+
+	/**
+		@brief Record di hazard pointer
+
+		@description
+	    Struttura di supporto interna privata della coda, che contiene
+	    gli hazard pointer di un thread e la lista degli elementi ritirati
+	    in attesa di essere deallocati.
+	    Un record è posseduto da al più un thread alla volta (per la durata
+	    di una singola operazione) e, una volta allocato, non viene deallocato
+	    fino alla distruzione della coda: la lista dei record può quindi
+	    essere percorsa senza protezioni.
+	*/
+	struct hazard_record {
+
+		std::atomic<element *> hazards[HAZARDS_PER_RECORD]; ///< @brief Hazard
+		                                                     ///< pointer
+		std::atomic<bool> active; ///< @brief Indica se il record è posseduto
+		                          ///< da un thread
+		hazard_record *next; ///< @brief Puntatore al record successivo
+		std::vector<element *> retired; ///< @brief Elementi ritirati
+
+		/**
+			@brief Costruttore di default
+
+			@description
+		    Costruttore di default per istanziare un record posseduto
+		    dal thread che lo istanzia.
+		*/
+		hazard_record() : active(true), next(nullptr) { // initialization list
+			for(size_type i = 0; i < HAZARDS_PER_RECORD; ++i)
+				hazards[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}; // struct hazard_record
+
+	/**
+		@brief Possesso temporaneo di un record di hazard pointer
+
+		@description
+	    Classe di supporto interna privata della coda, che acquisisce
+	    un record di hazard pointer all'istanziazione e lo rilascia,
+	    azzerandone gli hazard pointer, alla distruzione.
+	*/
+	class hazard_guard {
+
+		mpmc_queue &_queue; ///< @brief Coda proprietaria del record
+		hazard_record *_record; ///< @brief Record posseduto
+
+	public:
+
+		explicit hazard_guard(mpmc_queue &q) :
+			_queue(q), _record(q.acquire_record()) {} // initialization list
+
+		hazard_guard(const hazard_guard &other) = delete;
+
+		hazard_guard &operator=(const hazard_guard &other) = delete;
+
+		~hazard_guard() {
+			for(size_type i = 0; i < HAZARDS_PER_RECORD; ++i)
+				_record->hazards[i].store(nullptr, std::memory_order_release);
+			_record->active.store(false, std::memory_order_release);
+		}
+
+		/**
+			@brief Protezione di un elemento letto da un puntatore atomico
+
+			@description
+		    Pubblica nell'hazard pointer i il valore letto dal puntatore
+		    atomico src, rileggendolo finché non coincide con quello
+		    pubblicato: a quel punto l'elemento era ancora raggiungibile
+		    dopo la pubblicazione, e quindi non può essere deallocato
+		    finché l'hazard pointer non viene modificato.
+
+			@param i indice dell'hazard pointer
+			@param src puntatore atomico da leggere
+
+			@return puntatore all'elemento protetto
+		*/
+		element *protect(size_type i, const std::atomic<element *> &src) {
+			element *p = src.load();
+			for(;;) {
+				_record->hazards[i].store(p);
+				element *q = src.load();
+				if(p == q)
+					return p;
+				p = q;
+			}
+		}
+
+		/**
+			@brief Pubblicazione di un elemento in un hazard pointer
+
+			@description
+		    Il chiamante deve verificare, dopo la pubblicazione,
+		    che l'elemento sia ancora raggiungibile.
+
+			@param i indice dell'hazard pointer
+			@param p puntatore all'elemento da proteggere
+		*/
+		void set(size_type i, element *p) {
+			_record->hazards[i].store(p);
+		}
+
+		/**
+			@brief Ritiro di un elemento rimosso dalla coda
+
+			@description
+		    Gli hazard pointer del record vengono azzerati prima del ritiro,
+		    in modo che non trattengano inutilmente l'elemento ritirato.
+
+			@param e puntatore all'elemento ritirato
+		*/
+		void retire(element *e) {
+			for(size_type i = 0; i < HAZARDS_PER_RECORD; ++i)
+				_record->hazards[i].store(nullptr, std::memory_order_release);
+			_queue.retire(_record, e);
+		}
+	}; // class hazard_guard
+
+	// Dati membro privati della coda
+
+	alignas(64) std::atomic<element *> _head; ///< @brief Puntatore
+	                                          ///< all'elemento sentinella
+	alignas(64) std::atomic<element *> _tail; ///< @brief Puntatore all'ultimo
+	                                          ///< elemento della coda
+	alignas(64) std::atomic<hazard_record *> _records; ///< @brief Lista
+	                                                   ///< dei record
+	std::atomic<size_type> _record_count; ///< @brief Numero di record
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi della coda
+
+    // Funzioni private della coda
+
+    /**
+		@brief Acquisizione di un record di hazard pointer
+
+		@description
+        Funzione privata che acquisisce il primo record libero della lista,
+        oppure, se sono tutti posseduti, istanzia un nuovo record
+        e lo inserisce in testa alla lista.
+
+        @return puntatore al record acquisito
+
+        @throw eccezione di allocazione di memoria
+	*/
+    hazard_record *acquire_record() {
+        for(hazard_record *r = _records.load(std::memory_order_acquire);
+            r != nullptr; r = r->next) {
+            bool expected = false;
+            if(!r->active.load(std::memory_order_relaxed) &&
+               r->active.compare_exchange_strong(expected, true,
+                                                 std::memory_order_acquire))
+                return r;
+        }
+
+        hazard_record *r = new hazard_record();
+        hazard_record *first = _records.load(std::memory_order_relaxed);
+        do
+            r->next = first;
+        while(!_records.compare_exchange_weak(first, r,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+        _record_count.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+
+    /**
+		@brief Ritiro di un elemento rimosso dalla coda
+
+		@description
+        Funzione privata che aggiunge l'elemento alla lista degli elementi
+        ritirati del record e, quando la lista supera una soglia
+        proporzionale al numero totale di hazard pointer, la scandisce,
+        deallocando gli elementi che non sono protetti da alcun hazard
+        pointer. In questo modo, il costo della scansione è ammortizzato
+        su un numero di ritiri pari almeno al numero di hazard pointer.
+
+        @param r record posseduto dal thread chiamante
+        @param e puntatore all'elemento ritirato
+	*/
+    void retire(hazard_record *r, element *e) {
+        r->retired.push_back(e);
+        size_type threshold = 2 * HAZARDS_PER_RECORD *
+                              _record_count.load(std::memory_order_relaxed);
+        if(threshold < 64)
+            threshold = 64;
+        if(r->retired.size() >= threshold)
+            scan(r);
+    }
+
+    /**
+		@brief Scansione degli elementi ritirati di un record
+
+		@description
+        Funzione privata che raccoglie tutti gli hazard pointer pubblicati
+        e dealloca gli elementi ritirati del record che non compaiono
+        tra questi, conservando gli altri.
+
+        @param r record posseduto dal thread chiamante
+	*/
+    void scan(hazard_record *r) {
+        std::vector<element *> hazards;
+        for(hazard_record *h = _records.load(std::memory_order_acquire);
+            h != nullptr; h = h->next)
+            for(size_type i = 0; i < HAZARDS_PER_RECORD; ++i) {
+                element *p = h->hazards[i].load();
+                if(p != nullptr)
+                    hazards.push_back(p);
+            }
+        std::sort(hazards.begin(), hazards.end());
+
+        std::vector<element *> kept;
+        for(element *e : r->retired)
+            if(std::binary_search(hazards.begin(), hazards.end(), e))
+                kept.push_back(e);
+            else
+                delete e;
+        r->retired.swap(kept);
+    }
+
+    /**
+		@brief Inserimento di un nuovo elemento in coda alla coda
+
+		@description
+        Funzione privata che concatena l'elemento dopo l'ultimo elemento
+        della coda con un compare-and-swap e prova poi ad avanzare
+        il puntatore alla coda. Se il puntatore alla coda è in ritardo
+        (l'ultimo elemento ha un successore), lo avanza prima di riprovare.
+
+        @param e puntatore al nuovo elemento, con il valore già costruito
+	*/
+    void link_back(element *e) {
+        hazard_guard guard(*this);
+        for(;;) {
+            element *tail = guard.protect(0, _tail);
+            element *next = tail->next.load(std::memory_order_acquire);
+            if(tail != _tail.load(std::memory_order_acquire))
+                continue;
+            if(next != nullptr) {
+                _tail.compare_exchange_weak(tail, next,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed);
+                continue;
+            }
+            if(tail->next.compare_exchange_weak(next, e,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+                _tail.compare_exchange_strong(tail, e,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    /**
+		@brief Avanzamento della testa della coda
+
+		@description
+        Funzione privata che protegge la sentinella e il suo successore
+        con gli hazard pointer 0 e 1 e avanza la testa con un compare-and-swap.
+        Se il puntatore alla coda punta ancora alla sentinella, lo avanza
+        prima di riprovare.
+        In caso di successo, il successore è diventato la nuova sentinella:
+        il suo valore (ancora da spostare e distruggere) rimane protetto
+        dall'hazard pointer 1, mentre la vecchia sentinella dev'essere ritirata
+        dal chiamante.
+
+        @param guard record di hazard pointer del thread chiamante
+        @param head vecchia sentinella (in uscita)
+        @param next nuova sentinella (in uscita)
+
+        @return true se la testa è stata avanzata, false se la coda è vuota
+	*/
+    bool advance_head(hazard_guard &guard, element *&head, element *&next) {
+        for(;;) {
+            head = guard.protect(0, _head);
+            element *tail = _tail.load(std::memory_order_acquire);
+            next = head->next.load(std::memory_order_acquire);
+            guard.set(1, next);
+            if(head != _head.load())
+                continue;
+            if(next == nullptr)
+                return false;
+            if(head == tail) {
+                _tail.compare_exchange_weak(tail, next,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed);
+                continue;
+            }
+            if(_head.compare_exchange_weak(head, next,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    /**
+		@brief Istanziamento e inserimento di un nuovo elemento
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+		@throw eccezione di allocazione di memoria
+	*/
+    template <typename... Args>
+    void construct_back(Args&&... args) {
+        element *e = new element();
+        try {
+            new (e->value()) value_type(std::forward<Args>(args)...);
+        }
+        catch(...) {
+            delete e;
+            throw;
+        }
+        link_back(e);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di default per istanziare una coda vuota, composta
+	    dal solo elemento sentinella.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	mpmc_queue() :
+	    _head(nullptr), _tail(nullptr), _records(nullptr),
+	    _record_count(0) { // initialization list
+
+	    element *sentinel = new element();
+	    _head.store(sentinel, std::memory_order_relaxed);
+	    _tail.store(sentinel, std::memory_order_relaxed);
+	}
+
+	mpmc_queue(const mpmc_queue &other) = delete;
+
+	mpmc_queue &operator=(const mpmc_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore della coda, che distrugge i valori degli elementi
+	    non ancora rimossi e dealloca tutti gli elementi, compresi quelli
+	    ritirati, e tutti i record di hazard pointer.
+
+	    @pre Nessun thread sta utilizzando la coda.
+	*/
+	virtual ~mpmc_queue() {
+	    element *e = _head.load(std::memory_order_acquire);
+	    element *next = e->next.load(std::memory_order_relaxed);
+	    delete e; // sentinella, senza valore
+	    for(e = next; e != nullptr; e = next) {
+	        next = e->next.load(std::memory_order_relaxed);
+	        e->value()->~value_type();
+	        delete e;
+	    }
+
+	    hazard_record *r = _records.load(std::memory_order_acquire);
+	    while(r != nullptr) {
+	        hazard_record *next_record = r->next;
+	        for(element *retired : r->retired)
+	            delete retired;
+	        delete r;
+	        r = next_record;
+	    }
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Verifica se la coda è vuota
+
+        @description
+        Metodo dell'interfaccia pubblica che verifica se la sentinella
+        ha un successore. Se chiamato mentre altri thread operano sulla coda,
+        il risultato è solo indicativo.
+
+        @return true se la coda è vuota, false altrimenti
+    */
+    bool empty() {
+        hazard_guard guard(*this);
+        element *head = guard.protect(0, _head);
+        return head->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, copiandone il valore. Può essere chiamato da qualsiasi
+	    thread, senza lock.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(const value_type &value) {
+		construct_back(value);
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda per spostamento
+
+		@overload enqueue
+
+		@param value valore dell'elemento da spostare nella coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(value_type &&value) {
+		construct_back(std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento costruito sul posto
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+		@throw eccezione di allocazione di memoria
+	*/
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		construct_back(std::forward<Args>(args)...);
+	}
+
+    /**
+        @brief Tentativo di rimozione dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio della coda, spostandone il valore
+        nel parametro passato per riferimento. Può essere chiamato
+        da qualsiasi thread, senza lock.
+        Dopo l'avanzamento della testa, il valore della nuova sentinella
+        viene spostato e distrutto e la vecchia sentinella viene ritirata.
+
+        @note Se lo spostamento del valore lancia un'eccezione, l'elemento
+              è comunque rimosso dalla coda e l'eccezione viene propagata
+              alla funzione chiamante.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        hazard_guard guard(*this);
+        element *head;
+        element *next;
+        if(!advance_head(guard, head, next))
+            return false;
+
+        value_type *v = next->value();
+        try {
+            out = std::move(*v);
+        }
+        catch(...) {
+            v->~value_type();
+            guard.retire(head);
+            throw;
+        }
+        v->~value_type();
+        guard.retire(head);
+        return true;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda e ne restituisce il valore, con la stessa semantica
+        di try_dequeue, ma lanciando un'eccezione apposita se la coda è vuota.
+
+        @pre La coda non dev'essere vuota.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        hazard_guard guard(*this);
+        element *head;
+        element *next;
+        if(!advance_head(guard, head, next))
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+
+        value_type *v = next->value();
+        try {
+            value_type removed_value(std::move(*v));
+            v->~value_type();
+            guard.retire(head);
+            return removed_value;
+        }
+        catch(...) {
+            v->~value_type();
+            guard.retire(head);
+            throw;
+        }
+    }
+};
+
+#endif
+
+// Fine file header mpmc_queue.h
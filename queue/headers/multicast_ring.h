@@ -0,0 +1,376 @@
+/**
+	@headerfile multicast_ring.h
+
+    @brief Dichiarazione e definizione della classe multicast_ring
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    multicast_ring, un buffer circolare in cui un unico produttore pubblica
+    una sequenza di elementi che ciascuno di più consumatori legge per intero
+    (in stile Disruptor).
+*/
+
+// Guardie del file header multicast_ring.h
+
+#ifndef MULTICAST_RING_H
+#define MULTICAST_RING_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed,
+                  // std::memory_order_acquire, std::memory_order_release
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int64_t
+#include <memory> // std::unique_ptr
+#include <stdexcept> // std::length_error
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move, std::forward
+#include <vector> // std::vector
+
+// Dichiarazione e definizione della classe template multicast_ring
+
+/**
+	@brief Buffer circolare multicast a singolo produttore
+
+	@description
+    Classe template che implementa un buffer circolare di elementi
+    generici T, a capacità limitata, in cui un unico thread produttore
+    pubblica gli elementi in sequenza e un numero fissato di consumatori,
+    ciascuno con un proprio cursore, legge ogni elemento esattamente
+    una volta, nell'ordine di pubblicazione.
+    Ogni elemento viene memorizzato una sola volta, qualunque sia
+    il numero di consumatori, che lo leggono sul posto: la distribuzione
+    a N consumatori non richiede N copie né N allocazioni.
+    Le posizioni del buffer sono oggetti T costruiti alla costruzione
+    del buffer e riutilizzati per assegnamento (un valore che alloca
+    memoria, come una stringa, può così riusare la memoria del valore
+    sovrascritto); una posizione viene riutilizzata solo dopo che
+    il cursore del consumatore più lento l'ha superata.
+    La sequenza del produttore e i cursori dei consumatori sono contatori
+    atomici su linee di cache distinte: il produttore pubblica con una
+    scrittura release della propria sequenza e ciascun consumatore
+    rilascia le posizioni lette con una scrittura release del proprio
+    cursore.
+
+    @note Il buffer non è copiabile né assegnabile: è pensato per essere
+          condiviso, per riferimento, tra il produttore e i consumatori.
+
+    @pre Il tipo T è costruibile per default e assegnabile.
+
+	@tparam T tipo del valore degli elementi del buffer
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class multicast_ring {
+
+    // Tipi di supporto privati del buffer
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< del buffer
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< e di consumatori
+    typedef std::int64_t sequence_type; ///< @brief Tipo di supporto privato per
+                                        ///< rappresentare le sequenze
+
+    /**
+        @brief Dimensione presunta di una linea di cache, in byte
+    */
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+        @brief Capacità massima del buffer, la massima potenza di 2
+               rappresentabile con size_type
+    */
+    static const size_type MAX_CAPACITY = size_type(1) << 31;
+
+    /**
+        @brief Contatore su una propria linea di cache
+    */
+    struct alignas(CACHE_LINE) padded_sequence {
+        std::atomic<sequence_type> value; ///< @brief Valore del contatore
+
+        padded_sequence() : value(-1) {} // initialization list
+    };
+
+	// Dati membro privati del buffer
+
+    // Dati in sola lettura dopo la costruzione
+    std::vector<value_type> _slots; ///< @brief Posizioni del buffer
+    size_type _capacity; ///< @brief Capacità del buffer (potenza di 2)
+    sequence_type _mask; ///< @brief Maschera per la posizione nel buffer
+    std::unique_ptr<padded_sequence[]> _cursors; ///< @brief Ultima sequenza
+                                                 ///< letta da ogni consumatore
+    size_type _consumers; ///< @brief Numero di consumatori
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi del buffer
+
+    // Dati del produttore
+    padded_sequence _published; ///< @brief Ultima sequenza pubblicata
+    sequence_type _next; ///< @brief Prossima sequenza da pubblicare
+    sequence_type _cached_gate; ///< @brief Ultimo valore letto del cursore
+                                ///< più lento
+
+    // Funzioni private del buffer
+
+    /**
+		@brief Cursore del consumatore più lento (produttore)
+	*/
+    sequence_type slowest_cursor() const {
+        sequence_type slowest = _next - 1;
+        for(size_type i = 0; i < _consumers; ++i) {
+            sequence_type c = _cursors[i].value.load(std::memory_order_acquire);
+            if(c < slowest)
+                slowest = c;
+        }
+        return slowest;
+    }
+
+    /**
+		@brief Verifica della disponibilità di una posizione (produttore)
+
+		@description
+        Funzione privata che rilegge i cursori dei consumatori solo se
+        l'ultimo valore letto del cursore più lento indica che il buffer
+        è pieno.
+
+        @return true se la prossima sequenza può essere pubblicata
+	*/
+    bool has_room() {
+        if(_next - _cached_gate <= _capacity)
+            return true;
+        _cached_gate = slowest_cursor();
+        return _next - _cached_gate <= _capacity;
+    }
+
+    /**
+		@brief Scrittura e pubblicazione della prossima sequenza (produttore)
+
+        @pre has_room() ha restituito true.
+	*/
+    template <typename V>
+    void write(V &&value) {
+        _slots[_next & _mask] = std::forward<V>(value);
+        _published.value.store(_next, std::memory_order_release);
+        ++_next;
+    }
+
+    /**
+        @brief Arrotondamento della capacità alla potenza di 2 successiva
+               (almeno 2)
+
+        @throw std::length_error se n supera la capacità massima (2^31)
+    */
+    static size_type round_capacity(size_type n) {
+        if(n > MAX_CAPACITY)
+            throw std::length_error("multicast_ring: capacita' richiesta "
+                                    "troppo grande");
+        size_type c = 2;
+        while(c < n)
+            c *= 2;
+        return c;
+    }
+
+public:
+
+    // Interfaccia pubblica del buffer
+
+	// Metodi fondamentali del buffer
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia un buffer vuoto, costruendo una volta
+	    per tutte le posizioni del buffer.
+	    La capacità viene arrotondata alla potenza di 2 successiva.
+
+		@param capacity numero massimo di elementi pubblicati e non ancora
+		       letti da tutti i consumatori
+		@param consumers numero di consumatori (almeno 1)
+
+		@throw std::length_error se capacity supera la capacità massima (2^31)
+		@throw eccezione di allocazione di memoria
+	*/
+	multicast_ring(size_type capacity, size_type consumers) :
+	    _slots(round_capacity(capacity)),
+	    _capacity(static_cast<size_type>(_slots.size())),
+	    _mask(_capacity - 1), _cursors(nullptr),
+	    _consumers(consumers > 0 ? consumers : 1), _next(0),
+	    _cached_gate(-1) { // initialization list
+
+	    _cursors.reset(new padded_sequence[_consumers]);
+	}
+
+	multicast_ring(const multicast_ring &other) = delete;
+
+	multicast_ring &operator=(const multicast_ring &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+	    @pre Nessun thread sta utilizzando il buffer.
+	*/
+	virtual ~multicast_ring() {}
+
+	// Fine metodi fondamentali del buffer
+
+	// Ulteriori metodi dell'interfaccia pubblica del buffer
+
+    /**
+        @brief Capacità del buffer
+
+        @return numero massimo di elementi pubblicati e non ancora letti
+                da tutti i consumatori
+    */
+    size_type capacity() const {
+        return _capacity;
+    }
+
+    /**
+        @brief Numero di consumatori
+
+        @return numero di consumatori del buffer
+    */
+    size_type consumers() const {
+        return _consumers;
+    }
+
+	/**
+		@brief Tentativo di pubblicazione di un elemento (produttore)
+
+		@description
+	    Metodo dell'interfaccia pubblica che, se il consumatore più lento
+	    ha liberato almeno una posizione, vi assegna il valore e lo pubblica
+	    a tutti i consumatori.
+	    Può essere chiamato solo dal thread produttore.
+
+		@param value valore dell'elemento da pubblicare
+
+		@return true se l'elemento è stato pubblicato, false se il buffer
+		        è pieno
+	*/
+	bool try_publish(const value_type &value) {
+	    if(!has_room())
+	        return false;
+	    write(value);
+	    return true;
+	}
+
+	/**
+		@overload try_publish
+
+		@description
+	    Pubblica il valore spostandolo nella posizione.
+	*/
+	bool try_publish(value_type &&value) {
+	    if(!has_room())
+	        return false;
+	    write(std::move(value));
+	    return true;
+	}
+
+	/**
+		@brief Pubblicazione di un elemento (produttore)
+
+		@description
+	    Metodo dell'interfaccia pubblica che pubblica l'elemento, cedendo
+	    il processore finché il consumatore più lento non ha liberato
+	    una posizione.
+	    Può essere chiamato solo dal thread produttore.
+
+		@param value valore dell'elemento da pubblicare
+	*/
+	void publish(const value_type &value) {
+	    while(!has_room())
+	        std::this_thread::yield();
+	    write(value);
+	}
+
+	/**
+		@overload publish
+
+		@description
+	    Pubblica il valore spostandolo nella posizione.
+	*/
+	void publish(value_type &&value) {
+	    while(!has_room())
+	        std::this_thread::yield();
+	    write(std::move(value));
+	}
+
+    /**
+        @brief Numero di elementi pubblicati e non ancora letti da un
+               consumatore
+
+        @param consumer indice del consumatore (minore di consumers())
+
+        @return numero di elementi disponibili per il consumatore
+    */
+    size_type available(size_type consumer) const {
+        const sequence_type published =
+            _published.value.load(std::memory_order_acquire);
+        const sequence_type cursor =
+            _cursors[consumer].value.load(std::memory_order_relaxed);
+        return static_cast<size_type>(published - cursor);
+    }
+
+	/**
+		@brief Lettura sul posto degli elementi disponibili per un consumatore
+
+		@description
+	    Metodo dell'interfaccia pubblica che applica il funtore, in ordine,
+	    a ciascuno degli elementi pubblicati e non ancora letti dal
+	    consumatore (al più max), senza copiarli, e avanza poi il cursore
+	    del consumatore una sola volta per l'intero blocco, liberando
+	    le posizioni se il consumatore era il più lento.
+	    Può essere chiamato solo dal thread del consumatore.
+
+	    @tparam F tipo del funtore, chiamabile con un argomento di tipo
+	              const T&
+
+		@param consumer indice del consumatore (minore di consumers())
+		@param f funtore da applicare agli elementi
+		@param max numero massimo di elementi da leggere
+
+		@return numero di elementi letti
+	*/
+	template <typename F>
+	size_type consume(size_type consumer, F f, size_type max = ~0u) {
+	    std::atomic<sequence_type> &cursor = _cursors[consumer].value;
+	    const sequence_type first = cursor.load(std::memory_order_relaxed) + 1;
+	    sequence_type last = _published.value.load(std::memory_order_acquire);
+	    if(last - first + 1 > static_cast<sequence_type>(max))
+	        last = first + max - 1;
+	    for(sequence_type s = first; s <= last; ++s)
+	        f(static_cast<const value_type &>(_slots[s & _mask]));
+	    if(last >= first)
+	        cursor.store(last, std::memory_order_release);
+	    return static_cast<size_type>(last - first + 1);
+	}
+
+	/**
+		@brief Tentativo di lettura di un elemento per un consumatore
+
+		@description
+	    Metodo dell'interfaccia pubblica che copia nel parametro il prossimo
+	    elemento non ancora letto dal consumatore, se presente.
+	    Può essere chiamato solo dal thread del consumatore.
+
+		@param consumer indice del consumatore (minore di consumers())
+		@param out valore in cui copiare il valore dell'elemento letto
+
+		@return true se un elemento è stato letto, false se il consumatore
+		        ha già letto tutti gli elementi pubblicati
+	*/
+	bool try_read(size_type consumer, value_type &out) {
+	    return consume(consumer, [&out](const value_type &value) {
+	        out = value;
+	    }, 1) == 1;
+	}
+};
+
+#endif
+
+// Fine file header multicast_ring.h
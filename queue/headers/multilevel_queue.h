@@ -0,0 +1,785 @@
+/**
+	@headerfile multilevel_queue.h
+
+    @brief Dichiarazione e definizione della classe multilevel_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    multilevel_queue, una coda con priorità a K livelli, FIFO all'interno
+    di ciascun livello, e delle relative funzioni e operatori globali.
+*/
+
+// Guardie del file header multilevel_queue.h
+
+#ifndef MULTILEVEL_QUEUE_H
+#define MULTILEVEL_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <array> // std::array
+#include <bit> // std::bit_width
+#include <cstddef> // ptrdiff_t
+#include <cstdint> // std::uint64_t
+#include <iterator> // std::forward_iterator_tag
+#include <ostream> // std::ostream
+#include <utility> // std::move, std::forward, std::swap
+#include "queue.h" // queue
+#include "text_format.h" // text::write_sequence
+#include "queue_exceptions.h" // empty_queue_exception,
+                              // queue_iterator_out_of_bounds_exception,
+                              // invalid_level_exception
+
+// Dichiarazione e definizione della classe template multilevel_queue
+
+/**
+	@brief Coda con priorità a più livelli
+
+	@description
+    Classe template che implementa una coda di elementi generici T
+    con K livelli di priorità, numerati da 0 (priorità minima) a K - 1
+    (priorità massima), ciascuno dei quali è una queue con la consueta
+    logica FIFO.
+    La rimozione e la lettura della testa riguardano l'elemento più vecchio
+    del livello non vuoto di priorità massima.
+    Una maschera di bit tiene traccia dei livelli non vuoti: il livello
+    di priorità massima si ottiene in tempo costante dalla posizione
+    del bit più significativo (std::bit_width, tradotta in una singola
+    istruzione di conteggio degli zeri iniziali), e contains, gli iteratori
+    e la stampa visitano solo i livelli non vuoti.
+    Gli iteratori restituiscono gli elementi in ordine di rimozione:
+    per livelli di priorità decrescente e, all'interno di ogni livello,
+    in ordine FIFO.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam K numero di livelli di priorità (da 1 a 64)
+*/
+template <typename T, typename E, unsigned int K = 32>
+class multilevel_queue {
+
+    static_assert(K >= 1 && K <= 64,
+                  "multilevel_queue supporta da 1 a 64 livelli");
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+    typedef queue<T, E> level_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare un livello
+    typedef std::uint64_t mask_type; ///< @brief Tipo di supporto privato per
+                                     ///< rappresentare la maschera dei livelli
+                                     ///< non vuoti
+
+	// Dati membro privati della coda
+
+    std::array<level_type, K> _levels; ///< @brief Livelli della coda
+    mask_type _nonempty; ///< @brief Bit i a 1 se il livello i non è vuoto
+    size_type _size; ///< @brief Numero di elementi inseriti nella coda
+
+    // Funzioni private della coda
+
+    /**
+		@brief Livello non vuoto di priorità massima in una maschera
+
+		@param mask maschera di livelli, non nulla
+
+		@return indice del bit più significativo della maschera
+	*/
+    static size_type highest(mask_type mask) {
+        return static_cast<size_type>(std::bit_width(mask)) - 1;
+    }
+
+    /**
+		@brief Livello non vuoto di priorità inferiore a un livello dato
+
+		@param mask maschera dei livelli non vuoti
+		@param level livello di partenza
+
+		@return livello non vuoto di priorità massima tra quelli inferiori
+		        a level, oppure K se non esiste
+	*/
+    static size_type next_below(mask_type mask, size_type level) {
+        mask_type below = mask & ((mask_type(1) << level) - 1);
+        return below == 0 ? K : highest(below);
+    }
+
+    /**
+		@brief Verifica della validità di un livello
+
+		@throw invalid_level_exception se il livello non esiste
+	*/
+    static void check_level(size_type level) {
+        if(level >= K)
+            throw invalid_level_exception("Impossibile accedere al livello: "
+                                          "livello di priorita' inesistente.");
+    }
+
+    /**
+		@brief Livello non vuoto di priorità massima
+
+		@throw empty_queue_exception se la coda è vuota
+	*/
+    size_type head_level() const {
+        if(_nonempty == 0)
+            throw empty_queue_exception("Impossibile accedere all'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        return highest(_nonempty);
+    }
+
+    /**
+		@brief Aggiornamento della maschera dopo una rimozione dal livello
+	*/
+    void removed_from(size_type level) {
+        --_size;
+        if(_levels[level].size() == 0)
+            _nonempty &= ~(mask_type(1) << level);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di default che istanzia una coda vuota.
+	*/
+	multilevel_queue() : _nonempty(0), _size(0) {} // initialization list
+
+	/**
+		@brief Copy constructor (METODO FONDAMENTALE)
+
+		@param other coda da copiare
+
+		@throw eccezione di allocazione di memoria
+	*/
+	multilevel_queue(const multilevel_queue &other) :
+	    _levels(other._levels), _nonempty(other._nonempty),
+	    _size(other._size) {} // initialization list
+
+	/**
+		@brief Move constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che sottrae i livelli all'altra coda, che resta vuota.
+
+		@param other coda da cui sottrarre i livelli
+	*/
+	multilevel_queue(multilevel_queue &&other) noexcept :
+	    _levels(std::move(other._levels)), _nonempty(other._nonempty),
+	    _size(other._size) { // initialization list
+
+	    other._nonempty = 0;
+	    other._size = 0;
+	}
+
+	/**
+		@brief Operatore di assegnamento (METODO FONDAMENTALE)
+
+		@param other coda da copiare
+
+		@return riferimento alla coda corrente
+
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+	*/
+	multilevel_queue &operator=(const multilevel_queue &other) {
+	    if(this != &other) {
+	        multilevel_queue tmp(other);
+	        swap(tmp);
+	    }
+	    return *this;
+	}
+
+	/**
+		@brief Operatore di assegnamento per spostamento (METODO FONDAMENTALE)
+
+		@param other coda da cui sottrarre i livelli
+
+		@return riferimento alla coda corrente
+	*/
+	multilevel_queue &operator=(multilevel_queue &&other) noexcept {
+	    if(this != &other) {
+	        multilevel_queue tmp(std::move(other));
+	        swap(tmp);
+	    }
+	    return *this;
+	}
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+	*/
+	virtual ~multilevel_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda, in tutti i livelli
+    */
+    size_type size() const {
+        return _size;
+    }
+
+    /**
+        @overload size
+
+        @param level livello di priorità
+
+        @return numero di elementi inseriti nel livello
+
+        @throw invalid_level_exception se il livello non esiste
+    */
+    size_type size(size_type level) const {
+        check_level(level);
+        return _levels[level].size();
+    }
+
+    /**
+        @brief Numero di livelli di priorità
+
+        @return numero di livelli di priorità K
+    */
+    static constexpr size_type levels() {
+        return K;
+    }
+
+    /**
+        @brief Livello di priorità della testa della coda
+
+        @return livello non vuoto di priorità massima
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    size_type top_level() const {
+        return head_level();
+    }
+
+    /**
+        @brief Svuotamento della coda
+
+        @post La coda è vuota.
+    */
+    void clear() {
+        for(mask_type m = _nonempty; m != 0; m &= ~(mask_type(1) << highest(m)))
+            _levels[highest(m)].clear();
+        _nonempty = 0;
+        _size = 0;
+    }
+
+    /**
+        @brief Scambio del contenuto di due code
+
+        @param other coda con cui scambiare il contenuto
+    */
+    void swap(multilevel_queue &other) noexcept {
+        for(size_type i = 0; i < K; ++i)
+            _levels[i].swap(other._levels[i]);
+        std::swap(_nonempty, other._nonempty);
+        std::swap(_size, other._size);
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento in un livello
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    in fondo al livello di priorità dato, copiandone il valore.
+
+		@param level livello di priorità dell'elemento
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw invalid_level_exception se il livello non esiste
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+	*/
+	void enqueue(size_type level, const value_type &value) {
+	    emplace(level, value);
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Inserisce il valore spostandolo nel livello.
+	*/
+	void enqueue(size_type level, value_type &&value) {
+	    emplace(level, std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un elemento costruito sul posto in un livello
+
+	    @tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param level livello di priorità dell'elemento
+		@param args argomenti del costruttore del tipo T
+
+		@throw invalid_level_exception se il livello non esiste
+		@throw eccezione di allocazione di memoria o lanciata dal costruttore
+		       (la coda rimane allo stato precedente alla chiamata)
+	*/
+	template <typename... Args>
+	void emplace(size_type level, Args&&... args) {
+	    check_level(level);
+	    _levels[level].emplace(std::forward<Args>(args)...);
+	    _nonempty |= mask_type(1) << level;
+	    ++_size;
+	}
+
+    /**
+        @brief Rimozione dell'elemento più vecchio del livello di priorità
+               massima
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        const size_type level = head_level();
+        value_type removed_value = _levels[level].dequeue();
+        removed_from(level);
+        return removed_value;
+    }
+
+    /**
+        @brief Tentativo di rimozione dell'elemento più vecchio del livello
+               di priorità massima
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        if(_nonempty == 0)
+            return false;
+        const size_type level = highest(_nonempty);
+        _levels[level].try_dequeue(out);
+        removed_from(level);
+        return true;
+    }
+
+    /**
+        @brief Accesso all'elemento più vecchio del livello di priorità
+               massima
+
+        @return riferimento al valore della testa della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type &get_head() const {
+        return _levels[head_level()].get_head();
+    }
+
+	/**
+		@brief Verifica dell'esistenza di un elemento di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina se almeno un livello
+        della coda contiene un elemento del valore dato, visitando solo
+        i livelli non vuoti.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+	*/
+    bool contains(const value_type &value) const {
+        for(size_type l = _nonempty == 0 ? K : highest(_nonempty); l < K;
+            l = next_below(_nonempty, l))
+            if(_levels[l].contains(value))
+                return true;
+        return false;
+    }
+
+    // Supporto agli iteratori della coda
+
+    class const_iterator; // forward declaration dell'iteratore costante
+
+    /**
+		@brief Iteratore della coda in lettura e scrittura di tipo forward
+
+	    @description
+		Iteratore della coda in lettura e scrittura di tipo forward.
+		Gli elementi sono ritornati per livelli di priorità decrescente
+		e, all'interno di ogni livello, seguendo la logica FIFO.
+		L'iteratore conosce la coda, il livello corrente e un iteratore
+		del livello corrente; l'iteratore di fine coda ha la coda nulla.
+	*/
+    class iterator {
+
+        multilevel_queue *_q; ///< @brief Coda (nulla a fine coda)
+        size_type _level; ///< @brief Livello dell'elemento puntato
+        typename level_type::iterator _i; ///< @brief Elemento puntato
+
+    public:
+
+        // Traits dell'iteratore
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef T                         value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef T*                        pointer; ///< @brief Tipo puntatore
+        typedef T&                        reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        iterator() : _q(nullptr), _level(K) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return *_i;
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore dell'elemento puntato dall'iteratore
+		*/
+        pointer operator->() const {
+            return &*_i;
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@description
+			Al termine di un livello, l'iteratore passa al primo elemento
+			del livello non vuoto successivo, in ordine di priorità
+			decrescente.
+
+			@return riferimento all'iteratore corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator& operator++() {
+            if(_q == nullptr)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            if(++_i == _q->_levels[_level].end()) {
+                _level = next_below(_q->_nonempty, _level);
+                if(_level == K)
+                    _q = nullptr;
+                else
+                    _i = _q->_levels[_level].begin();
+            }
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore corrente prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator operator++(int) {
+            iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+
+			@return true se i due iteratori puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator==(const iterator &other) const {
+            return _q == other._q &&
+                   (_q == nullptr || (_level == other._level &&
+                                      _i == other._i));
+        }
+
+        /**
+			@brief Operatore di diversità
+
+			@return true se i due iteratori non puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+        friend class const_iterator;
+
+    private:
+
+        friend class multilevel_queue; // per permettere alla classe
+                                       // container di utilizzare
+                                       // il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param q coda
+			@param level livello dell'elemento puntato
+		*/
+        iterator(multilevel_queue *q, size_type level) :
+            _q(q), _level(level),
+            _i(q->_levels[level].begin()) {} // initialization list
+
+    }; // class iterator
+
+    /**
+		@brief Iteratore che punta all'inizio della coda
+
+		@return iteratore che punta all'elemento più vecchio del livello
+		        di priorità massima
+	*/
+    iterator begin() {
+        return _nonempty == 0 ? iterator() : iterator(this,
+                                                      highest(_nonempty));
+    }
+
+    /**
+		@brief Iteratore che punta alla fine della coda
+
+		@return iteratore che punta alla fine della coda
+	*/
+    iterator end() {
+        return iterator();
+    }
+
+    /**
+		@brief Iteratore costante della coda di tipo forward
+
+	    @description
+		Iteratore costante della coda di tipo forward, con lo stesso ordine
+		di visita dell'iteratore in lettura e scrittura.
+	*/
+    class const_iterator {
+
+        const multilevel_queue *_q; ///< @brief Coda (nulla a fine coda)
+        size_type _level; ///< @brief Livello dell'elemento puntato
+        typename level_type::const_iterator _i; ///< @brief Elemento puntato
+
+    public:
+
+        // Traits dell'iteratore costante
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef const T                   value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef const T*                  pointer; ///< @brief Tipo puntatore
+        typedef const T&                  reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        const_iterator() : _q(nullptr), _level(K) {} // initialization list
+
+        /**
+			@brief Costruttore di conversione da iteratore in lettura e
+                   scrittura a iteratore costante
+
+			@param other iteratore in lettura e scrittura da convertire
+		*/
+        const_iterator(const iterator &other) :
+            _q(other._q), _level(other._level),
+            _i(other._i) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore costante dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return *_i;
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore costante dell'elemento puntato
+		*/
+        pointer operator->() const {
+            return &*_i;
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@return riferimento all'iteratore costante corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator& operator++() {
+            if(_q == nullptr)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore "
+                                                             "costante: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            if(++_i == _q->_levels[_level].end()) {
+                _level = next_below(_q->_nonempty, _level);
+                if(_level == K)
+                    _q = nullptr;
+                else
+                    _i = _q->_levels[_level].begin();
+            }
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore costante prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+		*/
+        bool operator==(const const_iterator &other) const {
+            return _q == other._q &&
+                   (_q == nullptr || (_level == other._level &&
+                                      _i == other._i));
+        }
+
+        /**
+			@brief Operatore di diversità
+		*/
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class multilevel_queue; // per permettere alla classe
+                                       // container di utilizzare
+                                       // il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param q coda
+			@param level livello dell'elemento puntato
+		*/
+        const_iterator(const multilevel_queue *q, size_type level) :
+            _q(q), _level(level),
+            _i(q->_levels[level].begin()) {} // initialization list
+
+    }; // class const_iterator
+
+    /**
+		@brief Iteratore costante che punta all'inizio della coda
+
+		@return iteratore costante che punta all'elemento più vecchio
+		        del livello di priorità massima
+	*/
+    const_iterator begin() const {
+        return _nonempty == 0 ? const_iterator()
+                              : const_iterator(this, highest(_nonempty));
+    }
+
+    /**
+		@brief Iteratore costante che punta alla fine della coda
+
+		@return iteratore costante che punta alla fine della coda
+	*/
+    const_iterator end() const {
+        return const_iterator();
+    }
+};
+
+// Funzioni globali
+
+/**
+	@brief Trasformazione dei valori degli elementi della coda a più livelli
+           che soddisfano un predicato
+
+    @description
+	Versione della funzione globale transformif per la classe
+    multilevel_queue: i valori vengono modificati sul posto, senza cambiarne
+    il livello di priorità.
+
+    @tparam Q tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam K numero di livelli di priorità
+    @tparam P tipo del predicato
+    @tparam F tipo dell'operatore generico
+
+	@param q coda di cui modificare i valori contenuti
+	@param pred predicato che i valori devono soddisfare per essere modificati
+    @param op operatore generico con cui modificare i valori
+*/
+template <typename Q, typename E, unsigned int K, typename P, typename F>
+void transformif(multilevel_queue<Q, E, K> &q, P pred, F op) {
+	typename multilevel_queue<Q, E, K>::iterator i, ie;
+
+	for(i = q.begin(), ie = q.end(); i != ie; ++i)
+		if(pred(*i))
+			*i = op(*i);
+}
+
+// Operatori globali
+
+/**
+	@brief Ridefinizione dell'operatore di stream << per la coda a più livelli
+
+    @description
+	Ridefinizione dell'operatore di stream << per la stampa del contenuto
+	della coda a più livelli, nello stesso formato della classe queue,
+	con gli elementi nell'ordine di rimozione.
+
+	@param os oggetto di stream di output
+	@param q coda da stampare
+
+	@return riferimento allo stream di output
+*/
+template <typename T, typename E, unsigned int K>
+std::ostream &operator<<(std::ostream &os, const multilevel_queue<T, E, K> &q) {
+    return text::write_sequence(os, q.begin(), q.end(), q.size());
+}
+
+#endif
+
+// Fine file header multilevel_queue.h
@@ -17,8 +17,21 @@
 // Direttive per il pre-compilatore
 
 #include <ostream> // std::ostream
-#include <iterator> // std::forward_iterator_tag
+#include <istream> // std::istream
+#include <functional> // std::equal_to
+#include <iterator> // std::forward_iterator_tag, std::iterator_traits,
+                    // std::distance, std::make_move_iterator
 #include <cstddef> // std::ptrdiff_t
+#include <memory> // std::allocator, std::allocator_traits
+#include <utility> // std::swap, std::move, std::forward
+#include <type_traits> // std::true_type, std::false_type
+#if __cplusplus >= 201703L
+#include <memory_resource> // std::pmr::polymorphic_allocator
+#endif
+#include <string_view> // std::string_view
+#include "text_format.h" // text::write_sequence
+#include "binary_io.h" // binary::write_queue, binary::read_queue
+#include "text_parse.h" // text::read_sequence, text::parse_into
 #include "queue_exceptions.h" // empty_queue_exception,
                               // queue_iterator_out_of_bounds_exception
 
@@ -33,11 +46,20 @@
     L'ordine di inserimento determina l'anzianit dell'elemento.
     L'elemento rimosso  sempre il pi vecchio inserito nella coda.
     Le operazioni d'inserimento e rimozione sono eseguite in tempo costante.
+    La memoria degli elementi rimossi viene conservata in un pool interno
+    alla coda (fino a una capacit configurabile) e riutilizzata dai successivi
+    inserimenti: in un ciclo stazionario di inserimenti e rimozioni
+    l'allocatore non viene mai chiamato.
+    La memoria degli elementi  ottenuta dall'allocatore Allocator, riassociato
+    (rebind) al tipo degli elementi della coda: la copia, l'assegnamento
+    e lo scambio tra code seguono i traits di propagazione dell'allocatore.
 	
 	@tparam T tipo del valore degli elementi della coda
     @tparam E funtore di confronto di uguaglianza del valore di due elementi
+    @tparam Allocator allocatore degli elementi della coda
+            (default std::allocator<T>)
 */
-template <typename T, typename E>
+template <typename T, typename E, typename Allocator = std::allocator<T> >
 class queue {
 
     // Tipo di supporto privato della coda
@@ -47,6 +69,12 @@ class queue {
 
     // Strutture di supporto interne private della coda
 
+	/**
+		@brief Etichetta per la costruzione sul posto del valore
+		       di un elemento
+	*/
+	struct emplace_tag {};
+
 	/**
 		@brief Elemento della coda
 		
@@ -127,6 +155,39 @@ class queue {
 		element(const value_type &v, element *n) :
 			value(v), next(n) {} // initialization list
 
+		/**
+			@brief Costruttore secondario di spostamento
+
+			@description
+		    Costruttore secondario che permette di istanziare un elemento,
+			spostandone il valore anzich copiarlo.
+		    Il puntatore all'elemento successivo della coda  inizializzato
+		    a nullptr.
+
+			@param v valore dell'elemento da spostare
+		*/
+		explicit element(value_type &&v) :
+			value(std::move(v)), next(nullptr) {} // initialization list
+
+		/**
+			@brief Costruttore secondario di costruzione sul posto
+
+			@description
+		    Costruttore secondario che permette di istanziare un elemento,
+			costruendone il valore direttamente all'interno dell'elemento
+			a partire dagli argomenti del costruttore del tipo T.
+		    Il primo parametro serve solo a distinguere questo costruttore
+		    dagli altri costruttori secondari.
+
+			@tparam Args tipi degli argomenti del costruttore del tipo T
+
+			@param args argomenti del costruttore del tipo T
+		*/
+		template <typename... Args>
+		element(emplace_tag, Args&&... args) :
+			value(std::forward<Args>(args)...),
+			next(nullptr) {} // initialization list
+
 		/**
 			@brief Distruttore (METODO FONDAMENTALE)
 			
@@ -152,6 +213,28 @@ class queue {
 
 	}; // struct element
 
+	/**
+		@brief Nodo libero del pool della coda
+
+		@description
+	    Struttura di supporto interna privata della coda che rappresenta
+	    la memoria di un elemento distrutto, conservata nel pool per essere
+	    riutilizzata. Il puntatore al nodo libero successivo occupa
+	    la memoria che apparteneva all'elemento.
+	*/
+	struct pool_node {
+		pool_node *next; ///< @brief Puntatore al nodo libero successivo
+	};
+
+    // Tipi di supporto privati per l'allocazione degli elementi della coda
+    typedef typename std::allocator_traits<Allocator>::template
+        rebind_alloc<element> node_allocator; ///< @brief Allocatore
+                                              ///< degli elementi
+    typedef std::allocator_traits<node_allocator> node_traits; ///< @brief
+                                                               ///< Traits
+                                                               ///< dell'allo-
+                                                               ///< catore
+
 	// Dati membro privati della coda
 
 	element *_head; ///< @brief Puntatore all'elemento in testa alla coda
@@ -170,67 +253,428 @@ class queue {
     E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
                ///< del valore di due elementi della coda
 
+    node_allocator _alloc; ///< @brief Allocatore degli elementi della coda
+
+    pool_node *_pool; ///< @brief Lista dei nodi liberi del pool
+    size_type _pool_size; ///< @brief Numero di nodi liberi nel pool
+    size_type _pool_capacity; ///< @brief Numero massimo di nodi liberi
+                              ///< conservati nel pool
+    unsigned long _pool_hits; ///< @brief Numero di elementi istanziati
+                              ///< riutilizzando un nodo del pool
+    unsigned long _pool_misses; ///< @brief Numero di elementi istanziati
+                                ///< chiamando l'allocatore
+
     // Funzioni private della coda
 
     /**
-		@brief Rimozione dell'intero contenuto della coda
+		@brief Istanziamento di un nuovo elemento
 
 		@description
-        Funzione privata che rimuove tutti gli elementi della coda.
-        La rimozione viene effettuata ricorsivamente, chiamando la funzione
-        helper privata ricorsiva clear_helper(element *e), a partire
-        dall'elemento in testa alla coda.
-        Al puntatore alla coda viene assegnato il valore di default nullptr
-        (poich, al termine dell'esecuzione della funzione helper ricorsiva,
-        punta ad una locazione di memoria ora non pi valida).
-
-        @post La memoria allocata da tutti gli elementi della coda
-	          viene deallocata.
+        Funzione privata che istanzia un nuovo elemento, inoltrandone
+        gli argomenti al costruttore, riutilizzando un nodo libero del pool
+        se disponibile, altrimenti allocando nuova memoria.
+        Nel caso in cui la costruzione del valore lanci un'eccezione,
+        la memoria viene restituita al pool e l'eccezione viene propagata
+        alla funzione chiamante.
+
+        @tparam Args tipi degli argomenti del costruttore dell'elemento
+
+        @param args argomenti del costruttore dell'elemento
+
+        @return puntatore al nuovo elemento
+
+        @throw eccezione di allocazione di memoria
 	*/
-    void clear() {
-        clear_helper(_head);
-        _tail = nullptr;
+    template <typename... Args>
+    element *create_element(Args&&... args) {
+        element *p = acquire_node();
+        try {
+            node_traits::construct(_alloc, p, std::forward<Args>(args)...);
+            return p;
+        }
+        catch(...) {
+            release_node(p);
+            throw;
+        }
     }
 
-    // Funzioni helper private della coda
+    /**
+		@brief Distruzione di un elemento
+
+		@description
+        Funzione privata che distrugge un elemento e ne restituisce la memoria
+        al pool (oppure la dealloca, se il pool  pieno).
+
+        @param e puntatore all'elemento da distruggere
+	*/
+    void destroy_element(element *e) {
+        node_traits::destroy(_alloc, e);
+        release_node(e);
+    }
 
     /**
-		@brief Rimozione ricorsiva degli elementi della coda a partire
-        da un elemento (compreso)
+		@brief Acquisizione della memoria per un elemento
 
 		@description
-        Funzione helper privata che rimuove ricorsivamente gli elementi
-        della coda a partire da un elemento specificato attraverso il puntatore
-        ad element passato come parametro (compreso).
-        Ogni volta che la funzione viene chiamata ricorsivamente, vengono svolte
-        le seguenti operazioni:
-        la funzione rimuove prima gli elementi successivi all'elemento da cui
-        partire, richiamando la stessa funzione ricorsivamente;
-        dopodich, la memoria allocata dall'elemento da cui partire viene
-        deallocata e al puntatore all'elemento da cui partire viene assegnato
-        il valore di default nullptr (poich l'elemento a cui puntava  stato
-        rimosso, evitando, cos, che il puntatore punti ad una locazione
-        di memoria non pi valida);
-        infine, il numero di elementi inseriti nella coda viene decrementato
-        di un'unit.
+        Funzione privata che preleva un nodo libero dal pool, se presente,
+        oppure alloca la memoria per un nuovo elemento tramite l'allocatore
+        della coda, aggiornando i contatori del pool.
+
+        @return puntatore alla memoria non inizializzata di un elemento
+
+        @throw eccezione di allocazione di memoria
+	*/
+    element *acquire_node() {
+        if(_pool != nullptr) {
+            pool_node *n = _pool;
+            _pool = n->next;
+            _pool_size--;
+            _pool_hits++;
+            return reinterpret_cast<element *>(n);
+        }
+        _pool_misses++;
+        return node_traits::allocate(_alloc, 1);
+    }
+
+    /**
+		@brief Rilascio della memoria di un elemento
+
+		@description
+        Funzione privata che inserisce la memoria di un elemento gi distrutto
+        nel pool, se non  stata raggiunta la sua capacit, altrimenti
+        la restituisce all'allocatore della coda.
+
+        @param p puntatore alla memoria di un elemento gi distrutto
+	*/
+    void release_node(element *p) {
+        if(_pool_size < _pool_capacity) {
+            pool_node *n = reinterpret_cast<pool_node *>(p);
+            n->next = _pool;
+            _pool = n;
+            _pool_size++;
+        }
+        else
+            node_traits::deallocate(_alloc, p, 1);
+    }
+
+    /**
+		@brief Riduzione del pool
+
+		@description
+        Funzione privata che dealloca i nodi liberi del pool fino a lasciarne
+        al pi n.
+
+        @param n numero massimo di nodi liberi da conservare
+	*/
+    void trim_pool(size_type n) {
+        while(_pool_size > n) {
+            pool_node *next = _pool->next;
+            node_traits::deallocate(_alloc, reinterpret_cast<element *>(_pool),
+                                    1);
+            _pool = next;
+            _pool_size--;
+        }
+    }
+
+    /**
+		@brief Scambio degli elementi con un'altra coda
+
+		@description
+        Funzione privata che scambia gli elementi (testa, coda e dimensione)
+        della coda corrente con quelli di un'altra coda, senza scambiarne
+        gli allocatori n i pool.
+
+        @pre Gli allocatori delle due code devono essere uguali.
+
+        @param other coda con cui scambiare gli elementi
+	*/
+    void swap_elements(queue &other) {
+        std::swap(_head, other._head);
+        std::swap(_tail, other._tail);
+        std::swap(_size, other._size);
+    }
+
+    /**
+		@brief Scambio degli allocatori e dei pool con un'altra coda
+
+		@description
+        Funzione privata che scambia l'allocatore della coda corrente e i nodi
+        liberi del pool, che sono stati ottenuti da quell'allocatore,
+        con quelli di un'altra coda.
+        Il secondo parametro indica, a tempo di compilazione, se l'allocatore
+        si propaga: in caso contrario la funzione non compie alcuna
+        operazione (l'allocatore potrebbe non essere assegnabile, come
+        std::pmr::polymorphic_allocator).
+
+        @param other coda con cui scambiare allocatore e pool
+	*/
+    void swap_allocators(queue &other, std::true_type) {
+        using std::swap;
+        swap(_alloc, other._alloc);
+        std::swap(_pool, other._pool);
+        std::swap(_pool_size, other._pool_size);
+    }
+
+    /**
+		@brief Scambio degli allocatori e dei pool con un'altra coda,
+		       per allocatori che non si propagano
+
+		@param other coda con cui non scambiare allocatore e pool
+	*/
+    void swap_allocators(queue &, std::false_type) {}
+
+    /**
+		@brief Concatenamento di un nuovo elemento in coda alla coda
+
+		@param e puntatore al nuovo elemento da concatenare
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unit.
+	*/
+    void link_back(element *e) {
+		link_chain(e, e, 1);
+    }
+
+    /**
+		@brief Concatenamento di una catena di elementi in coda alla coda
+
+		@description
+        Funzione privata che concatena in tempo costante una catena
+        di elementi, gi collegati tra loro, in coda alla coda corrente,
+        gestendo anche il caso in cui la coda corrente sia vuota.
+
+		@param first puntatore al primo elemento della catena (oppure nullptr
+		       se la catena  vuota)
+		@param last puntatore all'ultimo elemento della catena
+		@param count numero di elementi della catena
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di count unit.
+	*/
+    void link_chain(element *first, element *last, size_type count) {
+        if(first == nullptr)
+            return;
+        last->next = nullptr;
+		if(_head == nullptr)
+		    _head = first;
+		else
+		    _tail->next = first;
+		_tail = last;
+
+		_size += count;
+    }
 
-		@param e puntatore all'elemento da cui iniziare la rimozione
-               degli elementi della coda
+    /**
+		@brief Distruzione di una catena di elementi
+
+		@description
+        Funzione privata che distrugge iterativamente una catena di elementi
+        non ancora concatenata alla coda, restituendone la memoria al pool.
+
+		@param first puntatore al primo elemento della catena (oppure nullptr)
+	*/
+    void destroy_chain(element *first) {
+        while(first != nullptr) {
+            element *next = first->next;
+            destroy_element(first);
+            first = next;
+        }
+    }
+
+    /**
+		@brief Rilascio di una catena di nodi non inizializzati
+		
+		@param n puntatore al primo nodo della catena (oppure nullptr)
+	*/
+    void release_nodes(pool_node *n) {
+        while(n != nullptr) {
+            pool_node *next = n->next;
+            release_node(reinterpret_cast<element *>(n));
+            n = next;
+        }
+    }
+
+    /**
+		@brief Inserimento di una sequenza identificata da iteratori di input
+
+		@description
+        Funzione privata che istanzia, uno alla volta, gli elementi
+        della sequenza in una catena separata, concatenata alla coda solo
+        al termine degli inserimenti.
+        Nel caso in cui venga lanciata un'eccezione, la catena viene distrutta
+        e la coda rimane allo stato precedente alla chiamata.
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+        @throw eccezione di allocazione di memoria
+	*/
+    template <typename IterT>
+    void enqueue_range(IterT begin, IterT end, std::input_iterator_tag) {
+        element *first = nullptr;
+        element *last = nullptr;
+        size_type count = 0;
+
+        try {
+            while(begin != end) {
+                element *e = create_element(static_cast<value_type>(*begin));
+                if(first == nullptr)
+                    first = e;
+                else
+                    last->next = e;
+                last = e;
+                ++count;
+                ++begin;
+            }
+        }
+        catch(...) {
+            if(last != nullptr)
+                last->next = nullptr;
+            destroy_chain(first);
+            throw;
+        }
+
+        link_chain(first, last, count);
+    }
+
+    /**
+		@brief Inserimento di una sequenza identificata da iteratori ad accesso
+		       casuale
+
+		@description
+        Funzione privata che calcola la lunghezza della sequenza tramite
+        std::distance e acquisisce in anticipo la memoria di tutti gli elementi
+        (dal pool, oppure tramite l'allocatore), prima di costruirne i valori:
+        in questo modo, un'eccezione di allocazione di memoria viene lanciata
+        prima di copiare qualunque valore.
+        Gli elementi vengono quindi costruiti in una catena separata,
+        concatenata alla coda solo al termine degli inserimenti.
+        Nel caso in cui venga lanciata un'eccezione, la catena e i nodi
+        non ancora utilizzati vengono restituiti al pool (oppure deallocati)
+        e la coda rimane allo stato precedente alla chiamata.
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+        @throw eccezione di allocazione di memoria
+	*/
+    template <typename IterT>
+    void enqueue_range(IterT begin, IterT end,
+                       std::random_access_iterator_tag) {
+        size_type count = static_cast<size_type>(std::distance(begin, end));
+        pool_node *nodes = nullptr;
+        try {
+            for(size_type i = 0; i < count; ++i) {
+                pool_node *n = reinterpret_cast<pool_node *>(acquire_node());
+                n->next = nodes;
+                nodes = n;
+            }
+        }
+        catch(...) {
+            release_nodes(nodes);
+            throw;
+        }
+
+        element *first = nullptr;
+        element *last = nullptr;
+        try {
+            while(begin != end) {
+                element *e = reinterpret_cast<element *>(nodes);
+                pool_node *next = nodes->next;
+                try {
+                    node_traits::construct(_alloc, e,
+                                           static_cast<value_type>(*begin));
+                }
+                catch(...) {
+                    // la costruzione fallita pu aver sovrascritto il nodo
+                    nodes->next = next;
+                    throw;
+                }
+                nodes = next;
+                if(first == nullptr)
+                    first = e;
+                else
+                    last->next = e;
+                last = e;
+                ++begin;
+            }
+        }
+        catch(...) {
+            release_nodes(nodes);
+            if(last != nullptr)
+                last->next = nullptr;
+            destroy_chain(first);
+            throw;
+        }
+
+        link_chain(first, last, count);
+    }
+
+    /**
+		@brief Rimozione dell'elemento in testa alla coda
+
+		@description
+        Funzione privata che distrugge il valore dell'elemento in testa
+        alla coda, restituendone la memoria al pool dei nodi
+        liberi (oppure deallocandola se il pool  pieno), e aggiorna
+        il puntatore all'elemento in testa alla coda.
+
+        @pre La coda non dev'essere vuota.
 
-        @post La memoria allocata dagli elementi della coda a partire da quello
-              specificato (compreso) viene deallocata.
         @post Il numero di elementi inseriti nella coda viene decrementato
-              di tante unit quanti sono gli elementi della coda a partire
-              da quello specificato (compreso).
-        @post Il puntatore alla coda punta ad una locazione di memoria ora
-              non pi valida.
+              di un'unit.
+	*/
+    void pop_head() {
+        element *first = _head;
+        _head = _head->next;
+        destroy_element(first);
+        first = nullptr;
+        _size--;
+    }
+
+    /**
+		@brief Assegnamento per spostamento con allocatore che si propaga
+
+		@description
+        Funzione privata che rimuove gli elementi della coda corrente,
+        ne adotta l'allocatore dell'altra coda e ne acquisisce gli elementi
+        in tempo costante.
+
+        @param other coda da cui spostare gli elementi
+	*/
+    void move_assign(queue &other, std::true_type) {
+        clear();
+        trim_pool(0);
+        _alloc = other._alloc;
+        swap_elements(other);
+    }
+
+    /**
+		@brief Assegnamento per spostamento con allocatore che non si propaga
+
+		@description
+        Funzione privata che rimuove gli elementi della coda corrente e,
+        se gli allocatori delle due code sono uguali, acquisisce gli elementi
+        dell'altra coda in tempo costante; altrimenti, sposta i valori
+        degli elementi uno alla volta in nuovi elementi, allocati tramite
+        l'allocatore della coda corrente.
+
+        @param other coda da cui spostare gli elementi
+
+        @throw eccezione di allocazione di memoria
 	*/
-    void clear_helper(element *e) {
-        if(e != nullptr) {
-            clear_helper(e->next);
-            delete e;
-            e = nullptr;
-            _size--;
+    void move_assign(queue &other, std::false_type) {
+        clear();
+        if(_alloc == other._alloc)
+            swap_elements(other);
+        else {
+            for(element *curr = other._head; curr != nullptr; curr = curr->next)
+                enqueue(std::move(curr->value));
+            other.clear();
         }
     }
 
@@ -253,12 +697,72 @@ public:
 	    a nullptr (la coda vuota non ha alcun elemento alla propria coda).
 	    Il numero di elementi inseriti nella coda vuota  inizializzato a 0
 	    (la coda vuota non presenta alcun elemento al suo interno).
+	    Il pool dei nodi liberi  inizialmente vuoto, con capacit
+	    DEFAULT_POOL_CAPACITY.
 
 		@note Questo  l'unico costruttore che pu essere utilizzato
 	          per istanziare un eventuale array di code.
 	*/
 	queue() :
-	    _head(nullptr), _tail(nullptr), _size(0) {} // initialization list
+	    _head(nullptr), _tail(nullptr), _size(0), _alloc(), _pool(nullptr),
+	    _pool_size(0), _pool_capacity(DEFAULT_POOL_CAPACITY), _pool_hits(0),
+	    _pool_misses(0) {} // initialization list
+
+	// Costruttori secondari della coda
+
+	/**
+		@brief Costruttore secondario
+
+		@description
+	    Costruttore secondario che permette di istanziare una coda vuota
+	    i cui elementi vengono allocati tramite l'allocatore passato
+	    come parametro (ad esempio, un allocatore che attinge da un'arena
+	    o da un buffer monotono).
+
+	    @note Questo costruttore  definito explicit per evitare conversioni
+	          di tipo implicite da Allocator a queue.
+
+		@param alloc allocatore degli elementi della coda
+	*/
+	explicit queue(const Allocator &alloc) :
+	    _head(nullptr), _tail(nullptr), _size(0), _alloc(alloc), _pool(nullptr),
+	    _pool_size(0), _pool_capacity(DEFAULT_POOL_CAPACITY), _pool_hits(0),
+	    _pool_misses(0) {} // initialization list
+
+	/**
+		@brief Costruttore di copia con allocatore
+
+		@description
+	    Costruttore secondario che permette di istanziare una coda con i valori
+	    presi da un'altra coda, allocandone gli elementi tramite l'allocatore
+	    passato come parametro anzich tramite quello della coda da copiare.
+	    In caso di eccezione di allocazione di memoria, la coda viene eliminata
+	    e l'eccezione viene propagata alla funzione chiamante.
+
+		@param other coda da copiare per istanziare quella corrente
+		@param alloc allocatore degli elementi della coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	queue(const queue &other, const Allocator &alloc) :
+	    _head(nullptr), _tail(nullptr), _size(0), _alloc(alloc), _pool(nullptr),
+	    _pool_size(0), _pool_capacity(other._pool_capacity), _pool_hits(0),
+	    _pool_misses(0) { // initialization list
+
+	    element *curr = other._head;
+
+        try {
+            while(curr != nullptr) {
+                enqueue(curr->value);
+                curr = curr->next;
+            }
+        }
+        catch(...) { // eccezione di allocazione di memoria
+            clear();
+            trim_pool(0);
+            throw;
+        }
+	}
 
 	/**
 		@brief Costruttore di copia/Copy Constructor (METODO FONDAMENTALE)
@@ -273,7 +777,12 @@ public:
 	    a nullptr;
 	    il puntatore all'elemento in coda alla coda  inizializzato
 	    a nullptr;
-	    il numero di elementi inseriti nella coda  inizializzato a 0.
+	    il numero di elementi inseriti nella coda  inizializzato a 0;
+	    il pool dei nodi liberi  inizializzato vuoto, con la stessa capacit
+	    del pool della coda da copiare;
+	    l'allocatore  quello restituito dal trait
+	    select_on_container_copy_construction applicato all'allocatore
+	    della coda da copiare.
 	    Dopodich, i valori degli elementi della coda da copiare
 	    vengono inseriti singolarmente, uno alla volta, nella coda corrente,
 	    mantenendo l'ordine originale (i puntatori alla testa e alla coda
@@ -293,7 +802,10 @@ public:
 		@throw eccezione di allocazione di memoria
 	*/
 	queue(const queue &other) :
-	    _head(nullptr), _tail(nullptr), _size(0) { // initialization list
+	    _head(nullptr), _tail(nullptr), _size(0),
+	    _alloc(node_traits::select_on_container_copy_construction(other._alloc)),
+	    _pool(nullptr), _pool_size(0), _pool_capacity(other._pool_capacity),
+	    _pool_hits(0), _pool_misses(0) { // initialization list
 
 	    element *curr = other._head;
 
@@ -305,10 +817,34 @@ public:
         }
         catch(...) { // eccezione di allocazione di memoria
             clear();
+            trim_pool(0);
             throw;
         }
 	}
 
+	/**
+		@brief Costruttore di spostamento/Move Constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di spostamento/Move Constructor della coda, che permette
+	    di istanziare una coda acquisendo in tempo costante gli elementi
+	    di un'altra coda, senza copiarne i valori.
+	    La coda da spostare rimane vuota; il suo pool dei nodi liberi
+	    non viene trasferito.
+
+		@param other coda da spostare per istanziare quella corrente
+	*/
+	queue(queue &&other) noexcept :
+	    _head(other._head), _tail(other._tail), _size(other._size),
+	    _alloc(other._alloc), _pool(nullptr), _pool_size(0),
+	    _pool_capacity(other._pool_capacity), _pool_hits(0),
+	    _pool_misses(0) { // initialization list
+
+	    other._head = nullptr;
+	    other._tail = nullptr;
+	    other._size = 0;
+	}
+
 	/**
 		@brief Operatore di assegnamento (METODO FONDAMENTALE)
 		
@@ -319,9 +855,12 @@ public:
 	    (che coincide con quella da copiare).
 	    In caso contrario, cio senza auto-assegnamento (la coda corrente e
 	    quella da copiare non coincidono), viene istanziata nello stack
-	    una nuova coda temporanea tmp, tramite il Copy Constructor,
-	    copiando i valori degli elementi della coda da copiare,
+	    una nuova coda temporanea tmp, tramite il costruttore di copia
+	    con allocatore, copiando i valori degli elementi della coda da copiare,
 	    passata come parametro.
+	    L'allocatore della coda temporanea  quello della coda da copiare
+	    se il trait propagate_on_container_copy_assignment dell'allocatore
+	     vero, altrimenti quello della coda corrente.
 	    I valori dei dati membro della coda corrente vengono scambiati
 	    con quelli dei dati membro della coda temporanea: in questo modo,
 	    i puntatori alla testa e alla coda della coda corrente puntano
@@ -329,6 +868,9 @@ public:
 	    alla testa e alla coda della coda da copiare;
 	    inoltre, il numero di elementi inseriti nella coda corrente  uguale
 	    al numero di elementi inseriti nella coda da copiare.
+	    Se l'allocatore viene propagato, vengono scambiati anche gli allocatori
+	    e i pool, cos che i vecchi elementi della coda corrente vengano
+	    deallocati dall'allocatore che li aveva allocati.
 	    La memoria allocata dalla coda temporanea viene deallocata
 	    automaticamente a fine scope, essendo un dato automatico istanziato
 	    nello stack.
@@ -353,14 +895,44 @@ public:
 	queue &operator=(const queue &other) {
 		// Per evitare l'auto-assegnamento (self-assignment: this = this)
 		if(this != &other) {
-			queue tmp(other);
-			std::swap(_head, tmp._head);
-            std::swap(_tail, tmp._tail);
-			std::swap(_size, tmp._size);
+		    typedef typename node_traits::propagate_on_container_copy_assignment
+		        propagate;
+			queue tmp(other, propagate::value ? Allocator(other._alloc)
+			                                  : Allocator(_alloc));
+			swap_elements(tmp);
+			swap_allocators(tmp, propagate());
 		}
 		return *this;
 	}
 
+	/**
+		@brief Operatore di assegnamento per spostamento (METODO FONDAMENTALE)
+
+		@description
+	    Operatore di assegnamento per spostamento della coda, che permette
+	    di acquisire gli elementi di un'altra coda senza copiarne i valori.
+	    Gli elementi della coda corrente vengono rimossi.
+	    Se il trait propagate_on_container_move_assignment dell'allocatore
+	     vero, oppure se gli allocatori delle due code sono uguali,
+	    gli elementi vengono acquisiti in tempo costante; altrimenti,
+	    i valori vengono spostati uno alla volta in nuovi elementi.
+	    In ogni caso, la coda spostata rimane vuota.
+
+		@param other coda come sorgente da spostare (operando di destra)
+
+		@return riferimento alla coda corrente (this)
+
+		@throw eccezione di allocazione di memoria (solo se l'allocatore
+		       non si propaga e i due allocatori sono diversi)
+	*/
+	queue &operator=(queue &&other)
+	    noexcept(node_traits::propagate_on_container_move_assignment::value) {
+		if(this != &other)
+		    move_assign(other, typename node_traits::
+		                           propagate_on_container_move_assignment());
+		return *this;
+	}
+
 	/**
 		@brief Distruttore (METODO FONDAMENTALE)
 		
@@ -369,8 +941,9 @@ public:
 	    permettendo la deallocazione implicita della memoria alla "morte"
 	    della coda.
 	    Ci avviene deallocando la memoria allocata da tutti i suoi elementi.
-	    Quest'ultima viene deallocata tramite una chiamata alla funzione privata
-	    clear(), che li dealloca ricorsivamente.
+	    Prima vengono deallocati tutti i nodi liberi del pool, la cui capacit
+	    viene azzerata; quindi gli elementi vengono deallocati iterativamente
+	    tramite una chiamata al metodo clear(), senza transitare dal pool.
 
 	    @note In questo modo, la deallocazione della memoria allocata
 	          da una coda comporta anche la deallocazione della memoria allocata
@@ -387,6 +960,7 @@ public:
 	          e da tutti i suoi elementi ora non sono pi valide.
 	*/
 	virtual ~queue() {
+		set_pool_capacity(0);
 		clear();
 	}
 	
@@ -408,6 +982,125 @@ public:
         return _size;
     }
 
+    /**
+		@brief Rimozione dell'intero contenuto della coda
+
+		@description
+        Metodo dell'interfaccia pubblica che rimuove tutti gli elementi
+        della coda, che rimane vuota e utilizzabile.
+        La rimozione viene effettuata iterativamente, a partire dall'elemento
+        in testa alla coda: lo spazio sullo stack  costante, qualunque sia
+        il numero di elementi.
+        La memoria degli elementi rimossi viene restituita al pool dei nodi
+        liberi fino alla sua capacit (in modo che i successivi inserimenti
+        possano riutilizzarla) e deallocata per i restanti elementi.
+        L'operazione di rimozione  eseguita in tempo lineare.
+
+        @post Il numero di elementi inseriti nella coda  pari a 0.
+        @post La memoria allocata dagli elementi della coda che non trovano
+	          posto nel pool viene deallocata.
+	*/
+    void clear() {
+        element *curr = _head;
+        while(curr != nullptr) {
+            element *next = curr->next;
+            destroy_element(curr);
+            curr = next;
+        }
+
+        _head = nullptr;
+        _tail = nullptr;
+        _size = 0;
+    }
+
+    /**
+        @brief Allocatore della coda
+
+        @return copia dell'allocatore degli elementi della coda
+    */
+    Allocator get_allocator() const {
+        return Allocator(_alloc);
+    }
+
+    /**
+        @brief Scambio del contenuto con un'altra coda
+
+        @description
+        Metodo dell'interfaccia pubblica che scambia in tempo costante
+        gli elementi della coda corrente con quelli di un'altra coda.
+        Se il trait propagate_on_container_swap dell'allocatore  vero,
+        vengono scambiati anche gli allocatori (insieme ai rispettivi pool);
+        altrimenti, gli allocatori delle due code devono essere uguali.
+
+        @param other coda con cui scambiare il contenuto
+    */
+    void swap(queue &other) {
+        swap_elements(other);
+        swap_allocators(other,
+                        typename node_traits::propagate_on_container_swap());
+    }
+
+    // Gestione del pool dei nodi liberi della coda
+
+    /**
+        @brief Capacit di default del pool dei nodi liberi
+    */
+    static const size_type DEFAULT_POOL_CAPACITY = 64;
+
+    /**
+        @brief Capacit del pool dei nodi liberi
+
+        @return numero massimo di nodi liberi conservati nel pool
+    */
+    size_type pool_capacity() const {
+        return _pool_capacity;
+    }
+
+    /**
+        @brief Impostazione della capacit del pool dei nodi liberi
+
+        @description
+        Metodo dell'interfaccia pubblica che imposta il numero massimo di nodi
+        liberi conservati nel pool per essere riutilizzati dai successivi
+        inserimenti. Se il pool contiene pi nodi della nuova capacit,
+        i nodi in eccesso vengono deallocati.
+        Una capacit pari a 0 disabilita il pool: ogni inserimento alloca
+        e ogni rimozione dealloca la memoria di un elemento.
+
+        @param n nuova capacit del pool
+    */
+    void set_pool_capacity(size_type n) {
+        _pool_capacity = n;
+        trim_pool(n);
+    }
+
+    /**
+        @brief Numero di nodi liberi nel pool
+
+        @return numero di nodi liberi attualmente conservati nel pool
+    */
+    size_type pool_size() const {
+        return _pool_size;
+    }
+
+    /**
+        @brief Numero di riutilizzi di nodi del pool
+
+        @return numero di elementi istanziati riutilizzando un nodo del pool
+    */
+    unsigned long pool_hits() const {
+        return _pool_hits;
+    }
+
+    /**
+        @brief Numero di allocazioni di nuovi nodi
+
+        @return numero di elementi istanziati chiamando l'allocatore
+    */
+    unsigned long pool_misses() const {
+        return _pool_misses;
+    }
+
 	/**
 		@brief Inserimento di un singolo elemento nella coda
 		
@@ -417,8 +1110,10 @@ public:
 	    L'ordine di inserimento determina l'anzianit dell'elemento
 	    (l'elemento inserito  il pi recente).
 	    L'operazione di inserimento  eseguita in tempo costante.
-	    Viene istanziato nell'heap un nuovo elemento dinamico, inizializzandolo
-	    con il valore passato come parametro.
+	    Viene istanziato un nuovo elemento dinamico, inizializzandolo
+	    con il valore passato come parametro: la sua memoria viene prelevata
+	    dal pool dei nodi liberi, se disponibile, altrimenti viene allocata
+	    nell'heap.
 	    Se la coda  vuota, il nuovo elemento viene inserito in testa
 	    (e, pertanto, ne diventa anche la coda).
 	    Altrimenti, il puntatore all'elemento successivo all'elemento in coda e
@@ -451,15 +1146,53 @@ public:
 		@throw eccezione di allocazione di memoria
 	*/
 	void enqueue(const value_type &value) {
-		element *tmp = new element(value);
+		link_back(create_element(value));
+	}
 
-		if(_head == nullptr)
-		    _head = tmp;
-		else
-		    _tail->next = tmp;
-		_tail = tmp;
+	/**
+		@brief Inserimento di un singolo elemento nella coda per spostamento
+
+		@overload enqueue
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, spostandone il valore nel nuovo elemento anzich copiarlo.
+	    Per il resto, si comporta come l'inserimento per copia.
+
+		@param value valore dell'elemento da spostare nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unit.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(value_type &&value) {
+		link_back(create_element(std::move(value)));
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento costruito sul posto
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, costruendone il valore direttamente all'interno del nuovo
+	    elemento a partire dagli argomenti del costruttore del tipo T,
+	    senza istanziare alcun valore temporaneo.
+	    Nel caso in cui venga lanciata un'eccezione, la coda rimane allo stato
+	    precedente alla chiamata.
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unit.
 
-		_size++;
+		@throw eccezione di allocazione di memoria
+	*/
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		link_back(create_element(emplace_tag(), std::forward<Args>(args)...));
 	}
 
     /**
@@ -469,31 +1202,26 @@ public:
         @overload enqueue
 
         @description
-        Metodo dell'interfaccia pubblica che inserisce nella coda un insieme
-        di elementi presi da una sequenza generica identificata
-        da due iteratori, che puntano, rispettivamente, all'inizio e alla fine
-        della sequenza.
-        La sequenza generica non  necessariamente un'altra coda e gli elementi
-        della sequenza generica non sono necessariamente dello stesso tipo T
-        degli elementi della coda (l'eventuale conversione tra i tipi
-         delegata alla funzione template static_cast<T>).
+        Metodo dell'interfaccia pubblica che inserisce nella coda gli elementi
+        di una sequenza generica identificata da due iteratori (la conversione
+        dei valori degli elementi della sequenza nel tipo T dei valori
+        degli elementi della coda  delegata alla funzione template
+        static_cast<T>).
         L'ordine di inserimento determina l'anzianit degli elementi.
-        Viene istanziata nello stack una coda temporanea, in cui vengono
-        inseriti, uno alla volta, gli elementi della sequenza, e la coda
-        temporanea viene concatenata a quella corrente.
-
-        Nel caso in cui, durante l'inserimento degli elementi nella coda
-        temporanea, venga lanciata un'eccezione di allocazione di memoria,
-        quest'ultima viene propagata alla funzione chiamante. Pertanto, spetta
-        all'utente gestirla adeguatamente nella funzione chiamante.
-
-        @note Non  necessario gestire quest'eccezione direttamente all'interno
-	          del metodo, poich, in caso di eccezione di allocazione
-	          di memoria durante l'inserimento degli elementi nella coda
-	          temporanea, quest'ultima, uscendo di scope, viene automaticamente
-	          deallocata, essendo un dato automatico istanziato nello stack,
-	          e la coda corrente rimane allo stato precedente alla chiamata
-	          del metodo.
+        Gli elementi della sequenza vengono istanziati, uno alla volta,
+        in una catena separata, che viene concatenata alla coda corrente
+        (anche se vuota) in tempo costante al termine degli inserimenti.
+        Se gli iteratori sono ad accesso casuale, la lunghezza
+        della sequenza viene calcolata in anticipo con std::distance
+        e la memoria di tutti gli elementi viene acquisita prima di copiarne
+        i valori.
+
+        Nel caso in cui, durante l'inserimento degli elementi, venga lanciata
+        un'eccezione, gli elementi gi istanziati vengono distrutti,
+        la coda corrente rimane allo stato precedente alla chiamata
+        del metodo e l'eccezione viene propagata alla funzione chiamante.
+        Pertanto, spetta all'utente gestirla adeguatamente nella funzione
+        chiamante.
 
         @pre Il tipo del valore degli elementi della sequenza deve essere
              convertibile nel tipo del valore degli elementi della coda.
@@ -509,24 +1237,50 @@ public:
         @post Il numero di elementi inseriti nella coda viene incrementato
               di tante unit quanti sono gli elementi della sequenza
               da inserire nella coda.
-        @post L'iteratore passato come primo parametro, che puntava all'inizio
-              della sequenza di elementi da inserire nella coda, ora punta
-              alla fine della stessa sequenza.
 
         @throw eccezione di allocazione di memoria
     */
     template <typename IterT>
     void enqueue(IterT begin, IterT end) {
-        queue tmp;
-        while(begin != end) {
-            tmp.enqueue(static_cast<value_type>(*begin));
-            ++begin;
-        }
+        enqueue_range(begin, end,
+                      typename std::iterator_traits<IterT>::iterator_category());
+    }
+
+    /**
+        @brief Concatenamento di un'altra coda in coda alla coda corrente
 
-        _tail->next = tmp._head;
-        _tail = tmp._tail;
-        _size += tmp._size;
-        tmp._head = nullptr;
+        @description
+        Metodo dell'interfaccia pubblica che sposta tutti gli elementi
+        di un'altra coda in coda alla coda corrente, mantenendone l'ordine.
+        Se gli allocatori delle due code sono uguali, gli elementi vengono
+        concatenati in tempo costante, senza copiarne n spostarne i valori
+        e senza allocare memoria; altrimenti, i valori vengono spostati
+        uno alla volta in nuovi elementi, allocati tramite l'allocatore
+        della coda corrente.
+        In ogni caso, l'altra coda rimane vuota.
+
+        @param other coda da concatenare
+
+        @post Il numero di elementi inseriti nella coda viene incrementato
+              di tante unit quanti erano gli elementi dell'altra coda.
+
+        @throw eccezione di allocazione di memoria (solo se gli allocatori
+               delle due code sono diversi)
+    */
+    void splice(queue &&other) {
+        if(this == &other || other._size == 0)
+            return;
+        if(_alloc == other._alloc) {
+            link_chain(other._head, other._tail, other._size);
+            other._head = nullptr;
+            other._tail = nullptr;
+            other._size = 0;
+        }
+        else {
+            enqueue(std::make_move_iterator(other.begin()),
+                    std::make_move_iterator(other.end()));
+            other.clear();
+        }
     }
 
     /**
@@ -534,7 +1288,8 @@ public:
 
         @description
         Metodo dell'interfaccia pubblica che rimuove l'elemento pi vecchio
-        della coda (l'elemento in testa alla coda).
+        della coda (l'elemento in testa alla coda) e ne restituisce il valore,
+        spostandolo anzich copiarlo.
         L'anzianit degli elementi  determinata dall'ordine di inserimento,
         pertanto l'elemento pi vecchio si trova in testa alla coda.
         L'operazione di rimozione  eseguita in tempo costante.
@@ -543,7 +1298,8 @@ public:
         aggiornato, puntando a tale elemento.
         L'elemento pi vecchio della coda (che in precedenza era in testa
         alla coda) viene rimosso dalla coda e la memoria da esso allocata
-        viene deallocata (poich non pu esistere un elemento che non sia
+        viene restituita al pool dei nodi liberi, oppure deallocata se il pool
+         pieno (poich non pu esistere un elemento che non sia
         presente all'interno di una coda): in questo modo, si evita memory leak.
         Inoltre, al puntatore temporaneo a questo elemento viene assegnato
         il valore di default nullptr (per evitare che punti ad una locazione
@@ -573,17 +1329,41 @@ public:
         if(_size == 0)
             throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
                                         "vecchio: la coda e' vuota.");
-        value_type removed_value = _head->value;
-
-        element *first = _head;
-        _head = _head->next;
-        delete first;
-        first = nullptr;
-        _size--;
+        value_type removed_value(std::move(_head->value));
+        pop_head();
 
         return removed_value;
     }
 
+    /**
+        @brief Rimozione dell'elemento pi vecchio della coda senza eccezioni
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non  vuota,
+        rimuove l'elemento pi vecchio della coda (l'elemento in testa
+        alla coda), spostandone il valore nel parametro passato per riferimento.
+        A differenza di dequeue, se la coda  vuota non viene lanciata alcuna
+        eccezione: la funzione restituisce false e il parametro non viene
+        modificato.  quindi adatta a consumatori che interrogano
+        ripetutamente la coda.
+        Se lo spostamento del valore lancia un'eccezione, la coda rimane
+        allo stato precedente alla chiamata.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento  stato rimosso, false se la coda  vuota
+
+        @post Se la coda non era vuota, il numero di elementi inseriti
+              nella coda viene decrementato di un'unit.
+    */
+    bool try_dequeue(value_type &out) {
+        if(_size == 0)
+            return false;
+        out = std::move(_head->value);
+        pop_head();
+        return true;
+    }
+
 	/**
 		@brief Accesso in lettura all'elemento pi recente della coda
 
@@ -708,6 +1488,69 @@ public:
         return false;
     }
 
+    /**
+		@brief Numero di elementi di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che conta gli elementi della coda
+        uguali al valore dato, passato come parametro, visitandoli tutti.
+
+		@param value valore degli elementi da contare
+
+		@return numero di elementi della coda del valore dato
+	*/
+    size_type count(const value_type &value) const {
+        size_type n = 0;
+        for(element *curr = _head; curr != nullptr; curr = curr->next)
+            if(_equals(curr->value, value))
+                ++n;
+        return n;
+    }
+
+    /**
+		@brief Rimozione degli elementi che soddisfano un predicato
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove dalla coda gli elementi
+        che soddisfano il predicato, con un'unica passata: gli elementi
+        rimossi vengono scollegati dalla lista e la loro memoria restituita
+        al pool, senza spostare n copiare gli altri valori.
+        Il predicato viene chiamato una sola volta per ogni elemento,
+        in ordine FIFO.
+
+		@param pred predicato che gli elementi devono soddisfare per essere
+               rimossi
+
+		@return numero di elementi rimossi
+
+        @throw eccezione lanciata da pred: gli elementi gi esaminati
+               restano rimossi, gli altri vengono mantenuti
+	*/
+    template <typename P>
+    size_type remove_if(P pred) {
+        size_type removed = 0;
+        element **link = &_head;
+        element *last = nullptr;
+
+        while(*link != nullptr) {
+            element *curr = *link;
+            if(pred(curr->value)) {
+                *link = curr->next;
+                if(curr == _tail)
+                    _tail = last;
+                destroy_element(curr);
+                _size--;
+                ++removed;
+            }
+            else {
+                last = curr;
+                link = &curr->next;
+            }
+        }
+
+        return removed;
+    }
+
     // Supporto agli iteratori della coda
 
     class const_iterator; // forward declaration dell'iteratore costante
@@ -1457,6 +2300,37 @@ public:
         return const_iterator(nullptr);
     }
 
+    /**
+		@brief Ricerca del primo elemento di un certo valore dato
+
+        @description
+		Funzione membro che restituisce un iteratore al primo elemento
+        (il pi vecchio) della coda uguale al valore dato.
+
+		@param value valore dell'elemento da cercare
+
+		@return iteratore al primo elemento del valore dato, oppure end()
+	*/
+    iterator find(const value_type &value) {
+        element *curr = _head;
+        while(curr != nullptr && !_equals(curr->value, value))
+            curr = curr->next;
+        return iterator(curr);
+    }
+
+    /**
+		@overload find
+
+		@return iteratore costante al primo elemento del valore dato,
+		        oppure end()
+	*/
+    const_iterator find(const value_type &value) const {
+        const element *curr = _head;
+        while(curr != nullptr && !_equals(curr->value, value))
+            curr = curr->next;
+        return const_iterator(curr);
+    }
+
 }; // class queue
 
 // Funzioni globali
@@ -1476,6 +2350,7 @@ public:
     @tparam Q tipo del valore degli elementi della coda
     @tparam E funtore di confronto di uguaglianza del valore di due elementi
             della coda
+    @tparam A allocatore degli elementi della coda
     @tparam P tipo del predicato
     @tparam F tipo dell'operatore generico
 	
@@ -1485,15 +2360,15 @@ public:
     @param op operatore generico con cui modificare i valori contenuti
            nella coda
 */
-template <typename Q, typename E, typename P, typename F>
-void transformif(queue<Q, E> &q, P pred, F op) {
+template <typename Q, typename E, typename A, typename P, typename F>
+void transformif(queue<Q, E, A> &q, P pred, F op) {
 
     /*
         La keyword "typename"  necessaria per specificare che iterator
         non  un dato membro della classe template queue, bens un tipo
         (in questo caso, una classe) definito al suo interno.
     */
-	typename queue<Q, E>::iterator i, ie;
+	typename queue<Q, E, A>::iterator i, ie;
 
 	for(i = q.begin(), ie = q.end(); i != ie; ++i)
 		if(pred(*i))
@@ -1508,37 +2383,153 @@ void transformif(queue<Q, E> &q, P pred, F op) {
     @description
 	Ridefinizione dell'operatore di stream << per la stampa del contenuto
 	della coda.
+    Gli elementi vengono formattati in un buffer e scritti sullo stream
+    a blocchi (vedi text::write_sequence); per stampare solo i primi
+    e gli ultimi elementi si pu usare os << text::print(q, head, tail).
 
     @tparam T tipo del valore degli elementi della coda da stampare
     @tparam E funtore di confronto di uguaglianza del valore di due elementi
             della coda
+    @tparam A allocatore degli elementi della coda
 
 	@param os oggetto di stream di output
 	@param q coda da stampare
 
 	@return riferimento allo stream di output
 */
-template <typename T, typename E>
-std::ostream &operator<<(std::ostream &os, const queue<T, E> &q) {
+template <typename T, typename E, typename A>
+std::ostream &operator<<(std::ostream &os, const queue<T, E, A> &q) {
+    return text::write_sequence(os, q.begin(), q.end(), q.size());
+}
 
-    /*
-        La keyword "typename"  necessaria per specificare che const_iterator
-        non  un dato membro della classe template queue, bens un tipo
-        (in questo caso, una classe) definito al suo interno.
-    */
-    typename queue<T, E>::const_iterator i, ie;
+/**
+	@brief Ridefinizione dell'operatore di stream >> per la coda
 
-    os << "[";
-    for(i = q.begin(), ie = q.end(); i != ie; ++i) {
-        if(i != q.begin())
-            os << ", ";
-        os << *i;
-    }
-    os << "]";
+    @description
+	Ridefinizione dell'operatore di stream >> per la lettura di una coda
+	nel formato [a, b, c] prodotto dall'operatore di stream <<, che
+	sostituisce il contenuto della coda q (vedi text::read_sequence).
+    In caso di testo non valido viene impostato il failbit dello stream
+    e la coda non viene modificata.
+
+    @tparam T tipo del valore degli elementi della coda da leggere
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam A allocatore degli elementi della coda
+
+	@param is oggetto di stream di input
+	@param q coda da leggere
+
+	@return riferimento allo stream di input
+*/
+template <typename T, typename E, typename A>
+std::istream &operator>>(std::istream &is, queue<T, E, A> &q) {
+    return text::read_sequence(is, q);
+}
+
+/**
+	@brief Serializzazione binaria della coda
+
+    @description
+	Funzione globale che scrive sullo stream os la coda q nel formato
+    binario versionato di binary::write_queue: un'intestazione con il numero
+    di elementi seguita dai valori. Se il tipo degli elementi  banalmente
+    copiabile i valori vengono copiati a blocchi; per gli altri tipi va
+    specializzato binary::codec (std::string  gi supportato). Lo stream va
+    aperto in modalit binaria.
 
-    return os;
+	@param os oggetto di stream di output
+	@param q coda da scrivere
+
+    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+*/
+template <typename T, typename E, typename A>
+void serialize(std::ostream &os, const queue<T, E, A> &q) {
+    binary::write_queue(os, q);
+}
+
+/**
+	@brief Deserializzazione binaria della coda
+
+    @description
+	Funzione globale che legge dallo stream is una coda scritta da serialize
+    e la sostituisce al contenuto di q; se i dati non sono validi q non
+    viene modificata. Dallo stream vengono letti solo i byte della coda.
+
+	@param is oggetto di stream di input
+	@param q coda da sostituire
+
+    @throw serialize_queue_exception se l'intestazione non  valida
+           o i dati sono troncati
+*/
+template <typename T, typename E, typename A>
+void deserialize(std::istream &is, queue<T, E, A> &q) {
+    binary::read_queue(is, q);
 }
 
+/**
+	@brief Lettura di una coda da un testo
+
+    @description
+	Funzione globale che crea una coda a partire dal testo s nel formato
+    [a, b, c] prodotto dall'operatore di stream <<. I valori aritmetici
+    vengono letti con std::from_chars e gli elementi inseriti a blocchi
+    (vedi text::parse_into); per gli altri tipi va specializzato
+    text::parser.
+
+    @tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+
+	@param s testo da leggere
+
+	@return coda con gli elementi letti
+
+    @throw parse_queue_exception se il testo non rispetta il formato
+*/
+template <typename T, typename E = std::equal_to<T> >
+queue<T, E> parse_queue(std::string_view s) {
+    queue<T, E> q;
+    text::parse_into(s, q);
+    return q;
+}
+
+/**
+	@brief Scambio del contenuto di due code
+
+    @description
+	Funzione globale che scambia il contenuto di due code, delegando
+    al metodo swap della classe queue.
+
+	@param q1 prima coda
+	@param q2 seconda coda
+*/
+template <typename T, typename E, typename A>
+void swap(queue<T, E, A> &q1, queue<T, E, A> &q2) {
+    q1.swap(q2);
+}
+
+#if __cplusplus >= 201703L
+
+/**
+	@brief Code con allocatore polimorfico
+
+    @description
+	Namespace con l'alias della classe queue che utilizza
+    std::pmr::polymorphic_allocator: una coda pmr::queue pu attingere
+    la memoria dei propri elementi da una qualunque std::pmr::memory_resource,
+    ad esempio da un std::pmr::monotonic_buffer_resource, la cui memoria
+    viene rilasciata in un'unica operazione.
+*/
+namespace pmr {
+
+template <typename T, typename E>
+using queue = ::queue<T, E, std::pmr::polymorphic_allocator<T> >;
+
+} // namespace pmr
+
+#endif
+
 #endif
 
 // Fine file header queue.h
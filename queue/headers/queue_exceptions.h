@@ -6,7 +6,9 @@
 
     @description
     File header con la dichiarazione delle classi di eccezioni custom
-    empty_queue_exception e queue_iterator_out_of_bounds_exception.
+    empty_queue_exception, queue_iterator_out_of_bounds_exception,
+    full_queue_exception, invalid_level_exception, parse_queue_exception
+    e serialize_queue_exception.
 */
 
 // Guardie del file header queue_exceptions.h
@@ -17,6 +19,7 @@
 // Direttive per il pre-compilatore
 
 #include <string> // std::string
+#include <cstddef> // std::size_t
 
 // Dichiarazione della classe eccezione custom empty_queue_exception
 
@@ -98,6 +101,174 @@ public:
 	std::string what() const;
 };
 
+// Dichiarazione della classe eccezione custom full_queue_exception
+
+/**
+	@brief Eccezione di coda piena
+
+    @description
+	Classe eccezione custom di coda piena.
+	Viene lanciata quando si prova a inserire un elemento in una coda
+    a capacità limitata che ha già raggiunto la propria capacità.
+*/
+class full_queue_exception {
+	
+	std::string _message; ///< @brief Messaggio di errore
+
+public:
+	
+	/**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia un'eccezione di coda piena, inizializzandola
+	    con il messaggio di errore.
+
+	    @param message messaggio di errore
+	*/
+    full_queue_exception(const std::string &message);
+	
+	/**
+		@brief Messaggio di errore
+
+		@description
+		Metodo che restituisce il messaggio di errore dell'eccezione di coda
+	    piena.
+		
+		@return messaggio di errore
+	*/
+	std::string what() const;
+};
+
+// Dichiarazione della classe eccezione custom invalid_level_exception
+
+/**
+	@brief Eccezione di livello di priorità non valido
+
+    @description
+	Classe eccezione custom di livello di priorità non valido.
+	Viene lanciata quando si prova a inserire un elemento in un livello
+    di priorità non esistente di una coda a più livelli.
+*/
+class invalid_level_exception {
+	
+	std::string _message; ///< @brief Messaggio di errore
+
+public:
+	
+	/**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia un'eccezione di livello di priorità
+	    non valido, inizializzandola con il messaggio di errore.
+
+	    @param message messaggio di errore
+	*/
+    invalid_level_exception(const std::string &message);
+	
+	/**
+		@brief Messaggio di errore
+
+		@description
+		Metodo che restituisce il messaggio di errore dell'eccezione
+	    di livello di priorità non valido.
+		
+		@return messaggio di errore
+	*/
+	std::string what() const;
+};
+
+// Dichiarazione della classe eccezione custom parse_queue_exception
+
+/**
+	@brief Eccezione di lettura di una coda
+
+    @description
+	Classe eccezione custom di lettura di una coda.
+	Viene lanciata quando il testo da cui si legge una coda non rispetta
+    il formato [a, b, c] dell'operatore di stream <<.
+*/
+class parse_queue_exception {
+
+	std::string _message; ///< @brief Messaggio di errore
+	std::size_t _position; ///< @brief Posizione dell'errore nel testo
+
+public:
+
+	/**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia un'eccezione di lettura di una coda,
+	    inizializzandola con il messaggio di errore e la posizione
+	    del carattere del testo in cui è stato rilevato l'errore.
+
+	    @param message messaggio di errore
+	    @param position posizione dell'errore nel testo
+	*/
+    parse_queue_exception(const std::string &message, std::size_t position);
+	
+	/**
+		@brief Messaggio di errore
+
+		@description
+		Metodo che restituisce il messaggio di errore dell'eccezione
+	    di lettura di una coda.
+		
+		@return messaggio di errore
+	*/
+	std::string what() const;
+
+	/**
+		@brief Posizione dell'errore
+
+		@return posizione, dall'inizio del testo, del carattere in cui
+		        è stato rilevato l'errore
+	*/
+	std::size_t position() const;
+};
+
+// Dichiarazione della classe eccezione custom serialize_queue_exception
+
+/**
+	@brief Eccezione di serializzazione di una coda
+
+    @description
+	Classe eccezione custom di serializzazione binaria di una coda.
+	Viene lanciata quando non si riesce a scrivere una coda su uno stream
+    o quando i dati binari da cui si legge una coda non sono validi
+    (intestazione errata, versione non supportata, dati troncati).
+*/
+class serialize_queue_exception {
+
+	std::string _message; ///< @brief Messaggio di errore
+
+public:
+
+	/**
+		@brief Costruttore
+
+	    @description
+		Costruttore che istanzia un'eccezione di serializzazione di una coda,
+	    inizializzandola con il messaggio di errore.
+
+	    @param message messaggio di errore
+	*/
+    serialize_queue_exception(const std::string &message);
+	
+	/**
+		@brief Messaggio di errore
+
+		@description
+		Metodo che restituisce il messaggio di errore dell'eccezione
+	    di serializzazione di una coda.
+		
+		@return messaggio di errore
+	*/
+	std::string what() const;
+};
+
 #endif
 
 // Fine file header queue_exceptions.h
@@ -0,0 +1,1551 @@
+/**
+	@headerfile ring_queue.h
+
+    @brief Dichiarazione e definizione della classe ring_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    ring_queue, una coda FIFO con la stessa interfaccia della classe queue
+    ma con gli elementi memorizzati in un buffer circolare contiguo,
+    di una funzione globale transformif e della ridefinizione dell'operatore
+    di stream << per la classe ring_queue.
+*/
+
+// Guardie del file header ring_queue.h
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <ostream> // std::ostream
+#include <istream> // std::istream
+#include <iterator> // std::forward_iterator_tag, std::iterator_traits,
+                    // std::distance, std::make_move_iterator
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator
+#include <new> // placement new
+#include <utility> // std::swap, std::move_if_noexcept, std::move,
+                   // std::forward
+#include <type_traits> // std::is_trivially_destructible,
+                       // std::is_trivially_copyable, std::is_same
+#include <stdexcept> // std::length_error
+#include <exception> // std::exception_ptr, std::current_exception,
+                     // std::rethrow_exception
+#include "simd_search.h" // is_simd_searchable, simd::find, simd::count
+#include "text_format.h" // text::write_sequence
+#include "binary_io.h" // binary::write_queue, binary::read_queue
+#include "text_parse.h" // text::read_sequence
+#include "queue_exceptions.h" // empty_queue_exception,
+                              // queue_iterator_out_of_bounds_exception
+
+// Dichiarazione e definizione della classe template ring_queue
+
+/**
+	@brief Coda FIFO circolare
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    con la stessa interfaccia e la stessa semantica della classe queue.
+    Gli elementi sono memorizzati in un unico buffer circolare contiguo,
+    la cui capacità è sempre una potenza di 2: la testa e la coda della coda
+    sono indici nel buffer, che avanzano modulo la capacità.
+    Quando il buffer è pieno, la sua capacità viene raddoppiata
+    e gli elementi vengono trasferiti, in ordine, nel nuovo buffer.
+    La scansione degli elementi (iteratori, contains) avviene su al più
+    due tratti di memoria contigua.
+    Le operazioni d'inserimento (in tempo costante ammortizzato) e rimozione
+    (in tempo costante) non richiedono allocazioni, salvo la crescita
+    del buffer.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class ring_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+    /**
+        @brief Capacità minima del buffer, allocata al primo inserimento
+    */
+    static const size_type MIN_CAPACITY = 16;
+
+    /**
+        @brief Capacità massima del buffer, la massima potenza di 2
+               rappresentabile con size_type
+    */
+    static const size_type MAX_CAPACITY = size_type(1) << 31;
+
+    /**
+        @brief Sequenze copiabili in blocco
+
+        @description
+        Vale true se IterT è un puntatore al tipo degli elementi e questo
+        è banalmente copiabile: l'inserimento di un intervallo copia allora
+        i valori con std::memcpy invece che uno alla volta.
+    */
+    template <typename IterT>
+    struct is_bulk_copyable : std::integral_constant<bool,
+        std::is_trivially_copyable<value_type>::value &&
+        (std::is_same<IterT, value_type *>::value ||
+         std::is_same<IterT, const value_type *>::value)> {};
+
+	// Dati membro privati della coda
+
+	value_type *_buffer; ///< @brief Buffer circolare (oppure nullptr)
+	size_type _capacity; ///< @brief Capacità del buffer (potenza di 2 oppure 0)
+	size_type _head; ///< @brief Indice dell'elemento in testa alla coda
+	size_type _tail; ///< @brief Indice della posizione successiva
+	                 ///< all'elemento in coda alla coda
+	size_type _size; ///< @brief Numero di elementi inseriti nella coda
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi della coda
+
+    // Funzioni private della coda
+
+    /**
+		@brief Allocazione di un buffer non inizializzato
+
+		@param n capacità del buffer
+
+		@return puntatore al buffer
+
+		@throw eccezione di allocazione di memoria
+	*/
+    static value_type *allocate(size_type n) {
+        return std::allocator<value_type>().allocate(n);
+    }
+
+    /**
+		@brief Deallocazione di un buffer
+
+		@param p puntatore al buffer (oppure nullptr)
+		@param n capacità del buffer
+	*/
+    static void deallocate(value_type *p, size_type n) {
+        if(p != nullptr)
+            std::allocator<value_type>().deallocate(p, n);
+    }
+
+    /**
+		@brief Indice fisico nel buffer di una posizione logica
+
+		@param i posizione logica (0 è la testa della coda)
+
+		@return indice nel buffer
+	*/
+    size_type index(size_type i) const {
+        return (_head + i) & (_capacity - 1);
+    }
+
+    /**
+		@brief Riallocazione del buffer
+
+		@description
+        Funzione privata che trasferisce gli elementi della coda, in ordine,
+        in un nuovo buffer di capacità n, a partire dall'indice 0.
+        I valori vengono spostati se il loro costruttore di spostamento
+        non lancia eccezioni, altrimenti vengono copiati: in caso
+        di eccezione la coda rimane allo stato precedente alla chiamata.
+
+        @pre n dev'essere una potenza di 2 non inferiore a size().
+
+		@param n capacità del nuovo buffer
+
+		@throw eccezione di allocazione di memoria
+	*/
+    void reallocate(size_type n) {
+        value_type *buffer = allocate(n);
+        size_type i = 0;
+
+        try {
+            for(; i < _size; ++i)
+                new (buffer + i) value_type(
+                    std::move_if_noexcept(_buffer[index(i)]));
+        }
+        catch(...) {
+            while(i > 0)
+                buffer[--i].~value_type();
+            deallocate(buffer, n);
+            throw;
+        }
+
+        for(i = 0; i < _size; ++i)
+            _buffer[index(i)].~value_type();
+        deallocate(_buffer, _capacity);
+
+        _buffer = buffer;
+        _capacity = n;
+        _head = 0;
+        _tail = _size & (n - 1);
+    }
+
+    /**
+		@brief Crescita geometrica del buffer se pieno
+
+		@throw std::length_error se il buffer ha già la capacità massima
+		@throw eccezione di allocazione di memoria
+	*/
+    void grow_if_full() {
+        if(_size == _capacity) {
+            if(_capacity == MAX_CAPACITY)
+                throw std::length_error("ring_queue: capacita' massima "
+                                        "raggiunta");
+            size_type c = MIN_CAPACITY;
+            if(_capacity > 0)
+                c = 2 * _capacity;
+            reallocate(c);
+        }
+    }
+
+    /**
+		@brief Riserva di capacità per altri n elementi
+
+		@description
+        Funzione privata che garantisce che la coda possa contenere altri
+        n elementi, verificando che il totale non superi la capacità massima.
+
+        @param n numero di elementi da aggiungere
+
+		@throw std::length_error se la capacità massima non è sufficiente
+		@throw eccezione di allocazione di memoria
+	*/
+    void reserve_more(std::size_t n) {
+        if(n > MAX_CAPACITY - _size)
+            throw std::length_error("ring_queue: capacita' massima "
+                                    "superata");
+        reserve(_size + static_cast<size_type>(n));
+    }
+
+    /**
+		@brief Riserva di capacità per una sequenza identificata da iteratori
+		       di input
+
+		@description
+        Per iteratori che non sono ad accesso casuale, la lunghezza
+        della sequenza non è nota in anticipo e il buffer cresce durante
+        gli inserimenti.
+	*/
+    template <typename IterT>
+    void reserve_range(IterT, IterT, std::input_iterator_tag) {}
+
+    /**
+		@brief Riserva di capacità per una sequenza identificata da iteratori
+		       ad accesso casuale
+
+		@description
+        Funzione privata che calcola la lunghezza della sequenza tramite
+        std::distance e riserva la capacità necessaria a inserirla.
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+		@throw eccezione di allocazione di memoria
+	*/
+    template <typename IterT>
+    void reserve_range(IterT begin, IterT end,
+                       std::random_access_iterator_tag) {
+        reserve_more(static_cast<std::size_t>(std::distance(begin, end)));
+    }
+
+    /**
+		@brief Rimozione degli ultimi elementi inseriti
+
+		@description
+        Funzione privata che distrugge gli elementi in coda alla coda fino
+        a riportarla a n elementi.
+
+		@param n numero di elementi da mantenere
+	*/
+    void truncate(size_type n) {
+        while(_size > n) {
+            _tail = (_tail - 1) & (_capacity - 1);
+            _buffer[_tail].~value_type();
+            _size--;
+        }
+    }
+
+    /**
+		@brief Scambio dei dati membro con un'altra coda
+
+		@param other coda con cui scambiare i dati membro
+	*/
+    void swap_members(ring_queue &other) {
+        std::swap(_buffer, other._buffer);
+        std::swap(_capacity, other._capacity);
+        std::swap(_head, other._head);
+        std::swap(_tail, other._tail);
+        std::swap(_size, other._size);
+    }
+
+    /**
+		@brief Costruzione di un nuovo valore in coda alla coda
+
+		@description
+        Funzione privata che costruisce un nuovo valore nella posizione
+        successiva all'elemento in coda, inoltrandone gli argomenti
+        al costruttore del tipo T.
+        Se il buffer è pieno, la sua capacità viene prima raddoppiata.
+
+        @tparam Args tipi degli argomenti del costruttore del tipo T
+
+        @param args argomenti del costruttore del tipo T
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+        @throw eccezione di allocazione di memoria
+	*/
+    template <typename... Args>
+    void construct_back(Args&&... args) {
+		grow_if_full();
+		new (_buffer + _tail) value_type(std::forward<Args>(args)...);
+		_tail = (_tail + 1) & (_capacity - 1);
+		_size++;
+    }
+
+    /**
+		@brief Rimozione dell'elemento in testa alla coda
+
+		@description
+        Funzione privata che distrugge il valore dell'elemento in testa
+        alla coda, riportando gli indici all'inizio del buffer
+        se la coda si svuota.
+
+        @pre La coda non dev'essere vuota.
+
+        @post Il numero di elementi inseriti nella coda viene decrementato
+              di un'unità.
+	*/
+    void pop_head() {
+        _buffer[_head].~value_type();
+        _head = (_head + 1) & (_capacity - 1);
+        _size--;
+        if(_size == 0) {
+            _head = 0;
+            _tail = 0;
+        }
+    }
+
+    /**
+		@brief Deallocazione del buffer
+
+		@pre La coda dev'essere vuota.
+	*/
+    void release_buffer() {
+        deallocate(_buffer, _capacity);
+        _buffer = nullptr;
+        _capacity = 0;
+    }
+
+    /**
+		@brief Ricerca di un valore in un tratto contiguo del buffer
+
+		@description
+        Funzione privata che cerca il primo elemento uguale al valore dato
+        tra gli n elementi a partire da p. Se il funtore E equivale a ==
+        e T è un tipo aritmetico supportato (is_simd_searchable),
+        i confronti sono vettoriali; altrimenti il funtore viene chiamato
+        su un elemento alla volta.
+
+		@param p puntatore al primo elemento del tratto
+		@param n numero di elementi del tratto
+		@param value valore da cercare
+
+		@return indice nel tratto del primo elemento uguale, oppure n
+	*/
+    size_type find_in(const value_type *p, size_type n,
+                      const value_type &value) const {
+        if constexpr(is_simd_searchable<T, E>::value)
+            return static_cast<size_type>(simd::find(p, n, value));
+        else {
+            for(size_type i = 0; i < n; ++i)
+                if(_equals(p[i], value))
+                    return i;
+            return n;
+        }
+    }
+
+    /**
+		@brief Conteggio di un valore in un tratto contiguo del buffer
+
+		@param p puntatore al primo elemento del tratto
+		@param n numero di elementi del tratto
+		@param value valore da contare
+
+		@return numero di elementi del tratto uguali al valore
+	*/
+    size_type count_in(const value_type *p, size_type n,
+                       const value_type &value) const {
+        if constexpr(is_simd_searchable<T, E>::value)
+            return static_cast<size_type>(simd::count(p, n, value));
+        else {
+            size_type c = 0;
+            for(size_type i = 0; i < n; ++i)
+                if(_equals(p[i], value))
+                    ++c;
+            return c;
+        }
+    }
+
+    /**
+		@brief Lunghezza del primo tratto contiguo della coda
+
+		@return numero di elementi dalla testa alla fine del buffer
+		        (oppure fino alla coda, se la coda non fa il giro del buffer)
+	*/
+    size_type first_span() const {
+        return (_capacity - _head < _size) ? _capacity - _head : _size;
+    }
+
+    /**
+		@brief Posizione del primo elemento di un certo valore
+
+		@param value valore da cercare
+
+		@return posizione logica (0 è la testa) del primo elemento uguale
+		        al valore, oppure size() se non esiste
+	*/
+    size_type find_position(const value_type &value) const {
+        if(_size == 0)
+            return 0;
+        size_type first = first_span();
+        size_type i = find_in(_buffer + _head, first, value);
+        if(i < first)
+            return i;
+        return first + find_in(_buffer, _size - first, value);
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore di default (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di default per istanziare una coda vuota.
+	    Il buffer viene allocato al primo inserimento.
+	*/
+	ring_queue() :
+	    _buffer(nullptr), _capacity(0), _head(0), _tail(0),
+	    _size(0) {} // initialization list
+
+	/**
+		@brief Costruttore di copia/Copy Constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di copia/Copy Constructor della coda, che permette
+	    di istanziare una coda con i valori presi da un'altra coda,
+	    mantenendo l'ordine originale.
+	    Il buffer viene allocato una sola volta, con la capacità minima
+	    sufficiente a contenere gli elementi da copiare.
+
+	    Nel caso in cui venga lanciata un'eccezione durante la copia,
+	    la coda corrente viene eliminata completamente e l'eccezione
+	    viene propagata alla funzione chiamante.
+
+		@param other coda da copiare per istanziare quella corrente
+
+		@throw eccezione di allocazione di memoria
+	*/
+	ring_queue(const ring_queue &other) :
+	    _buffer(nullptr), _capacity(0), _head(0), _tail(0),
+	    _size(0) { // initialization list
+
+        try {
+            reserve(other._size);
+            enqueue(other.begin(), other.end());
+        }
+        catch(...) {
+            clear();
+            release_buffer();
+            throw;
+        }
+	}
+
+	/**
+		@brief Costruttore di spostamento/Move Constructor (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore di spostamento/Move Constructor della coda, che permette
+	    di istanziare una coda acquisendo in tempo costante il buffer
+	    di un'altra coda, senza copiarne i valori.
+	    La coda da spostare rimane vuota.
+
+		@param other coda da spostare per istanziare quella corrente
+	*/
+	ring_queue(ring_queue &&other) noexcept :
+	    _buffer(nullptr), _capacity(0), _head(0), _tail(0),
+	    _size(0) { // initialization list
+
+	    swap_members(other);
+	}
+
+	/**
+		@brief Operatore di assegnamento (METODO FONDAMENTALE)
+
+		@description
+	    Operatore di assegnamento della coda, che permette la copia tra code.
+	    La copia avviene tramite una coda temporanea, i cui dati membro
+	    vengono scambiati con quelli della coda corrente.
+
+		@param other coda come sorgente da copiare (operando di destra)
+
+		@return riferimento alla coda corrente (this)
+
+		@throw eccezione di allocazione di memoria
+	*/
+	ring_queue &operator=(const ring_queue &other) {
+		if(this != &other) {
+			ring_queue tmp(other);
+			swap_members(tmp);
+		}
+		return *this;
+	}
+
+	/**
+		@brief Operatore di assegnamento per spostamento (METODO FONDAMENTALE)
+
+		@description
+	    Operatore di assegnamento per spostamento della coda, che permette
+	    di acquisire in tempo costante il buffer di un'altra coda,
+	    senza copiarne i valori.
+	    Gli elementi della coda corrente vengono rimossi e la coda spostata
+	    rimane vuota.
+
+		@param other coda come sorgente da spostare (operando di destra)
+
+		@return riferimento alla coda corrente (this)
+	*/
+	ring_queue &operator=(ring_queue &&other) noexcept {
+		if(this != &other) {
+			ring_queue tmp(std::move(other));
+			swap_members(tmp);
+		}
+		return *this;
+	}
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore della coda, che distrugge tutti gli elementi e dealloca
+	    il buffer.
+	*/
+	virtual ~ring_queue() {
+		clear();
+		release_buffer();
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        return _size;
+    }
+
+    /**
+		@brief Rimozione dell'intero contenuto della coda
+
+		@description
+        Metodo dell'interfaccia pubblica che rimuove tutti gli elementi
+        della coda, che rimane vuota e utilizzabile.
+        I valori vengono distrutti percorrendo i due tratti contigui
+        del buffer (e la distruzione è del tutto omessa se il tipo T
+        ha un distruttore banale); il buffer viene mantenuto, con la stessa
+        capacità, per i successivi inserimenti.
+
+        @post Il numero di elementi inseriti nella coda è pari a 0.
+	*/
+    void clear() {
+        if(!std::is_trivially_destructible<value_type>::value && _size > 0) {
+            size_type first = _capacity - _head;
+            if(first > _size)
+                first = _size;
+            for(size_type i = 0; i < first; ++i)
+                _buffer[_head + i].~value_type();
+            for(size_type i = 0; i < _size - first; ++i)
+                _buffer[i].~value_type();
+        }
+
+        _head = 0;
+        _tail = 0;
+        _size = 0;
+    }
+
+    /**
+        @brief Capacità del buffer
+
+        @return numero di elementi che la coda può contenere senza
+                riallocare il buffer
+    */
+    size_type capacity() const {
+        return _capacity;
+    }
+
+    /**
+        @brief Riserva di capacità
+
+        @description
+        Metodo dell'interfaccia pubblica che garantisce che la coda possa
+        contenere almeno n elementi senza riallocare il buffer.
+        La capacità viene arrotondata alla potenza di 2 successiva.
+
+        @param n numero di elementi da poter contenere
+
+		@throw std::length_error se n supera la capacità massima (2^31)
+		@throw eccezione di allocazione di memoria
+    */
+    void reserve(size_type n) {
+        if(n <= _capacity)
+            return;
+        if(n > MAX_CAPACITY)
+            throw std::length_error("ring_queue: capacita' richiesta "
+                                    "troppo grande");
+        size_type c = MIN_CAPACITY;
+        if(_capacity > 0)
+            c = _capacity;
+        while(c < n)
+            c *= 2;
+        reallocate(c);
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, costruendone il valore nella posizione successiva
+	    all'elemento in coda.
+	    Se il buffer è pieno, la sua capacità viene prima raddoppiata.
+	    L'operazione di inserimento è eseguita in tempo costante ammortizzato.
+
+	    Nel caso in cui venga lanciata un'eccezione, la coda rimane allo stato
+	    precedente alla chiamata e l'eccezione viene propagata alla funzione
+	    chiamante.
+
+		@param value valore dell'elemento da inserire nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(const value_type &value) {
+		construct_back(value);
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda per spostamento
+
+		@overload enqueue
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, spostandone il valore anziché copiarlo.
+	    Per il resto, si comporta come l'inserimento per copia.
+
+		@param value valore dell'elemento da spostare nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	void enqueue(value_type &&value) {
+		construct_back(std::move(value));
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento costruito sul posto
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, costruendone il valore direttamente nella posizione successiva
+	    all'elemento in coda,
+	    a partire dagli argomenti del costruttore del tipo T,
+	    senza istanziare alcun valore temporaneo.
+	    Nel caso in cui venga lanciata un'eccezione, la coda rimane allo stato
+	    precedente alla chiamata.
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw eccezione di allocazione di memoria
+	*/
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		construct_back(std::forward<Args>(args)...);
+	}
+
+    /**
+        @brief Inserimento nella coda di un insieme di elementi presi da una
+               sequenza identificata da due iteratori
+
+        @overload enqueue
+
+        @description
+        Metodo dell'interfaccia pubblica che inserisce nella coda gli elementi
+        di una sequenza generica identificata da due iteratori, convertendoli
+        nel tipo T tramite static_cast<T>.
+        Se gli iteratori sono ad accesso casuale, il buffer viene prima
+        riallocato, al più una volta, con una capacità sufficiente a contenere
+        l'intera sequenza; se sono puntatori a valori banalmente copiabili,
+        la sequenza viene copiata con al più due std::memcpy.
+        Nel caso in cui venga lanciata un'eccezione durante l'inserimento,
+        gli elementi già inseriti vengono rimossi, la coda rimane allo stato
+        precedente alla chiamata e l'eccezione viene propagata alla funzione
+        chiamante.
+
+        @pre Il tipo del valore degli elementi della sequenza deve essere
+             convertibile nel tipo del valore degli elementi della coda.
+
+        @tparam IterT tipo degli iteratori che identificano la sequenza
+                di elementi da inserire nella coda
+
+        @param begin iteratore che punta all'inizio della sequenza
+        @param end iteratore che punta alla fine della sequenza
+
+        @throw eccezione di allocazione di memoria
+    */
+    template <typename IterT>
+    void enqueue(IterT begin, IterT end) {
+        if constexpr(is_bulk_copyable<IterT>::value) {
+            std::size_t count = static_cast<std::size_t>(end - begin);
+            if(count == 0)
+                return;
+            reserve_more(count);
+            size_type n = static_cast<size_type>(count);
+            size_type first = _capacity - _tail;
+            if(first > n)
+                first = n;
+            std::memcpy(static_cast<void *>(_buffer + _tail), begin,
+                        first * sizeof(value_type));
+            std::memcpy(static_cast<void *>(_buffer), begin + first,
+                        (n - first) * sizeof(value_type));
+            _tail = (_tail + n) & (_capacity - 1);
+            _size += n;
+        }
+        else {
+            reserve_range(begin, end,
+                          typename std::iterator_traits<IterT>::iterator_category());
+            size_type old_size = _size;
+
+            try {
+                while(begin != end) {
+                    enqueue(static_cast<value_type>(*begin));
+                    ++begin;
+                }
+            }
+            catch(...) {
+                truncate(old_size);
+                throw;
+            }
+        }
+    }
+
+    /**
+        @brief Concatenamento di un'altra coda in coda alla coda corrente
+
+        @description
+        Metodo dell'interfaccia pubblica che sposta tutti gli elementi
+        di un'altra coda in coda alla coda corrente, mantenendone l'ordine.
+        Se la coda corrente è vuota, i buffer delle due code vengono scambiati in tempo
+        costante; altrimenti, i valori vengono spostati uno alla volta,
+        dopo aver riservato la capacità necessaria.
+        In ogni caso, l'altra coda rimane vuota.
+
+        @param other coda da concatenare
+
+        @post Il numero di elementi inseriti nella coda viene incrementato
+              di tante unità quanti erano gli elementi dell'altra coda.
+
+        @throw eccezione di allocazione di memoria
+    */
+    void splice(ring_queue &&other) {
+        if(this == &other || other._size == 0)
+            return;
+        if(_size == 0)
+            swap_members(other);
+        else {
+            reserve_more(other._size);
+            enqueue(std::make_move_iterator(other.begin()),
+                    std::make_move_iterator(other.end()));
+        }
+        other.clear();
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda (l'elemento in testa alla coda) e ne restituisce il valore,
+        spostandolo anziché copiarlo.
+        L'indice della testa avanza di una posizione nel buffer.
+        L'operazione di rimozione è eseguita in tempo costante.
+
+        @pre La coda non dev'essere vuota.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        value_type removed_value(std::move(_buffer[_head]));
+        pop_head();
+
+        return removed_value;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda senza eccezioni
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio della coda (l'elemento in testa
+        alla coda), spostandone il valore nel parametro passato per riferimento.
+        A differenza di dequeue, se la coda è vuota non viene lanciata alcuna
+        eccezione: la funzione restituisce false e il parametro non viene
+        modificato. È quindi adatta a consumatori che interrogano
+        ripetutamente la coda.
+        Se lo spostamento del valore lancia un'eccezione, la coda rimane
+        allo stato precedente alla chiamata.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+
+        @post Se la coda non era vuota, il numero di elementi inseriti
+              nella coda viene decrementato di un'unità.
+    */
+    bool try_dequeue(value_type &out) {
+        if(_size == 0)
+            return false;
+        out = std::move(_buffer[_head]);
+        pop_head();
+        return true;
+    }
+
+	/**
+		@brief Accesso in lettura all'elemento più recente della coda
+
+	    @pre La coda non dev'essere vuota.
+
+		@return valore dell'elemento più recente della coda
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    value_type &get_tail() const {
+	    if(_size == 0)
+	        throw empty_queue_exception("Impossibile leggere l'elemento piu' "
+                                        "recente: la coda e' vuota.");
+	    return _buffer[(_tail - 1) & (_capacity - 1)];
+	}
+
+    /**
+        @brief Accesso in scrittura all'elemento più recente della coda
+
+        @pre La coda non dev'essere vuota.
+
+        @param value valore da assegnare all'elemento più recente della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_tail(const value_type &value) {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile assegnare il valore "
+                                        "all'elemento piu' recente: "
+                                        "la coda e' vuota.");
+        _buffer[(_tail - 1) & (_capacity - 1)] = value;
+    }
+
+    /**
+		@brief Accesso in lettura all'elemento più vecchio della coda
+
+	    @pre La coda non dev'essere vuota.
+
+		@return valore dell'elemento più vecchio della coda
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+    value_type &get_head() const {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile leggere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        return _buffer[_head];
+    }
+
+    /**
+        @brief Accesso in scrittura all'elemento più vecchio della coda
+
+        @pre La coda non dev'essere vuota.
+
+        @param value valore da assegnare all'elemento più vecchio della coda
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    void set_head(const value_type &value) {
+        if(_size == 0)
+            throw empty_queue_exception("Impossibile assegnare il valore "
+                                        "all'elemento piu' vecchio: "
+                                        "la coda e' vuota.");
+        _buffer[_head] = value;
+    }
+
+    /**
+		@brief Esistenza nella coda di almeno un elemento di un certo valore
+               dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina se la coda corrente
+        contiene almeno un elemento di un certo valore dato.
+        La scansione avviene su al più due tratti contigui del buffer:
+        dalla testa alla fine del buffer e dall'inizio del buffer alla coda.
+        Se il funtore E equivale a == (is_plain_equality) e T è un tipo
+        aritmetico a 32 o 64 bit, ogni tratto viene confrontato
+        con istruzioni vettoriali SSE2 o AVX2.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+	*/
+    bool contains(const value_type &value) const {
+        return find_position(value) < _size;
+    }
+
+    /**
+		@brief Numero di elementi di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che conta gli elementi uguali
+        al valore dato, con gli stessi confronti di contains.
+
+		@param value valore degli elementi da contare
+
+		@return numero di elementi della coda del valore dato
+	*/
+    size_type count(const value_type &value) const {
+        if(_size == 0)
+            return 0;
+        size_type first = first_span();
+        return count_in(_buffer + _head, first, value) +
+               count_in(_buffer, _size - first, value);
+    }
+
+    /**
+		@brief Rimozione degli elementi che soddisfano un predicato
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove dalla coda gli elementi
+        che soddisfano il predicato, con un'unica passata e senza
+        riallocare il buffer: gli elementi mantenuti vengono spostati
+        verso la testa, nel loro ordine FIFO, e gli ultimi elementi rimasti
+        vengono distrutti.
+        Il predicato viene chiamato una sola volta per ogni elemento,
+        in ordine FIFO.
+
+		@param pred predicato che gli elementi devono soddisfare per essere
+               rimossi
+
+		@return numero di elementi rimossi
+
+        @throw eccezione lanciata da pred: gli elementi già esaminati
+               restano rimossi, gli altri vengono mantenuti
+	*/
+    template <typename P>
+    size_type remove_if(P pred) {
+        std::exception_ptr error;
+        size_type kept = 0;
+
+        for(size_type i = 0; i < _size; ++i) {
+            value_type &value = _buffer[index(i)];
+            bool remove = false;
+            if(!error) {
+                try {
+                    remove = pred(value);
+                }
+                catch(...) {
+                    error = std::current_exception();
+                }
+            }
+            if(remove)
+                continue;
+            if(kept != i)
+                _buffer[index(kept)] = std::move(value);
+            ++kept;
+        }
+
+        size_type removed = _size - kept;
+        truncate(kept);
+        if(error)
+            std::rethrow_exception(error);
+        return removed;
+    }
+
+    // Supporto agli iteratori della coda
+
+    class const_iterator; // forward declaration dell'iteratore costante
+
+    /**
+		@brief Iteratore della coda in lettura e scrittura di tipo forward
+
+	    @description
+		Iteratore della coda in lettura e scrittura di tipo forward.
+		Gli elementi sono ritornati seguendo la logica FIFO.
+		L'iteratore conosce il buffer, l'indice dell'elemento puntato
+		e il numero di elementi rimanenti fino alla fine della coda:
+		due iteratori della stessa coda con lo stesso numero di elementi
+		rimanenti puntano allo stesso elemento.
+	*/
+    class iterator {
+
+        T *_buffer; ///< @brief Buffer della coda
+        size_type _mask; ///< @brief Capacità del buffer meno uno
+        size_type _i; ///< @brief Indice dell'elemento puntato
+        size_type _left; ///< @brief Numero di elementi rimanenti (compreso
+                         ///< quello puntato)
+
+    public:
+
+        // Traits dell'iteratore
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef T                         value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef T*                        pointer; ///< @brief Tipo puntatore
+        typedef T&                        reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        iterator() :
+            _buffer(nullptr), _mask(0), _i(0),
+            _left(0) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return _buffer[_i];
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore dell'elemento puntato dall'iteratore
+		*/
+        pointer operator->() const {
+            return _buffer + _i;
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@return riferimento all'iteratore corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator& operator++() {
+            if(_left == 0)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            if(--_left == 0)
+                _buffer = nullptr;
+            _i = (_i + 1) & _mask;
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore corrente prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   punta già alla fine della coda
+		*/
+        iterator operator++(int) {
+            iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+
+			@return true se i due iteratori puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator==(const iterator &other) const {
+            return (_buffer == other._buffer && _left == other._left);
+        }
+
+        /**
+			@brief Operatore di diversità
+
+			@return true se i due iteratori non puntano allo stesso elemento
+                    della coda
+            @return false altrimenti
+		*/
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+        friend class const_iterator;
+
+        /**
+			@brief Operatore di uguaglianza con un iteratore costante
+		*/
+        bool operator==(const const_iterator &other) const {
+            return (_buffer == other._buffer && _left == other._left);
+        }
+
+        /**
+			@brief Operatore di diversità con un iteratore costante
+		*/
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class ring_queue; // per permettere alla classe container
+                                 // di utilizzare il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param buffer buffer della coda
+			@param mask capacità del buffer meno uno
+			@param i indice dell'elemento puntato
+			@param left numero di elementi rimanenti
+		*/
+        iterator(T *buffer, size_type mask, size_type i,
+                 size_type left) :
+            _buffer(buffer), _mask(mask), _i(i),
+            _left(left) {} // initialization list
+
+    }; // class iterator
+
+    /**
+		@brief Iteratore che punta all'inizio della coda
+
+		@return iteratore che punta all'inizio della coda
+	*/
+    iterator begin() {
+        if(_size == 0)
+            return iterator();
+        return iterator(_buffer, _capacity - 1, _head, _size);
+    }
+
+    /**
+		@brief Iteratore che punta alla fine della coda
+
+		@return iteratore che punta alla fine della coda
+	*/
+    iterator end() {
+        return iterator();
+    }
+
+    /**
+		@brief Iteratore costante della coda di tipo forward
+
+	    @description
+		Iteratore costante (in sola lettura) della coda di tipo forward.
+		Gli elementi sono ritornati seguendo la logica FIFO.
+	*/
+    class const_iterator {
+
+        const T *_buffer; ///< @brief Buffer della coda
+        size_type _mask; ///< @brief Capacità del buffer meno uno
+        size_type _i; ///< @brief Indice dell'elemento puntato
+        size_type _left; ///< @brief Numero di elementi rimanenti (compreso
+                         ///< quello puntato)
+
+    public:
+
+        // Traits dell'iteratore costante
+
+        typedef std::forward_iterator_tag iterator_category; ///< @brief
+                                                             ///< Categoria
+                                                             ///< dell'iteratore
+        typedef const T                   value_type; ///< @brief Tipo dei dati
+                                                      ///< puntati
+        typedef ptrdiff_t                 difference_type; ///< @brief Tipo
+                                                           ///< differenza
+        typedef const T*                  pointer; ///< @brief Tipo puntatore
+        typedef const T&                  reference; ///< @brief Tipo
+                                                     ///< riferimento
+
+        /**
+			@brief Costruttore di default (METODO FONDAMENTALE)
+		*/
+        const_iterator() :
+            _buffer(nullptr), _mask(0), _i(0),
+            _left(0) {} // initialization list
+
+        /**
+			@brief Costruttore di conversione da iteratore in lettura e
+                   scrittura a iteratore costante
+
+			@param other iteratore in lettura e scrittura da convertire
+		*/
+        const_iterator(const iterator &other) :
+            _buffer(other._buffer), _mask(other._mask), _i(other._i),
+            _left(other._left) {} // initialization list
+
+        /**
+			@brief Operatore di dereferenziamento
+
+			@return valore costante dell'elemento puntato dall'iteratore
+		*/
+        reference operator*() const {
+            return _buffer[_i];
+        }
+
+        /**
+			@brief Operatore di accesso ai dati tramite puntatore
+
+			@return puntatore al valore costante dell'elemento puntato
+		*/
+        pointer operator->() const {
+            return _buffer + _i;
+        }
+
+        /**
+			@brief Operatore di iterazione pre-incremento
+
+			@return riferimento all'iteratore costante corrente incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator& operator++() {
+            if(_left == 0)
+                throw queue_iterator_out_of_bounds_exception("Impossibile "
+                                                             "incrementare "
+                                                             "l'iteratore "
+                                                             "costante: "
+                                                             "locazione di "
+                                                             "memoria esterna "
+                                                             "alla coda.");
+            if(--_left == 0)
+                _buffer = nullptr;
+            _i = (_i + 1) & _mask;
+            return *this;
+        }
+
+        /**
+			@brief Operatore di iterazione post-incremento
+
+			@return copia dell'iteratore costante prima di essere incrementato
+
+            @throw queue_iterator_out_of_bounds_exception se l'iteratore
+                   costante punta già alla fine della coda
+		*/
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+			@brief Operatore di uguaglianza
+		*/
+        bool operator==(const const_iterator &other) const {
+            return (_buffer == other._buffer && _left == other._left);
+        }
+
+        /**
+			@brief Operatore di diversità
+		*/
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+        friend class iterator;
+
+        /**
+			@brief Operatore di uguaglianza con un iteratore in lettura
+                   e scrittura
+		*/
+        bool operator==(const iterator &other) const {
+            return (_buffer == other._buffer && _left == other._left);
+        }
+
+        /**
+			@brief Operatore di diversità con un iteratore in lettura
+                   e scrittura
+		*/
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class ring_queue; // per permettere alla classe container
+                                 // di utilizzare il costruttore privato
+
+        /**
+			@brief Costruttore privato di inizializzazione
+
+			@param buffer buffer della coda
+			@param mask capacità del buffer meno uno
+			@param i indice dell'elemento puntato
+			@param left numero di elementi rimanenti
+		*/
+        const_iterator(const T *buffer, size_type mask, size_type i,
+                       size_type left) :
+            _buffer(buffer), _mask(mask), _i(i),
+            _left(left) {} // initialization list
+
+    }; // class const_iterator
+
+    /**
+		@brief Iteratore costante che punta all'inizio della coda
+
+		@return iteratore costante che punta all'inizio della coda
+	*/
+    const_iterator begin() const {
+        if(_size == 0)
+            return const_iterator();
+        return const_iterator(_buffer, _capacity - 1, _head, _size);
+    }
+
+    /**
+		@brief Iteratore costante che punta alla fine della coda
+
+		@return iteratore costante che punta alla fine della coda
+	*/
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    /**
+		@brief Visita dei tratti contigui della coda
+
+		@description
+        Metodo dell'interfaccia pubblica che chiama f(p, n) su ciascuno
+        dei tratti contigui del buffer occupati dagli elementi, in ordine
+        FIFO (al più due: dalla testa alla fine del buffer e dall'inizio
+        del buffer alla coda). Permette agli algoritmi di lavorare
+        su memoria contigua, ad esempio dividendola tra più thread
+        o lasciando che il compilatore vettorizzi i cicli.
+
+		@tparam F tipo della funzione da chiamare
+
+		@param f funzione chiamata con il puntatore al primo elemento
+		       e il numero di elementi di ogni tratto
+	*/
+    template <typename F>
+    void for_each_span(F f) {
+        if(_size == 0)
+            return;
+        size_type first = first_span();
+        f(_buffer + _head, first);
+        if(_size > first)
+            f(_buffer, _size - first);
+    }
+
+    /**
+		@overload for_each_span
+
+		@description
+        Versione per le code costanti: f riceve puntatori costanti.
+	*/
+    template <typename F>
+    void for_each_span(F f) const {
+        if(_size == 0)
+            return;
+        size_type first = first_span();
+        f(static_cast<const value_type *>(_buffer + _head), first);
+        if(_size > first)
+            f(static_cast<const value_type *>(_buffer), _size - first);
+    }
+
+    /**
+		@brief Ricerca del primo elemento di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce un iteratore
+        al primo elemento (il più vecchio) uguale al valore dato,
+        con gli stessi confronti di contains.
+
+		@param value valore dell'elemento da cercare
+
+		@return iteratore al primo elemento del valore dato, oppure end()
+	*/
+    iterator find(const value_type &value) {
+        size_type pos = find_position(value);
+        if(pos == _size)
+            return iterator();
+        return iterator(_buffer, _capacity - 1, index(pos), _size - pos);
+    }
+
+    /**
+		@overload find
+
+		@return iteratore costante al primo elemento del valore dato,
+		        oppure end()
+	*/
+    const_iterator find(const value_type &value) const {
+        size_type pos = find_position(value);
+        if(pos == _size)
+            return const_iterator();
+        return const_iterator(_buffer, _capacity - 1, index(pos), _size - pos);
+    }
+
+}; // class ring_queue
+
+// Funzioni globali
+
+/**
+	@brief Trasformazione dei valori degli elementi della coda circolare
+           che soddisfano un predicato
+
+    @description
+	Versione della funzione globale transformif per la classe ring_queue.
+    Se Qi è un elemento della coda:
+    Qi = F(Qi) se P(Qi) == true
+    Qi = Qi    se P(Qi) == false
+
+    @tparam Q tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+            della coda
+    @tparam P tipo del predicato
+    @tparam F tipo dell'operatore generico
+
+	@param q coda di cui modificare i valori contenuti
+	@param pred predicato che i valori devono soddisfare per essere modificati
+    @param op operatore generico con cui modificare i valori
+*/
+template <typename Q, typename E, typename P, typename F>
+void transformif(ring_queue<Q, E> &q, P pred, F op) {
+	typename ring_queue<Q, E>::iterator i, ie;
+
+	for(i = q.begin(), ie = q.end(); i != ie; ++i)
+		if(pred(*i))
+			*i = op(*i);
+}
+
+// Operatori globali
+
+/**
+	@brief Ridefinizione dell'operatore di stream << per la coda circolare
+
+    @description
+	Ridefinizione dell'operatore di stream << per la stampa del contenuto
+	della coda circolare, nello stesso formato della classe queue.
+
+	@param os oggetto di stream di output
+	@param q coda da stampare
+
+	@return riferimento allo stream di output
+*/
+template <typename T, typename E>
+std::ostream &operator<<(std::ostream &os, const ring_queue<T, E> &q) {
+    return text::write_sequence(os, q.begin(), q.end(), q.size());
+}
+
+/**
+	@brief Ridefinizione dell'operatore di stream >> per la coda circolare
+
+    @description
+	Ridefinizione dell'operatore di stream >> per la lettura della coda
+	circolare nello stesso formato della classe queue; il contenuto
+	della coda viene sostituito solo se il testo è valido.
+
+	@param is oggetto di stream di input
+	@param q coda da leggere
+
+	@return riferimento allo stream di input
+*/
+template <typename T, typename E>
+std::istream &operator>>(std::istream &is, ring_queue<T, E> &q) {
+    return text::read_sequence(is, q);
+}
+
+/**
+	@brief Serializzazione binaria della coda circolare
+
+    @description
+	Funzione globale che scrive sullo stream os la coda circolare q nel
+    formato binario versionato di binary::write_queue: un'intestazione con
+    il numero di elementi seguita dai valori. Se il tipo degli elementi è
+    banalmente copiabile i valori vengono copiati a blocchi, direttamente
+    dal buffer della coda; per gli altri tipi va specializzato binary::codec
+    (std::string è già supportato). Lo stream va aperto in modalità binaria.
+
+	@param os oggetto di stream di output
+	@param q coda da scrivere
+
+    @throw serialize_queue_exception se la scrittura sullo stream fallisce
+*/
+template <typename T, typename E>
+void serialize(std::ostream &os, const ring_queue<T, E> &q) {
+    binary::write_queue(os, q);
+}
+
+/**
+	@brief Deserializzazione binaria della coda circolare
+
+    @description
+	Funzione globale che legge dallo stream is una coda circolare scritta da
+    serialize e la sostituisce al contenuto di q; se i dati non sono validi
+    q non viene modificata. Dallo stream vengono letti solo i byte della
+    coda.
+
+	@param is oggetto di stream di input
+	@param q coda da sostituire
+
+    @throw serialize_queue_exception se l'intestazione non è valida
+           o i dati sono troncati
+*/
+template <typename T, typename E>
+void deserialize(std::istream &is, ring_queue<T, E> &q) {
+    binary::read_queue(is, q);
+}
+
+#endif
+
+// Fine file header ring_queue.h
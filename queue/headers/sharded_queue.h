@@ -0,0 +1,472 @@
+/**
+	@headerfile sharded_queue.h
+
+    @brief Dichiarazione e definizione della classe sharded_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    sharded_queue, una coda condivisa tra thread suddivisa in più corsie
+    indipendenti, ciascuna con il proprio lock, per ridurre la contesa
+    tra i produttori.
+*/
+
+// Guardie del file header sharded_queue.h
+
+#ifndef SHARDED_QUEUE_H
+#define SHARDED_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed
+#include <chrono> // std::chrono::steady_clock
+#include <climits> // LLONG_MAX
+#include <cstddef> // std::size_t
+#include <future> // std::async, std::future
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::lock_guard
+#include <optional> // std::optional
+#include <thread> // std::thread::hardware_concurrency
+#include <utility> // std::move
+#include <vector> // std::vector
+#include "queue.h" // queue
+#include "queue_exceptions.h" // empty_queue_exception
+
+// Dichiarazione e definizione della classe template sharded_queue
+
+/**
+	@brief Coda FIFO suddivisa in corsie
+
+	@description
+    Classe template che implementa una coda di elementi generici T,
+    condivisa tra un numero qualsiasi di thread produttori e consumatori,
+    come facciata su N corsie, ciascuna costituita da una queue protetta
+    dal proprio mutex e allineata a una linea di cache.
+    Ogni thread produttore inserisce sempre nella stessa corsia, scelta
+    in base al thread alla prima operazione: produttori diversi
+    non competono per la stessa coda finché sono al più N.
+    I consumatori rimuovono gli elementi scorrendo le corsie
+    a rotazione, secondo una delle due politiche di ordinamento:
+    - per_producer: gli elementi di uno stesso produttore vengono rimossi
+      nell'ordine di inserimento, senza alcun ordine tra produttori diversi;
+    - approximate_fifo: ogni elemento viene marcato con l'istante
+      di inserimento e i consumatori rimuovono dalla corsia la cui testa
+      è la più vecchia, garantendo un ordine FIFO globale approssimato
+      (l'istante è letto dall'orologio di sistema e non da un contatore
+      condiviso, che sarebbe un nuovo punto di contesa).
+    Il numero di elementi è mantenuto per corsia con contatori atomici,
+    sommati senza lock da size.
+
+    @note La coda non è copiabile né assegnabile: è pensata per essere
+          condivisa, per riferimento, tra i thread.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class sharded_queue {
+
+public:
+
+    /**
+        @brief Politica di ordinamento della rimozione
+    */
+    enum ordering {
+        per_producer, ///< @brief FIFO per ogni produttore
+        approximate_fifo ///< @brief FIFO globale approssimato
+    };
+
+private:
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+
+    /**
+        @brief Dimensione presunta di una linea di cache, in byte
+    */
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+        @brief Numero minimo di elementi per cui contains scandisce
+               le corsie in parallelo
+    */
+    static const size_type PARALLEL_SCAN = 1 << 16;
+
+    /**
+        @brief Valore di una corsia, marcato con l'istante di inserimento
+    */
+    struct stamped {
+        long long stamp; ///< @brief Istante di inserimento (approximate_fifo)
+        value_type value; ///< @brief Valore dell'elemento
+    };
+
+    /**
+        @brief Funtore di uguaglianza dei valori marcati
+    */
+    struct equal_stamped {
+        E equals; ///< @brief Funtore di uguaglianza dei valori
+
+        bool operator()(const stamped &s1, const stamped &s2) const {
+            return equals(s1.value, s2.value);
+        }
+    };
+
+    /**
+        @brief Corsia della coda
+    */
+    struct alignas(CACHE_LINE) lane {
+        mutable std::mutex mutex; ///< @brief Mutex che protegge la corsia
+        queue<stamped, equal_stamped> items; ///< @brief Elementi della corsia
+        std::atomic<size_type> count; ///< @brief Numero di elementi
+        std::atomic<long long> head_stamp; ///< @brief Istante di inserimento
+                                           ///< della testa (LLONG_MAX se
+                                           ///< la corsia è vuota)
+
+        lane() : count(0), head_stamp(LLONG_MAX) {} // initialization list
+    };
+
+	// Dati membro privati della coda
+
+    std::vector<std::unique_ptr<lane>> _lanes; ///< @brief Corsie della coda
+    ordering _ordering; ///< @brief Politica di ordinamento della rimozione
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi della coda
+
+    // Funzioni private della coda
+
+    /**
+		@brief Identificativo del thread corrente
+
+		@description
+        Funzione privata che assegna a ogni thread, alla prima chiamata,
+        un numero progressivo, usato per scegliere la corsia del produttore
+        e la prima corsia visitata dal consumatore.
+	*/
+    static size_type thread_ticket() {
+        static std::atomic<size_type> next_ticket(0);
+        static thread_local size_type ticket =
+            next_ticket.fetch_add(1, std::memory_order_relaxed);
+        return ticket;
+    }
+
+    /**
+		@brief Istante corrente in nanosecondi
+	*/
+    static long long now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+		@brief Inserimento di un valore nella corsia del thread corrente
+
+        @param value valore marcato da inserire
+	*/
+    void push(stamped &&value) {
+        lane &l = *_lanes[thread_ticket() % _lanes.size()];
+        std::lock_guard<std::mutex> lock(l.mutex);
+        l.items.enqueue(std::move(value));
+        if(l.count.load(std::memory_order_relaxed) == 0)
+            l.head_stamp.store(l.items.get_head().stamp,
+                               std::memory_order_relaxed);
+        l.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+		@brief Rimozione della testa di una corsia
+
+		@param l corsia
+        @param out valore opzionale in cui spostare il valore dell'elemento
+               rimosso
+
+        @return true se un elemento è stato rimosso, false se la corsia
+                è vuota
+	*/
+    bool pop(lane &l, std::optional<value_type> &out) {
+        if(l.count.load(std::memory_order_relaxed) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(l.mutex);
+        if(l.items.size() == 0)
+            return false;
+        out.emplace(l.items.dequeue().value);
+        l.count.fetch_sub(1, std::memory_order_relaxed);
+        l.head_stamp.store(l.items.size() > 0 ? l.items.get_head().stamp
+                                              : LLONG_MAX,
+                           std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+		@brief Ricerca di un valore in una corsia
+
+		@description
+        Funzione privata che scandisce la corsia, interrompendosi se un'altra
+        scansione parallela ha già trovato il valore.
+
+		@param l corsia
+        @param value valore da cercare
+        @param found indicatore condiviso tra le scansioni parallele
+
+        @return true se la corsia contiene il valore
+	*/
+    bool scan(const lane &l, const value_type &value,
+              const std::atomic<bool> &found) const {
+        std::lock_guard<std::mutex> lock(l.mutex);
+        typename queue<stamped, equal_stamped>::const_iterator i, ie;
+        for(i = l.items.begin(), ie = l.items.end(); i != ie; ++i) {
+            if(_equals(i->value, value))
+                return true;
+            if(found.load(std::memory_order_relaxed))
+                return false;
+        }
+        return false;
+    }
+
+    /**
+        @brief Rimozione di un elemento secondo la politica di ordinamento
+
+        @description
+        Funzione privata comune a try_dequeue e dequeue: il valore viene
+        costruito in un std::optional, così che il tipo T non debba avere
+        il costruttore di default.
+
+        @param out valore opzionale in cui spostare il valore dell'elemento
+               rimosso
+
+        @return true se un elemento è stato rimosso, false se tutte le corsie
+                sono risultate vuote
+    */
+    bool take(std::optional<value_type> &out) {
+        const size_type n = static_cast<size_type>(_lanes.size());
+
+        if(_ordering == approximate_fifo) {
+            // la testa più vecchia può essere rimossa da un altro consumatore
+            // tra la lettura degli istanti e l'acquisizione del mutex:
+            // in tal caso si ripete la scelta
+            while(true) {
+                size_type oldest = n;
+                long long oldest_stamp = LLONG_MAX;
+                for(size_type i = 0; i < n; ++i) {
+                    long long stamp =
+                        _lanes[i]->head_stamp.load(std::memory_order_relaxed);
+                    if(stamp < oldest_stamp) {
+                        oldest = i;
+                        oldest_stamp = stamp;
+                    }
+                }
+                if(oldest == n)
+                    break;
+                if(pop(*_lanes[oldest], out))
+                    return true;
+            }
+        }
+
+        static thread_local size_type rotation = 0;
+        const size_type start = thread_ticket() + rotation++;
+        for(size_type i = 0; i < n; ++i)
+            if(pop(*_lanes[(start + i) % n], out))
+                return true;
+        return false;
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota con il numero di corsie dato.
+
+		@param lanes numero di corsie (almeno 1); per default, il numero
+		       di CPU disponibili
+		@param order politica di ordinamento della rimozione
+
+		@throw eccezione di allocazione di memoria
+	*/
+	explicit sharded_queue(size_type lanes =
+	                           std::thread::hardware_concurrency(),
+	                       ordering order = per_producer) :
+	    _ordering(order) { // initialization list
+
+	    if(lanes == 0)
+	        lanes = 1;
+	    for(size_type i = 0; i < lanes; ++i)
+	        _lanes.push_back(std::unique_ptr<lane>(new lane()));
+	}
+
+	sharded_queue(const sharded_queue &other) = delete;
+
+	sharded_queue &operator=(const sharded_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+	    @pre Nessun thread sta utilizzando la coda.
+	*/
+	virtual ~sharded_queue() {}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @description
+        Metodo dell'interfaccia pubblica che somma, senza lock, i contatori
+        delle corsie. Se chiamato mentre altri thread operano sulla coda,
+        il valore restituito è solo indicativo.
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        size_type total = 0;
+        for(const std::unique_ptr<lane> &l : _lanes)
+            total += l->count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+        @brief Numero di corsie della coda
+
+        @return numero di corsie della coda
+    */
+    size_type lanes() const {
+        return static_cast<size_type>(_lanes.size());
+    }
+
+    /**
+        @brief Politica di ordinamento della rimozione
+
+        @return politica di ordinamento scelta alla costruzione
+    */
+    ordering order() const {
+        return _ordering;
+    }
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento,
+	    copiandone il valore, nella corsia del thread chiamante.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+	*/
+	void enqueue(const value_type &value) {
+	    push(stamped{_ordering == approximate_fifo ? now() : 0, value});
+	}
+
+	/**
+		@overload enqueue
+
+		@description
+	    Inserisce il valore spostandolo nella corsia del thread chiamante.
+	*/
+	void enqueue(value_type &&value) {
+	    push(stamped{_ordering == approximate_fifo ? now() : 0,
+	                 std::move(value)});
+	}
+
+    /**
+        @brief Tentativo di rimozione di un elemento dalla coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove un elemento, spostandone
+        il valore nel parametro: con la politica per_producer, dalla prima
+        corsia non vuota a partire da una corsia che varia a rotazione;
+        con la politica approximate_fifo, dalla corsia con la testa
+        più vecchia.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se tutte le corsie
+                sono risultate vuote
+    */
+    bool try_dequeue(value_type &out) {
+        std::optional<value_type> removed_value;
+        if(!take(removed_value))
+            return false;
+        out = std::move(*removed_value);
+        return true;
+    }
+
+    /**
+        @brief Rimozione di un elemento dalla coda
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove un elemento secondo
+        la politica di ordinamento, come try_dequeue.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se tutte le corsie sono risultate vuote
+    */
+    value_type dequeue() {
+        std::optional<value_type> removed_value;
+        if(!take(removed_value))
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+        return std::move(*removed_value);
+    }
+
+	/**
+		@brief Verifica dell'esistenza di un elemento di un certo valore dato
+
+        @description
+        Metodo dell'interfaccia pubblica che determina se la coda contiene
+        almeno un elemento del valore dato. Se la coda contiene almeno
+        PARALLEL_SCAN elementi, le corsie vengono scandite in parallelo,
+        ciascuna con il proprio lock, e le scansioni si interrompono appena
+        una di esse trova il valore.
+
+		@param value valore dell'elemento di cui determinare l'esistenza
+               nella coda
+
+		@return true se la coda contiene almeno un elemento del valore dato
+        @return false altrimenti
+
+        @throw eccezione di creazione dei thread di scansione
+	*/
+    bool contains(const value_type &value) const {
+        std::atomic<bool> found(false);
+        const size_type n = static_cast<size_type>(_lanes.size());
+
+        if(n == 1 || size() < PARALLEL_SCAN) {
+            for(size_type i = 0; i < n; ++i)
+                if(scan(*_lanes[i], value, found))
+                    return true;
+            return false;
+        }
+
+        std::vector<std::future<bool>> scans;
+        for(size_type i = 1; i < n; ++i)
+            scans.push_back(std::async(std::launch::async, [&, i]() {
+                bool result = scan(*_lanes[i], value, found);
+                if(result)
+                    found.store(true, std::memory_order_relaxed);
+                return result;
+            }));
+        if(scan(*_lanes[0], value, found))
+            found.store(true, std::memory_order_relaxed);
+        for(std::future<bool> &f : scans)
+            f.get();
+        return found.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
+
+// Fine file header sharded_queue.h
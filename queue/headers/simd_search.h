@@ -0,0 +1,321 @@
+/**
+	@headerfile simd_search.h
+
+    @brief Ricerca vettoriale di un valore in memoria contigua
+
+    @description
+	File header con il trait che dichiara un funtore di uguaglianza
+    equivalente all'operatore == e con le funzioni di ricerca e conteggio
+    di un valore in un tratto di memoria contigua, vettorizzate con SSE2
+    o AVX2 per i tipi aritmetici a 32 e 64 bit, utilizzate da ring_queue
+    e chunked_queue.
+*/
+
+// Guardie del file header simd_search.h
+
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+// Direttive per il pre-compilatore
+
+#include <bit> // std::countr_zero, std::popcount
+#include <cstddef> // std::size_t
+#include <functional> // std::equal_to
+#include <type_traits> // std::is_base_of, std::is_same, std::bool_constant
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h> // intrinseci SSE2 e AVX2
+#define QUEUE_SIMD_X86 1
+#endif
+
+// Trait del funtore di uguaglianza
+
+/**
+	@brief Etichetta di uguaglianza semplice
+
+	@description
+    Un funtore di uguaglianza E che deriva da plain_equality_tag dichiara
+    che E(a, b) equivale ad a == b: le code con memoria contigua possono
+    allora confrontare più elementi alla volta con istruzioni vettoriali,
+    senza chiamare il funtore.
+*/
+struct plain_equality_tag {};
+
+/**
+	@brief Funtore di uguaglianza equivalente all'operatore ==
+
+	@description
+    Trait vero per i funtori che derivano da plain_equality_tag
+    e per std::equal_to. Può essere specializzato per i funtori
+    che non si possono modificare.
+
+    @tparam E funtore di confronto di uguaglianza
+*/
+template <typename E>
+struct is_plain_equality : std::is_base_of<plain_equality_tag, E> {};
+
+template <typename T>
+struct is_plain_equality<std::equal_to<T> > : std::true_type {};
+
+/**
+	@brief Elementi ricercabili con le istruzioni vettoriali
+
+	@description
+    Trait vero se il funtore E equivale a == e T è un tipo aritmetico
+    supportato dai nuclei vettoriali (interi a 32 o 64 bit, float, double).
+
+    @tparam T tipo del valore degli elementi
+    @tparam E funtore di confronto di uguaglianza
+*/
+template <typename T, typename E>
+struct is_simd_searchable : std::bool_constant<
+    is_plain_equality<E>::value &&
+    (std::is_same<T, int>::value || std::is_same<T, unsigned int>::value ||
+     std::is_same<T, long>::value || std::is_same<T, unsigned long>::value ||
+     std::is_same<T, long long>::value ||
+     std::is_same<T, unsigned long long>::value ||
+     std::is_same<T, float>::value || std::is_same<T, double>::value) &&
+    (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+// Nuclei di ricerca
+
+/**
+	@brief Nuclei di ricerca e conteggio di un valore
+
+	@description
+    Namespace con le funzioni che cercano o contano le occorrenze
+    di un valore in un tratto contiguo di n elementi.
+    Su x86-64 i confronti usano SSE2 (sempre disponibile) oppure AVX2,
+    se il processore lo supporta (verificato una sola volta a tempo
+    di esecuzione): ogni istruzione confronta 4 o 8 elementi a 32 bit
+    (2 o 4 a 64 bit) e la maschera dei risultati viene letta con movemask.
+    Altrove, e per la coda finale del tratto, si usa un ciclo scalare.
+    I confronti seguono la semantica di ==: per i float, 0.0 == -0.0
+    e NaN è diverso da ogni valore.
+*/
+namespace simd {
+
+namespace detail {
+
+/**
+	@brief Ricerca scalare del primo elemento uguale al valore
+
+	@return indice del primo elemento uguale a v, oppure n
+*/
+template <typename T>
+std::size_t find_scalar(const T *p, std::size_t n, T v) {
+    for(std::size_t i = 0; i < n; ++i)
+        if(p[i] == v)
+            return i;
+    return n;
+}
+
+/**
+	@brief Conteggio scalare degli elementi uguali al valore
+*/
+template <typename T>
+std::size_t count_scalar(const T *p, std::size_t n, T v) {
+    std::size_t c = 0;
+    for(std::size_t i = 0; i < n; ++i)
+        c += (p[i] == v);
+    return c;
+}
+
+#ifdef QUEUE_SIMD_X86
+
+/**
+	@brief Confronto di un vettore SSE2 con il valore replicato
+
+	@description
+    Restituisce una maschera con un bit per byte: gli elementi uguali
+    hanno tutti i loro byte a 1.
+*/
+template <typename T>
+int mask_sse2(const T *p, T v) {
+    if constexpr(std::is_same<T, float>::value)
+        return _mm_movemask_epi8(_mm_castps_si128(
+            _mm_cmpeq_ps(_mm_loadu_ps(p), _mm_set1_ps(v))));
+    else if constexpr(std::is_same<T, double>::value)
+        return _mm_movemask_epi8(_mm_castpd_si128(
+            _mm_cmpeq_pd(_mm_loadu_pd(p), _mm_set1_pd(v))));
+    else if constexpr(sizeof(T) == 4)
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+            _mm_set1_epi32(static_cast<int>(v))));
+    else {
+        // SSE2 non confronta interi a 64 bit: due metà a 32 bit uguali
+        __m128i eq = _mm_cmpeq_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+            _mm_set1_epi64x(static_cast<long long>(v)));
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_movemask_epi8(eq);
+    }
+}
+
+/**
+	@brief Confronto di un vettore AVX2 con il valore replicato
+*/
+template <typename T>
+__attribute__((target("avx2")))
+int mask_avx2(const T *p, T v) {
+    if constexpr(std::is_same<T, float>::value)
+        return _mm256_movemask_epi8(_mm256_castps_si256(
+            _mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_set1_ps(v), _CMP_EQ_OQ)));
+    else if constexpr(std::is_same<T, double>::value)
+        return _mm256_movemask_epi8(_mm256_castpd_si256(
+            _mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_set1_pd(v), _CMP_EQ_OQ)));
+    else if constexpr(sizeof(T) == 4)
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+            _mm256_set1_epi32(static_cast<int>(v))));
+    else
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi64(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+            _mm256_set1_epi64x(static_cast<long long>(v))));
+}
+
+/**
+	@brief Ricerca con SSE2
+
+	@description
+    Confronta 16 byte alla volta, srotolando il ciclo su quattro vettori
+    per 64 byte per iterazione: l'OR delle quattro maschere fa uscire
+    dal ciclo solo in presenza di un elemento uguale.
+*/
+template <typename T>
+std::size_t find_sse2(const T *p, std::size_t n, T v) {
+    const std::size_t W = 16 / sizeof(T);
+    std::size_t i = 0;
+    for(; i + 4 * W <= n; i += 4 * W) {
+        int m0 = mask_sse2(p + i, v), m1 = mask_sse2(p + i + W, v);
+        int m2 = mask_sse2(p + i + 2 * W, v), m3 = mask_sse2(p + i + 3 * W, v);
+        if((m0 | m1 | m2 | m3) != 0) {
+            unsigned long long m = static_cast<unsigned int>(m0) |
+                (static_cast<unsigned long long>(m1) << 16) |
+                (static_cast<unsigned long long>(m2) << 32) |
+                (static_cast<unsigned long long>(m3) << 48);
+            return i + static_cast<std::size_t>(std::countr_zero(m)) / sizeof(T);
+        }
+    }
+    for(; i + W <= n; i += W) {
+        int m = mask_sse2(p + i, v);
+        if(m != 0)
+            return i + static_cast<std::size_t>(std::countr_zero(
+                static_cast<unsigned int>(m))) / sizeof(T);
+    }
+    return i + find_scalar(p + i, n - i, v);
+}
+
+/**
+	@brief Ricerca con AVX2
+*/
+template <typename T>
+__attribute__((target("avx2")))
+std::size_t find_avx2(const T *p, std::size_t n, T v) {
+    const std::size_t W = 32 / sizeof(T);
+    std::size_t i = 0;
+    for(; i + 2 * W <= n; i += 2 * W) {
+        int m0 = mask_avx2(p + i, v), m1 = mask_avx2(p + i + W, v);
+        if((m0 | m1) != 0) {
+            unsigned long long m = static_cast<unsigned int>(m0) |
+                (static_cast<unsigned long long>(
+                    static_cast<unsigned int>(m1)) << 32);
+            return i + static_cast<std::size_t>(std::countr_zero(m)) / sizeof(T);
+        }
+    }
+    for(; i + W <= n; i += W) {
+        int m = mask_avx2(p + i, v);
+        if(m != 0)
+            return i + static_cast<std::size_t>(std::countr_zero(
+                static_cast<unsigned int>(m))) / sizeof(T);
+    }
+    return i + find_scalar(p + i, n - i, v);
+}
+
+/**
+	@brief Conteggio con SSE2
+*/
+template <typename T>
+std::size_t count_sse2(const T *p, std::size_t n, T v) {
+    const std::size_t W = 16 / sizeof(T);
+    std::size_t c = 0, i = 0;
+    for(; i + W <= n; i += W)
+        c += static_cast<std::size_t>(std::popcount(
+            static_cast<unsigned int>(mask_sse2(p + i, v))));
+    return c / sizeof(T) + count_scalar(p + i, n - i, v);
+}
+
+/**
+	@brief Conteggio con AVX2
+*/
+template <typename T>
+__attribute__((target("avx2")))
+std::size_t count_avx2(const T *p, std::size_t n, T v) {
+    const std::size_t W = 32 / sizeof(T);
+    std::size_t c = 0, i = 0;
+    for(; i + W <= n; i += W)
+        c += static_cast<std::size_t>(std::popcount(
+            static_cast<unsigned int>(mask_avx2(p + i, v))));
+    return c / sizeof(T) + count_scalar(p + i, n - i, v);
+}
+
+/**
+	@brief Disponibilità di AVX2, verificata alla prima chiamata
+*/
+inline bool has_avx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+#endif
+
+} // namespace detail
+
+/**
+	@brief Ricerca del primo elemento uguale a un valore
+
+	@tparam T tipo aritmetico a 32 o 64 bit
+
+	@param p puntatore al primo elemento del tratto
+	@param n numero di elementi del tratto
+	@param v valore da cercare
+
+	@return indice del primo elemento uguale a v, oppure n se non esiste
+*/
+template <typename T>
+std::size_t find(const T *p, std::size_t n, T v) {
+#ifdef QUEUE_SIMD_X86
+    if(detail::has_avx2())
+        return detail::find_avx2(p, n, v);
+    return detail::find_sse2(p, n, v);
+#else
+    return detail::find_scalar(p, n, v);
+#endif
+}
+
+/**
+	@brief Conteggio degli elementi uguali a un valore
+
+	@tparam T tipo aritmetico a 32 o 64 bit
+
+	@param p puntatore al primo elemento del tratto
+	@param n numero di elementi del tratto
+	@param v valore da contare
+
+	@return numero di elementi uguali a v
+*/
+template <typename T>
+std::size_t count(const T *p, std::size_t n, T v) {
+#ifdef QUEUE_SIMD_X86
+    if(detail::has_avx2())
+        return detail::count_avx2(p, n, v);
+    return detail::count_sse2(p, n, v);
+#else
+    return detail::count_scalar(p, n, v);
+#endif
+}
+
+} // namespace simd
+
+#endif
+
+// Fine file header simd_search.h
@@ -0,0 +1,444 @@
+/**
+	@headerfile spsc_queue.h
+
+    @brief Dichiarazione e definizione della classe spsc_queue
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    spsc_queue, una coda FIFO circolare a capacità limitata, priva di lock,
+    condivisa tra un unico thread produttore e un unico thread consumatore.
+*/
+
+// Guardie del file header spsc_queue.h
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed,
+                  // std::memory_order_acquire, std::memory_order_release
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator
+#include <new> // placement new
+#include <stdexcept> // std::length_error
+#include <utility> // std::move, std::forward
+#include "queue_exceptions.h" // empty_queue_exception, full_queue_exception
+
+// Dichiarazione e definizione della classe template spsc_queue
+
+/**
+	@brief Coda FIFO circolare a singolo produttore e singolo consumatore
+
+	@description
+    Classe template che implementa una coda FIFO di elementi generici T,
+    a capacità limitata, che può essere utilizzata senza lock da esattamente
+    due thread: un produttore, che chiama solo i metodi di inserimento,
+    e un consumatore, che chiama solo i metodi di rimozione e di lettura.
+    Gli elementi sono memorizzati in un buffer circolare la cui capacità
+    è una potenza di 2, fissata alla costruzione.
+    La testa e la coda sono contatori atomici che crescono indefinitamente
+    (l'indice nel buffer si ottiene modulo la capacità): la testa viene
+    scritta solo dal consumatore, la coda solo dal produttore.
+    La pubblicazione di un elemento avviene con una scrittura release
+    della coda, osservata dal consumatore con una lettura acquire
+    (e simmetricamente per il rilascio di una posizione).
+    I due contatori si trovano su linee di cache distinte, per evitare
+    il false sharing, e ciascun thread conserva una copia locale
+    dell'ultimo valore letto del contatore dell'altro thread, rileggendolo
+    solo quando la copia indica una coda piena (o vuota).
+
+    @note La coda non è copiabile né assegnabile: è pensata per essere
+          condivisa, per riferimento, tra i due thread.
+
+	@tparam T tipo del valore degli elementi della coda
+    @tparam E funtore di confronto di uguaglianza del valore di due elementi
+*/
+template <typename T, typename E>
+class spsc_queue {
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+    typedef std::size_t counter_type; ///< @brief Tipo di supporto privato per
+                                      ///< rappresentare i contatori della testa
+                                      ///< e della coda
+
+    /**
+        @brief Dimensione presunta di una linea di cache, in byte
+    */
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+        @brief Capacità massima del buffer, la massima potenza di 2
+               rappresentabile con size_type
+    */
+    static const size_type MAX_CAPACITY = size_type(1) << 31;
+
+	// Dati membro privati della coda
+
+    // Dati in sola lettura dopo la costruzione
+	value_type *_buffer; ///< @brief Buffer circolare
+	size_type _capacity; ///< @brief Capacità del buffer (potenza di 2)
+	counter_type _mask; ///< @brief Maschera per l'indice nel buffer
+
+    E _equals; ///< @brief Oggetto funtore per il confronto di uguaglianza
+               ///< del valore di due elementi della coda
+
+    // Dati del consumatore
+    alignas(CACHE_LINE) std::atomic<counter_type> _head; ///< @brief Contatore
+                                                         ///< della testa
+    counter_type _cached_tail; ///< @brief Ultimo valore letto della coda
+
+    // Dati del produttore
+    alignas(CACHE_LINE) std::atomic<counter_type> _tail; ///< @brief Contatore
+                                                         ///< della coda
+    counter_type _cached_head; ///< @brief Ultimo valore letto della testa
+    // L'allineamento dei membri rende anche la dimensione della coda
+    // un multiplo di CACHE_LINE: i dati del produttore non condividono
+    // la linea di cache con gli oggetti adiacenti.
+
+    // Funzioni private della coda
+
+    /**
+		@brief Inserimento di un elemento costruito sul posto (produttore)
+
+		@description
+        Funzione privata che costruisce un nuovo valore nella posizione
+        indicata dalla coda, inoltrandone gli argomenti al costruttore
+        del tipo T, e lo pubblica al consumatore.
+        Il contatore della testa viene riletto solo se la sua copia locale
+        indica che la coda è piena.
+        Se la costruzione del valore lancia un'eccezione, l'elemento non viene
+        pubblicato e la coda rimane allo stato precedente alla chiamata.
+
+        @tparam Args tipi degli argomenti del costruttore del tipo T
+
+        @param args argomenti del costruttore del tipo T
+
+        @return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+    template <typename... Args>
+    bool try_construct_back(Args&&... args) {
+        const counter_type tail = _tail.load(std::memory_order_relaxed);
+        if(tail - _cached_head == _capacity) {
+            _cached_head = _head.load(std::memory_order_acquire);
+            if(tail - _cached_head == _capacity)
+                return false;
+        }
+
+        new (_buffer + (tail & _mask)) value_type(std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+		@brief Verifica della presenza di un elemento da rimuovere
+		       (consumatore)
+
+		@description
+        Funzione privata che rilegge il contatore della coda solo se la sua
+        copia locale indica che la coda è vuota.
+
+        @param head valore corrente del contatore della testa
+
+        @return true se è presente almeno un elemento, false altrimenti
+	*/
+    bool has_element(counter_type head) {
+        if(head == _cached_tail) {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+            if(head == _cached_tail)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+		@brief Arrotondamento alla potenza di 2 successiva
+
+		@param n numero da arrotondare
+
+		@return la più piccola potenza di 2 non inferiore a n (almeno 2)
+
+		@throw std::length_error se n supera la capacità massima (2^31)
+	*/
+    static size_type round_capacity(size_type n) {
+        if(n > MAX_CAPACITY)
+            throw std::length_error("spsc_queue: capacita' richiesta "
+                                    "troppo grande");
+        size_type c = 2;
+        while(c < n)
+            c *= 2;
+        return c;
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota, allocando il buffer
+	    circolare una volta per tutte.
+	    La capacità viene arrotondata alla potenza di 2 successiva.
+
+		@param capacity numero massimo di elementi contenuti nella coda
+
+		@throw std::length_error se capacity supera la capacità massima (2^31)
+		@throw eccezione di allocazione di memoria
+	*/
+	explicit spsc_queue(size_type capacity) :
+	    _buffer(nullptr), _capacity(round_capacity(capacity)),
+	    _mask(_capacity - 1), _head(0), _cached_tail(0), _tail(0),
+	    _cached_head(0) { // initialization list
+
+	    _buffer = std::allocator<value_type>().allocate(_capacity);
+	}
+
+	spsc_queue(const spsc_queue &other) = delete;
+
+	spsc_queue &operator=(const spsc_queue &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore della coda, che distrugge gli elementi non ancora rimossi
+	    e dealloca il buffer.
+
+	    @pre Nessun thread sta utilizzando la coda.
+	*/
+	virtual ~spsc_queue() {
+	    counter_type head = _head.load(std::memory_order_relaxed);
+	    const counter_type tail = _tail.load(std::memory_order_acquire);
+	    for(; head != tail; ++head)
+	        _buffer[head & _mask].~value_type();
+	    std::allocator<value_type>().deallocate(_buffer, _capacity);
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce il numero
+        di elementi inseriti nella coda.
+        Se chiamato mentre l'altro thread opera sulla coda, il valore
+        restituito è solo indicativo, ma è esatto dal punto di vista
+        del thread chiamante (il produttore non vede mai meno elementi
+        di quanti ne abbia inseriti e non ancora rimossi, e viceversa).
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        const counter_type head = _head.load(std::memory_order_acquire);
+        const counter_type tail = _tail.load(std::memory_order_acquire);
+        return static_cast<size_type>(tail - head);
+    }
+
+    /**
+        @brief Capacità della coda
+
+        @return numero massimo di elementi contenuti nella coda
+    */
+    size_type capacity() const {
+        return _capacity;
+    }
+
+	/**
+		@brief Tentativo di inserimento di un singolo elemento (produttore)
+
+		@description
+	    Metodo dell'interfaccia pubblica che, se la coda non è piena,
+	    inserisce un singolo elemento nella coda, copiandone il valore.
+	    Non utilizza lock e non lancia eccezioni se la coda è piena.
+	    Può essere chiamato solo dal thread produttore.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+	bool try_enqueue(const value_type &value) {
+		return try_construct_back(value);
+	}
+
+	/**
+		@brief Tentativo di inserimento di un singolo elemento per spostamento
+		       (produttore)
+
+		@overload try_enqueue
+
+		@param value valore dell'elemento da spostare nella coda
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+	bool try_enqueue(value_type &&value) {
+		return try_construct_back(std::move(value));
+	}
+
+	/**
+		@brief Tentativo di inserimento di un elemento costruito sul posto
+		       (produttore)
+
+		@tparam Args tipi degli argomenti del costruttore del tipo T
+
+		@param args argomenti del costruttore del tipo T
+
+		@return true se l'elemento è stato inserito, false se la coda è piena
+	*/
+	template <typename... Args>
+	bool try_emplace(Args&&... args) {
+		return try_construct_back(std::forward<Args>(args)...);
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda (produttore)
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un singolo elemento
+	    nella coda, con la stessa semantica di try_enqueue, ma lanciando
+	    un'eccezione apposita se la coda è piena.
+	    Può essere chiamato solo dal thread produttore.
+
+		@param value valore dell'elemento da inserire nella coda
+
+	    @post Il numero di elementi inseriti nella coda viene incrementato
+	          di un'unità.
+
+		@throw full_queue_exception se la coda è piena
+	*/
+	void enqueue(const value_type &value) {
+		if(!try_construct_back(value))
+		    throw full_queue_exception("Impossibile inserire l'elemento: "
+		                               "la coda e' piena.");
+	}
+
+	/**
+		@brief Inserimento di un singolo elemento nella coda per spostamento
+		       (produttore)
+
+		@overload enqueue
+
+		@param value valore dell'elemento da spostare nella coda
+
+		@throw full_queue_exception se la coda è piena
+	*/
+	void enqueue(value_type &&value) {
+		if(!try_construct_back(std::move(value)))
+		    throw full_queue_exception("Impossibile inserire l'elemento: "
+		                               "la coda e' piena.");
+	}
+
+    /**
+        @brief Tentativo di rimozione dell'elemento più vecchio della coda
+               (consumatore)
+
+        @description
+        Metodo dell'interfaccia pubblica che, se la coda non è vuota,
+        rimuove l'elemento più vecchio della coda, spostandone il valore
+        nel parametro passato per riferimento, e rende la sua posizione
+        disponibile al produttore.
+        Non utilizza lock e non lancia eccezioni se la coda è vuota.
+        Può essere chiamato solo dal thread consumatore.
+
+        @param out valore in cui spostare il valore dell'elemento rimosso
+
+        @return true se un elemento è stato rimosso, false se la coda è vuota
+    */
+    bool try_dequeue(value_type &out) {
+        const counter_type head = _head.load(std::memory_order_relaxed);
+        if(!has_element(head))
+            return false;
+
+        value_type &first = _buffer[head & _mask];
+        out = std::move(first);
+        first.~value_type();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+        @brief Rimozione dell'elemento più vecchio della coda (consumatore)
+
+        @description
+        Metodo dell'interfaccia pubblica che rimuove l'elemento più vecchio
+        della coda e ne restituisce il valore, spostandolo anziché copiarlo.
+        Può essere chiamato solo dal thread consumatore.
+
+        @pre La coda non dev'essere vuota.
+
+        @return valore dell'elemento rimosso
+
+        @throw empty_queue_exception se la coda è vuota
+    */
+    value_type dequeue() {
+        const counter_type head = _head.load(std::memory_order_relaxed);
+        if(!has_element(head))
+            throw empty_queue_exception("Impossibile rimuovere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+
+        value_type &first = _buffer[head & _mask];
+        value_type removed_value(std::move(first));
+        first.~value_type();
+        _head.store(head + 1, std::memory_order_release);
+        return removed_value;
+    }
+
+	/**
+		@brief Accesso in lettura all'elemento più vecchio della coda
+		       (consumatore)
+
+	    @pre La coda non dev'essere vuota.
+
+		@return valore dell'elemento più vecchio della coda
+
+	    @throw empty_queue_exception se la coda è vuota
+	*/
+	const value_type &get_head() {
+	    const counter_type head = _head.load(std::memory_order_relaxed);
+		if(!has_element(head))
+            throw empty_queue_exception("Impossibile leggere l'elemento piu' "
+                                        "vecchio: la coda e' vuota.");
+		return _buffer[head & _mask];
+	}
+
+    /**
+        @brief Verifica dell'esistenza di un valore all'interno della coda
+               (consumatore)
+
+        @description
+        Metodo dell'interfaccia pubblica che verifica se un valore è presente
+        tra gli elementi pubblicati dal produttore e non ancora rimossi,
+        confrontando i valori tramite il funtore di uguaglianza.
+        Può essere chiamato solo dal thread consumatore: gli elementi
+        tra la testa e la coda non possono essere modificati dal produttore.
+
+        @param value valore da cercare all'interno della coda
+
+        @return true se il valore è presente all'interno della coda,
+                false altrimenti
+    */
+    bool contains(const value_type &value) const {
+        const counter_type tail = _tail.load(std::memory_order_acquire);
+        for(counter_type i = _head.load(std::memory_order_relaxed); i != tail;
+            ++i)
+            if(_equals(_buffer[i & _mask], value))
+                return true;
+        return false;
+    }
+};
+
+#endif
+
+// Fine file header spsc_queue.h
@@ -0,0 +1,443 @@
+/**
+	@headerfile text_format.h
+
+    @brief Stampa testuale veloce delle code
+
+    @description
+	File header con la stampa delle code nel formato [a, b, c] tramite
+    un buffer di caratteri riutilizzabile: i valori aritmetici vengono
+    convertiti con std::to_chars, gli altri tramite un formattatore
+    specializzabile per tipo, e il buffer viene scritto sullo stream
+    a blocchi, invece di un'operazione di stream per ogni elemento.
+    Utilizzato dagli operatori di stream << delle code.
+*/
+
+// Guardie del file header text_format.h
+
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+// Direttive per il pre-compilatore
+
+#include <charconv> // std::to_chars, std::chars_format
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+#include <ios> // std::ios_base
+#include <locale> // std::locale
+#include <ostream> // std::ostream
+#include <string> // std::string
+#include <string_view> // std::string_view
+#include <system_error> // std::errc
+#include <type_traits> // std::is_arithmetic, std::is_floating_point,
+                       // std::is_same
+#include <vector> // std::vector
+
+/**
+	@brief Stampa testuale delle code
+
+	@description
+    Namespace con il buffer di caratteri, lo scrittore che lo collega
+    a uno stream, il formattatore dei valori e le funzioni di stampa
+    di una sequenza di elementi.
+*/
+namespace text {
+
+/**
+	@brief Buffer di caratteri riutilizzabile
+
+	@description
+    Memoria in cui vengono formattati i caratteri prima di essere scritti
+    sullo stream. La memoria viene allocata alla prima stampa e riusata
+    dalle successive: gli operatori di stream << usano un buffer per thread
+    (vedi thread_buffer).
+*/
+class output_buffer {
+
+    std::vector<char> _data; ///< @brief Memoria del buffer
+
+public:
+
+    /**
+		@brief Dimensione predefinita del buffer, pari a quella dei blocchi
+		       scritti sullo stream
+	*/
+    static constexpr std::size_t BLOCK = 64 * 1024;
+
+    /**
+		@brief Costruttore
+
+		@param capacity numero di caratteri del buffer
+	*/
+    explicit output_buffer(std::size_t capacity = BLOCK) :
+        _data(capacity) {} // initialization list
+
+    output_buffer(const output_buffer &other) = delete;
+    output_buffer &operator=(const output_buffer &other) = delete;
+
+    /**
+		@brief Inizio della memoria del buffer
+	*/
+    char *data() {
+        return _data.data();
+    }
+
+    /**
+		@brief Numero di caratteri del buffer
+	*/
+    std::size_t capacity() const {
+        return _data.size();
+    }
+};
+
+/**
+	@brief Buffer di caratteri del thread corrente
+
+	@return riferimento al buffer del thread corrente, allocato al primo
+	        utilizzo
+*/
+inline output_buffer &thread_buffer() {
+    thread_local output_buffer buffer;
+    return buffer;
+}
+
+/**
+	@brief Scrittore di caratteri su uno stream tramite un buffer
+
+	@description
+    Accumula i caratteri nel buffer e li scrive sullo stream con una sola
+    chiamata write quando il buffer è pieno e alla distruzione.
+    Alla costruzione legge le impostazioni dello stream (base, formato
+    e precisione dei numeri reali, locale) e decide se i numeri possono
+    essere convertiti con std::to_chars producendo gli stessi caratteri
+    dell'operatore <<: in caso contrario, e per i valori senza
+    formattatore, il buffer viene svuotato e il valore stampato
+    con l'operatore << dello stream.
+    Più scrittori possono usare lo stesso buffer solo se annidati
+    (la stampa con put_stream di un elemento che contiene una coda):
+    lo scrittore esterno svuota il buffer prima di cedere lo stream.
+*/
+class writer {
+
+    std::ostream &_os; ///< @brief Stream di destinazione
+    output_buffer &_buffer; ///< @brief Buffer dei caratteri
+    std::size_t _size; ///< @brief Posizione del prossimo carattere
+    bool _plain; ///< @brief I numeri interi possono usare std::to_chars
+    bool _plain_float; ///< @brief I numeri reali possono usare std::to_chars
+    bool _boolalpha; ///< @brief I booleani si stampano come true/false
+    std::chars_format _float_format; ///< @brief Formato dei numeri reali
+    int _precision; ///< @brief Precisione dei numeri reali
+
+    /**
+		@brief Spazio libero nel buffer
+	*/
+    std::size_t available() const {
+        return _buffer.capacity() - _size;
+    }
+
+public:
+
+    /**
+		@brief Costruttore
+
+		@param os stream di destinazione
+		@param buffer buffer dei caratteri (predefinito: quello del thread)
+	*/
+    explicit writer(std::ostream &os, output_buffer &buffer = thread_buffer()) :
+        _os(os), _buffer(buffer), _size(0), _plain(false),
+        _plain_float(false), _boolalpha(false),
+        _float_format(std::chars_format::general), _precision(6) {
+        const std::ios_base::fmtflags f = os.flags();
+        const std::ios_base::fmtflags base = f & std::ios_base::basefield;
+        _plain = (base == std::ios_base::dec || base == 0) &&
+                 !(f & (std::ios_base::showpos | std::ios_base::showbase |
+                        std::ios_base::uppercase | std::ios_base::showpoint)) &&
+                 os.getloc() == std::locale::classic();
+        _boolalpha = (f & std::ios_base::boolalpha) != 0;
+
+        const std::ios_base::fmtflags field = f & std::ios_base::floatfield;
+        _plain_float = _plain && field != (std::ios_base::fixed |
+                                           std::ios_base::scientific);
+        if(field == std::ios_base::fixed)
+            _float_format = std::chars_format::fixed;
+        else if(field == std::ios_base::scientific)
+            _float_format = std::chars_format::scientific;
+        _precision = static_cast<int>(os.precision());
+        if(_precision < 0)
+            _precision = 6;
+    }
+
+    writer(const writer &other) = delete;
+    writer &operator=(const writer &other) = delete;
+
+    /**
+		@brief Distruttore
+
+		@description
+        Scrive sullo stream i caratteri rimasti nel buffer.
+	*/
+    ~writer() {
+        flush();
+    }
+
+    /**
+		@brief Scrittura sullo stream dei caratteri accumulati
+	*/
+    void flush() {
+        if(_size > 0)
+            _os.write(_buffer.data(), static_cast<std::streamsize>(_size));
+        _size = 0;
+    }
+
+    /**
+		@brief Stream di destinazione
+	*/
+    std::ostream &stream() {
+        return _os;
+    }
+
+    /**
+		@brief Aggiunta di un carattere
+	*/
+    void put(char c) {
+        if(available() == 0)
+            flush();
+        _buffer.data()[_size++] = c;
+    }
+
+    /**
+		@brief Aggiunta di una sequenza di caratteri
+	*/
+    void put(std::string_view s) {
+        if(s.size() > available()) {
+            flush();
+            if(s.size() > available()) {
+                _os.write(s.data(), static_cast<std::streamsize>(s.size()));
+                return;
+            }
+        }
+        std::memcpy(_buffer.data() + _size, s.data(), s.size());
+        _size += s.size();
+    }
+
+    /**
+		@brief Stampa di un valore con l'operatore << dello stream
+
+		@description
+        Svuota il buffer, così che i caratteri restino in ordine, e stampa
+        il valore direttamente sullo stream: un eventuale scrittore usato
+        dall'operatore << trova il buffer vuoto.
+	*/
+    template <typename T>
+    void put_stream(const T &value) {
+        flush();
+        _os << value;
+    }
+
+    /**
+		@brief Aggiunta di un numero
+
+		@description
+        Converte il numero con std::to_chars direttamente nel buffer,
+        con la precisione e il formato dello stream per i numeri reali,
+        se le impostazioni dello stream lo consentono; altrimenti lo stampa
+        con put_stream.
+	*/
+    template <typename T>
+    void put_number(T value) {
+        if constexpr(std::is_same<T, bool>::value) {
+            if(_boolalpha && _plain)
+                put(value ? std::string_view("true") :
+                            std::string_view("false"));
+            else if(_plain)
+                put(value ? '1' : '0');
+            else
+                put_stream(value);
+        }
+        else if constexpr(std::is_same<T, char>::value ||
+                          std::is_same<T, signed char>::value ||
+                          std::is_same<T, unsigned char>::value)
+            put(static_cast<char>(value)); // come l'operatore <<
+        else if constexpr(std::is_floating_point<T>::value) {
+            if(!_plain_float || !try_convert([&](char *first, char *last) {
+                   return std::to_chars(first, last, value, _float_format,
+                                        _precision);
+               }))
+                put_stream(value);
+        }
+        else {
+            if(!_plain || !try_convert([&](char *first, char *last) {
+                   return std::to_chars(first, last, value);
+               }))
+                put_stream(value);
+        }
+    }
+
+private:
+
+    /**
+		@brief Conversione di un numero nello spazio libero del buffer
+
+		@description
+        Prova la conversione nello spazio libero; se non basta svuota
+        il buffer e riprova una volta.
+
+		@return false se il numero non sta nemmeno nel buffer vuoto
+	*/
+    template <typename Convert>
+    bool try_convert(Convert convert) {
+        for(int attempt = 0; attempt < 2; ++attempt) {
+            char *first = _buffer.data() + _size;
+            std::to_chars_result r = convert(first, first + available());
+            if(r.ec == std::errc()) {
+                _size += static_cast<std::size_t>(r.ptr - first);
+                return true;
+            }
+            flush();
+        }
+        return false;
+    }
+};
+
+/**
+	@brief Formattatore dei valori degli elementi
+
+	@description
+    Converte un valore in caratteri tramite lo scrittore: i tipi aritmetici
+    con put_number, le stringhe copiandole, gli altri tipi con l'operatore
+    << dello stream (più lento, perché svuota il buffer).
+    Può essere specializzato per i tipi definiti dall'utente, definendo
+    la funzione statica write(writer &, const T &), per scriverli
+    direttamente nel buffer.
+
+    @tparam T tipo del valore da stampare
+*/
+template <typename T>
+struct formatter {
+    static void write(writer &w, const T &value) {
+        if constexpr(std::is_arithmetic<T>::value)
+            w.put_number(value);
+        else if constexpr(std::is_same<T, std::string>::value ||
+                          std::is_same<T, std::string_view>::value)
+            w.put(std::string_view(value));
+        else
+            w.put_stream(value);
+    }
+};
+
+/**
+	@brief Limiti di una stampa
+
+	@description
+    Numero massimo di elementi stampati in testa e in coda: se la sequenza
+    ne contiene di più, quelli intermedi vengono sostituiti da "...".
+*/
+struct print_limits {
+    std::size_t head; ///< @brief Elementi stampati dalla testa
+    std::size_t tail; ///< @brief Elementi stampati dalla coda
+};
+
+/**
+	@brief Stampa di tutti gli elementi
+*/
+inline constexpr print_limits unlimited{static_cast<std::size_t>(-1), 0};
+
+/**
+	@brief Stampa di una sequenza di elementi nel formato [a, b, c]
+
+	@description
+    Scrive la parentesi di apertura con l'operatore << dello stream
+    (che consuma l'eventuale larghezza impostata, come la stampa
+    elemento per elemento), poi gli elementi separati da ", ", formattati
+    con formatter, nel buffer del thread. Se gli elementi sono più di
+    limits.head + limits.tail vengono stampati i primi limits.head,
+    "..." e gli ultimi limits.tail: gli elementi intermedi vengono
+    saltati senza formattarli.
+
+    @tparam It iteratore in lettura della sequenza
+
+	@param os stream di output
+	@param first inizio della sequenza
+	@param last fine della sequenza
+	@param n numero di elementi della sequenza
+	@param limits numero massimo di elementi stampati in testa e in coda
+
+	@return riferimento allo stream di output
+*/
+template <typename It>
+std::ostream &write_sequence(std::ostream &os, It first, It last,
+                             std::size_t n,
+                             print_limits limits = unlimited) {
+    typedef typename std::remove_cv<
+        typename std::remove_reference<decltype(*first)>::type>::type
+        value_type;
+
+    os << "[";
+    {
+        writer w(os);
+        bool limited = limits.head < n && limits.tail < n - limits.head;
+        std::size_t shown = limited ? limits.head : n;
+        std::size_t i = 0;
+        for(; i < shown; ++i, ++first) {
+            if(i != 0)
+                w.put(std::string_view(", "));
+            formatter<value_type>::write(w, *first);
+        }
+        if(limited) {
+            w.put(i != 0 ? std::string_view(", ...") :
+                           std::string_view("..."));
+            for(; i < n - limits.tail; ++i)
+                ++first;
+            for(; first != last; ++first) {
+                w.put(std::string_view(", "));
+                formatter<value_type>::write(w, *first);
+            }
+        }
+    }
+    os << "]";
+
+    return os;
+}
+
+/**
+	@brief Stampa di una coda con un numero massimo di elementi
+
+	@description
+    Oggetto restituito da print, da passare all'operatore di stream <<.
+
+    @tparam C tipo della coda
+*/
+template <typename C>
+struct limited_print {
+    const C &q; ///< @brief Coda da stampare
+    print_limits limits; ///< @brief Limiti della stampa
+};
+
+/**
+	@brief Stampa di una coda limitata ai primi e agli ultimi elementi
+
+	@description
+    Uso: os << text::print(q, 10, 5) stampa i primi 10 e gli ultimi 5
+    elementi di q, separati da "..." se q ne contiene più di 15.
+
+	@param q coda da stampare (con i metodi begin, end e size)
+	@param head numero massimo di elementi stampati dalla testa
+	@param tail numero massimo di elementi stampati dalla coda
+*/
+template <typename C>
+limited_print<C> print(const C &q, std::size_t head, std::size_t tail = 0) {
+    return limited_print<C>{q, print_limits{head, tail}};
+}
+
+/**
+	@brief Operatore di stream << per la stampa limitata di una coda
+*/
+template <typename C>
+std::ostream &operator<<(std::ostream &os, const limited_print<C> &p) {
+    return write_sequence(os, p.q.begin(), p.q.end(), p.q.size(), p.limits);
+}
+
+} // namespace text
+
+#endif
+
+// Fine file header text_format.h
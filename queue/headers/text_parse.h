@@ -0,0 +1,307 @@
+/**
+	@headerfile text_parse.h
+
+    @brief Lettura testuale delle code
+
+    @description
+	File header con la lettura delle code dal formato [a, b, c] prodotto
+    dagli operatori di stream <<: i valori aritmetici vengono letti
+    con std::from_chars, gli altri tramite un lettore specializzabile
+    per tipo, e gli elementi vengono inseriti nella coda a blocchi.
+    Utilizzato dagli operatori di stream >> delle code e da parse_queue.
+*/
+
+// Guardie del file header text_parse.h
+
+#ifndef TEXT_PARSE_H
+#define TEXT_PARSE_H
+
+// Direttive per il pre-compilatore
+
+#include <charconv> // std::from_chars
+#include <cstddef> // std::size_t
+#include <cstring> // std::memchr
+#include <istream> // std::istream
+#include <iterator> // std::make_move_iterator
+#include <string> // std::string, std::char_traits
+#include <string_view> // std::string_view
+#include <system_error> // std::errc
+#include <type_traits> // std::is_arithmetic, std::is_same,
+                       // std::is_trivially_copyable,
+                       // std::remove_cv, std::remove_reference
+#include <utility> // std::move
+#include <vector> // std::vector
+#include "queue_exceptions.h" // parse_queue_exception
+
+namespace text {
+
+/**
+	@brief Fine di un elemento composto
+
+	@description
+    Restituisce la posizione del separatore ", " che segue l'elemento
+    che inizia in first, ignorando i separatori racchiusi tra parentesi
+    tonde, quadre o graffe (numeri complessi, code annidate), oppure
+    last se l'elemento è l'ultimo.
+    Utile ai lettori specializzati per trovare la fine del proprio testo.
+
+	@param first inizio dell'elemento
+	@param last fine del contenuto della coda (la parentesi di chiusura)
+
+	@return posizione della fine dell'elemento
+*/
+inline const char *element_end(const char *first, const char *last) {
+    int depth = 0;
+    for(const char *p = first; p != last; ++p) {
+        char c = *p;
+        if(c == '(' || c == '[' || c == '{')
+            ++depth;
+        else if(c == ')' || c == ']' || c == '}')
+            --depth;
+        else if(c == ',' && depth == 0 && p + 1 != last && p[1] == ' ')
+            return p;
+    }
+    return last;
+}
+
+/**
+	@brief Lettore dei valori degli elementi
+
+	@description
+    Legge dal testo il valore di un elemento, nel formato prodotto
+    da text::formatter con le impostazioni predefinite dello stream:
+    - tipi aritmetici con std::from_chars (per i reali anche inf e nan),
+      bool come 0/1 o true/false, char come singolo carattere;
+    - std::string fino al separatore ", " successivo (le stringhe che
+      contengono ", " non si possono quindi rileggere).
+    Il valore letto viene aggiunto in fondo al blocco out, così che
+    gli elementi vengano costruiti direttamente nel blocco (anche quelli
+    senza costruttore di default).
+    Per gli altri tipi va specializzato definendo la funzione statica
+    read(first, last, out), che restituisce la posizione successiva
+    al testo letto oppure nullptr se il testo non è valido.
+
+    @tparam T tipo del valore da leggere
+*/
+template <typename T>
+struct parser {
+    static const char *read(const char *first, const char *last,
+                            std::vector<T> &out) {
+        if constexpr(std::is_same<T, bool>::value) {
+            std::string_view s(first, static_cast<std::size_t>(last - first));
+            if(s.starts_with("true")) {
+                out.push_back(true);
+                return first + 4;
+            }
+            if(s.starts_with("false")) {
+                out.push_back(false);
+                return first + 5;
+            }
+            if(first == last || (*first != '0' && *first != '1'))
+                return nullptr;
+            out.push_back(*first == '1');
+            return first + 1;
+        }
+        else if constexpr(std::is_same<T, char>::value ||
+                          std::is_same<T, signed char>::value ||
+                          std::is_same<T, unsigned char>::value) {
+            if(first == last)
+                return nullptr;
+            out.push_back(static_cast<T>(*first));
+            return first + 1;
+        }
+        else if constexpr(std::is_arithmetic<T>::value) {
+            T value;
+            std::from_chars_result r = std::from_chars(first, last, value);
+            if(r.ec != std::errc())
+                return nullptr;
+            out.push_back(value);
+            return r.ptr;
+        }
+        else if constexpr(std::is_same<T, std::string>::value) {
+            const char *end = first;
+            for(;;) {
+                const void *comma = std::memchr(end, ',',
+                    static_cast<std::size_t>(last - end));
+                if(comma == nullptr) {
+                    end = last;
+                    break;
+                }
+                end = static_cast<const char *>(comma);
+                if(end + 1 != last && end[1] == ' ')
+                    break;
+                ++end;
+            }
+            out.emplace_back(first, end);
+            return end;
+        }
+        else
+            static_assert(sizeof(T) == 0,
+                          "specializzare text::parser per il tipo T");
+    }
+};
+
+/**
+	@brief Numero di elementi inseriti in un blocco
+*/
+inline constexpr std::size_t PARSE_BATCH = 4096;
+
+/**
+	@brief Lettura di una coda dal testo e inserimento dei suoi elementi
+
+	@description
+    Legge il testo di una coda nel formato [a, b, c] (eventualmente
+    preceduto e seguito da spazi) e inserisce gli elementi in coda a q,
+    in ordine, a blocchi di PARSE_BATCH elementi tramite l'inserimento
+    di un intervallo. Se q ha il metodo reserve, prima della lettura
+    viene riservato lo spazio per un numero di elementi stimato contando
+    i separatori.
+
+    @tparam C tipo della coda
+
+	@param s testo da leggere
+	@param q coda in cui inserire gli elementi
+
+	@return numero di elementi inseriti
+
+    @throw parse_queue_exception se il testo non rispetta il formato
+           (gli elementi dei blocchi già inseriti restano in q)
+*/
+template <typename C>
+std::size_t parse_into(std::string_view s, C &q) {
+    typedef typename std::remove_cv<
+        typename std::remove_reference<decltype(*q.begin())>::type>::type
+        value_type;
+
+    const char *const base = s.data();
+    const char *first = base;
+    const char *last = base + s.size();
+    while(first != last && (*first == ' ' || *first == '\n' ||
+                            *first == '\t' || *first == '\r'))
+        ++first;
+    while(last != first && (last[-1] == ' ' || last[-1] == '\n' ||
+                            last[-1] == '\t' || last[-1] == '\r'))
+        --last;
+    if(first == last || *first != '[')
+        throw parse_queue_exception("atteso '['",
+                                    static_cast<std::size_t>(first - base));
+    if(last - first < 2 || last[-1] != ']')
+        throw parse_queue_exception("attesa ']'",
+                                    static_cast<std::size_t>(last - base));
+    ++first;
+    --last;
+    if(first == last)
+        return 0;
+
+    if constexpr(requires { q.reserve(0u); }) {
+        std::size_t estimate = 1;
+        for(const char *p = first; ; ++p) {
+            p = static_cast<const char *>(std::memchr(p, ',',
+                static_cast<std::size_t>(last - p)));
+            if(p == nullptr)
+                break;
+            ++estimate;
+        }
+        q.reserve(static_cast<unsigned int>(q.size() + estimate));
+    }
+
+    std::vector<value_type> batch;
+    batch.reserve(PARSE_BATCH);
+    std::size_t n = 0;
+    auto flush = [&q, &batch, &n]() {
+        // std::vector<bool> non espone i propri elementi come puntatori
+        if constexpr(std::is_trivially_copyable<value_type>::value &&
+                     !std::is_same<value_type, bool>::value)
+            q.enqueue(static_cast<const value_type *>(batch.data()),
+                      static_cast<const value_type *>(batch.data() +
+                                                      batch.size()));
+        else
+            q.enqueue(std::make_move_iterator(batch.begin()),
+                      std::make_move_iterator(batch.end()));
+        n += batch.size();
+        batch.clear();
+    };
+
+    for(;;) {
+        const char *next = parser<value_type>::read(first, last, batch);
+        if(next == nullptr || (next != last && *next != ','))
+            throw parse_queue_exception("elemento non valido",
+                static_cast<std::size_t>(first - base));
+        if(batch.size() == PARSE_BATCH)
+            flush();
+        if(next == last)
+            break;
+        if(last - next < 2 || next[1] != ' ')
+            throw parse_queue_exception("atteso ', '",
+                static_cast<std::size_t>(next - base));
+        first = next + 2;
+    }
+    flush();
+
+    return n;
+}
+
+/**
+	@brief Lettura di una coda da uno stream
+
+	@description
+    Salta gli spazi iniziali e legge dallo stream il testo di una coda,
+    dalla parentesi quadra di apertura a quella di chiusura corrispondente
+    (contando le parentesi quadre annidate), poi lo interpreta con
+    parse_into in una nuova coda che sostituisce q.
+    Se il testo non rispetta il formato viene impostato il failbit
+    e q non viene modificata; i caratteri letti non vengono restituiti
+    allo stream.
+
+    @tparam C tipo della coda
+
+	@param is stream di input
+	@param q coda da sostituire
+
+	@return riferimento allo stream di input
+*/
+template <typename C>
+std::istream &read_sequence(std::istream &is, C &q) {
+    std::istream::sentry sentry(is);
+    if(!sentry)
+        return is;
+
+    std::streambuf *buf = is.rdbuf();
+    typedef std::char_traits<char> traits;
+    std::string s;
+    int depth = 0;
+    std::istream::int_type c = buf->sgetc();
+    if(traits::eq_int_type(c, traits::eof()) || traits::to_char_type(c) != '[') {
+        is.setstate(std::ios_base::failbit);
+        return is;
+    }
+    do {
+        char ch = traits::to_char_type(buf->sbumpc());
+        s.push_back(ch);
+        if(ch == '[')
+            ++depth;
+        else if(ch == ']' && --depth == 0)
+            break;
+        c = buf->sgetc();
+    } while(!traits::eq_int_type(c, traits::eof()));
+
+    if(depth != 0) {
+        is.setstate(std::ios_base::failbit | std::ios_base::eofbit);
+        return is;
+    }
+    try {
+        C tmp;
+        parse_into(s, tmp);
+        q = std::move(tmp);
+    }
+    catch(const parse_queue_exception &) {
+        is.setstate(std::ios_base::failbit);
+    }
+    return is;
+}
+
+} // namespace text
+
+#endif
+
+// Fine file header text_parse.h
@@ -0,0 +1,355 @@
+/**
+	@headerfile work_stealing_deque.h
+
+    @brief Dichiarazione e definizione della classe work_stealing_deque
+
+    @description
+	File header con dichiarazione e definizione della classe template
+    work_stealing_deque, una coda doppia priva di lock, in cui un thread
+    proprietario inserisce e rimuove gli elementi da un'estremità e
+    un numero qualsiasi di altri thread li sottrae dall'estremità opposta
+    (algoritmo di Chase e Lev).
+*/
+
+// Guardie del file header work_stealing_deque.h
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+// Direttive per il pre-compilatore
+
+#include <atomic> // std::atomic, std::memory_order_relaxed,
+                  // std::memory_order_acquire, std::memory_order_release,
+                  // std::memory_order_seq_cst
+#include <cstdint> // std::int64_t
+#include <cstddef> // std::size_t
+#include <type_traits> // std::is_trivially_copyable
+#include <vector> // std::vector
+
+// Dichiarazione e definizione della classe template work_stealing_deque
+
+/**
+	@brief Coda doppia per il work stealing
+
+	@description
+    Classe template che implementa una coda doppia di elementi generici T,
+    di capacità illimitata, secondo l'algoritmo di Chase e Lev.
+    Il thread proprietario inserisce (push) e rimuove (pop) gli elementi
+    dal fondo, in ordine LIFO; gli altri thread sottraggono (steal)
+    gli elementi dalla cima, in ordine FIFO.
+    Gli elementi sono memorizzati in un array circolare, la cui capacità
+    è una potenza di 2: quando è pieno, il proprietario lo sostituisce
+    con un array di capacità doppia. Gli array sostituiti vengono
+    deallocati solo alla distruzione della coda, poiché un ladro
+    potrebbe ancora leggerli.
+    La cima è modificata solo con compare-and-swap, il fondo solo dal
+    proprietario: le operazioni di pop e steal competono con un
+    compare-and-swap solo per l'ultimo elemento rimasto.
+
+    @note La coda non è copiabile né assegnabile: è pensata per essere
+          condivisa, per riferimento, tra il proprietario e i ladri.
+
+	@tparam T tipo del valore degli elementi della coda, banalmente copiabile
+	          (tipicamente un puntatore)
+*/
+template <typename T>
+class work_stealing_deque {
+
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "work_stealing_deque richiede un tipo banalmente copiabile");
+
+    // Tipi di supporto privati della coda
+    typedef T value_type; ///< @brief Tipo di supporto privato per rappresentare
+                          ///< il tipo generico del valore degli elementi
+                          ///< della coda
+	typedef unsigned int size_type; ///< @brief Tipo di supporto privato per
+                                    ///< rappresentare il numero di elementi
+                                    ///< inseriti nella coda
+    typedef std::int64_t index_type; ///< @brief Tipo di supporto privato per
+                                     ///< rappresentare gli indici della cima
+                                     ///< e del fondo
+
+    /**
+        @brief Dimensione presunta di una linea di cache, in byte
+    */
+    static const std::size_t CACHE_LINE = 64;
+
+    /**
+        @brief Array circolare degli elementi della coda
+    */
+    struct circular_array {
+        index_type capacity; ///< @brief Capacità dell'array (potenza di 2)
+        index_type mask; ///< @brief Maschera per la posizione nell'array
+        std::atomic<value_type> *slots; ///< @brief Posizioni dell'array
+
+        /**
+            @brief Costruttore dell'array circolare
+
+            @param c capacità dell'array (potenza di 2)
+
+            @throw eccezione di allocazione di memoria
+        */
+        explicit circular_array(index_type c) :
+            capacity(c), mask(c - 1),
+            slots(new std::atomic<value_type>[c]) { // initialization list
+        }
+
+        circular_array(const circular_array &other) = delete;
+
+        circular_array &operator=(const circular_array &other) = delete;
+
+        /**
+            @brief Distruttore dell'array circolare
+        */
+        ~circular_array() {
+            delete[] slots;
+        }
+
+        /**
+            @brief Lettura del valore in posizione i (modulo la capacità)
+        */
+        value_type get(index_type i) const {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+
+        /**
+            @brief Scrittura del valore in posizione i (modulo la capacità)
+        */
+        void put(index_type i, value_type value) {
+            slots[i & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+
+	// Dati membro privati della coda
+
+    // Dati condivisi con i ladri
+    alignas(CACHE_LINE) std::atomic<index_type> _top; ///< @brief Indice della
+                                                      ///< cima
+    alignas(CACHE_LINE) std::atomic<index_type> _bottom; ///< @brief Indice del
+                                                         ///< fondo
+    std::atomic<circular_array *> _array; ///< @brief Array corrente
+
+    // Dati del proprietario
+    std::vector<circular_array *> _arrays; ///< @brief Array allocati,
+                                           ///< compreso quello corrente
+
+    // Funzioni private della coda
+
+    /**
+		@brief Raddoppio della capacità dell'array (proprietario)
+
+		@description
+        Funzione privata che alloca un array di capacità doppia, vi copia
+        gli elementi tra la cima e il fondo e lo pubblica ai ladri.
+        L'array precedente resta allocato fino alla distruzione della coda.
+
+        @param array array corrente
+        @param top indice della cima
+        @param bottom indice del fondo
+
+        @return nuovo array corrente
+
+        @throw eccezione di allocazione di memoria
+	*/
+    circular_array *grow(circular_array *array, index_type top,
+                         index_type bottom) {
+        _arrays.reserve(_arrays.size() + 1);
+        circular_array *bigger = new circular_array(2 * array->capacity);
+        for(index_type i = top; i < bottom; ++i)
+            bigger->put(i, array->get(i));
+        _arrays.push_back(bigger);
+        _array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    /**
+        @brief Arrotondamento della capacità alla potenza di 2 successiva
+               (almeno 2)
+    */
+    static index_type round_capacity(size_type n) {
+        index_type c = 2;
+        while(c < n)
+            c *= 2;
+        return c;
+    }
+
+public:
+
+    // Interfaccia pubblica della coda
+
+	// Metodi fondamentali della coda
+
+	/**
+		@brief Costruttore (METODO FONDAMENTALE)
+
+		@description
+	    Costruttore che istanzia una coda vuota.
+	    La capacità iniziale viene arrotondata alla potenza di 2 successiva.
+
+		@param capacity capacità iniziale della coda
+
+		@throw eccezione di allocazione di memoria
+	*/
+	explicit work_stealing_deque(size_type capacity = 64) :
+	    _top(0), _bottom(0), _array(nullptr) { // initialization list
+
+	    _arrays.push_back(new circular_array(round_capacity(capacity)));
+	    _array.store(_arrays.back(), std::memory_order_relaxed);
+	}
+
+	work_stealing_deque(const work_stealing_deque &other) = delete;
+
+	work_stealing_deque &operator=(const work_stealing_deque &other) = delete;
+
+	/**
+		@brief Distruttore (METODO FONDAMENTALE)
+
+		@description
+	    Distruttore della coda, che dealloca tutti gli array circolari.
+	    I valori non ancora rimossi non vengono distrutti (il tipo T
+	    è banalmente copiabile).
+
+	    @pre Nessun thread sta utilizzando la coda.
+	*/
+	virtual ~work_stealing_deque() {
+	    for(circular_array *array : _arrays)
+	        delete array;
+	}
+
+	// Fine metodi fondamentali della coda
+
+	// Ulteriori metodi dell'interfaccia pubblica della coda
+
+    /**
+        @brief Numero di elementi inseriti nella coda
+
+        @description
+        Metodo dell'interfaccia pubblica che restituisce il numero
+        di elementi inseriti nella coda.
+        Se chiamato mentre altri thread operano sulla coda, il valore
+        restituito è solo indicativo.
+
+        @return numero di elementi inseriti nella coda
+    */
+    size_type size() const {
+        const index_type bottom = _bottom.load(std::memory_order_acquire);
+        const index_type top = _top.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+
+    /**
+        @brief Verifica se la coda è vuota
+
+        @return true se la coda non contiene elementi (valore indicativo
+                se altri thread operano sulla coda)
+    */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+        @brief Capacità dell'array corrente
+
+        @return numero di elementi inseribili senza raddoppiare l'array
+    */
+    size_type capacity() const {
+        return static_cast<size_type>(
+            _array.load(std::memory_order_acquire)->capacity);
+    }
+
+	/**
+		@brief Inserimento di un elemento sul fondo (proprietario)
+
+		@description
+	    Metodo dell'interfaccia pubblica che inserisce un elemento sul fondo
+	    della coda, raddoppiando l'array se è pieno.
+	    Può essere chiamato solo dal thread proprietario.
+
+		@param value valore dell'elemento da inserire nella coda
+
+		@throw eccezione di allocazione di memoria (la coda rimane allo stato
+		       precedente alla chiamata)
+	*/
+	void push(value_type value) {
+	    const index_type bottom = _bottom.load(std::memory_order_relaxed);
+	    const index_type top = _top.load(std::memory_order_acquire);
+	    circular_array *array = _array.load(std::memory_order_relaxed);
+	    if(bottom - top > array->capacity - 1)
+	        array = grow(array, top, bottom);
+	    array->put(bottom, value);
+	    _bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	/**
+		@brief Rimozione di un elemento dal fondo (proprietario)
+
+		@description
+	    Metodo dell'interfaccia pubblica che rimuove l'elemento inserito
+	    più di recente, copiandone il valore nel parametro.
+	    Se è rimasto un solo elemento, compete con i ladri tramite
+	    un compare-and-swap sulla cima.
+	    Può essere chiamato solo dal thread proprietario.
+
+		@param out valore in cui copiare il valore dell'elemento rimosso
+
+		@return true se un elemento è stato rimosso, false se la coda è vuota
+		        (o l'ultimo elemento è stato sottratto da un ladro)
+	*/
+	bool pop(value_type &out) {
+	    const index_type bottom = _bottom.load(std::memory_order_relaxed) - 1;
+	    circular_array *array = _array.load(std::memory_order_relaxed);
+	    // la scrittura del fondo deve precedere la lettura della cima
+	    // nell'ordine totale delle operazioni seq_cst (come in steal)
+	    _bottom.store(bottom, std::memory_order_seq_cst);
+	    index_type top = _top.load(std::memory_order_seq_cst);
+
+	    if(top > bottom) {
+	        _bottom.store(bottom + 1, std::memory_order_relaxed);
+	        return false;
+	    }
+
+	    out = array->get(bottom);
+	    if(top == bottom) {
+	        bool won = _top.compare_exchange_strong(top, top + 1,
+	                                                std::memory_order_seq_cst,
+	                                                std::memory_order_relaxed);
+	        _bottom.store(bottom + 1, std::memory_order_relaxed);
+	        return won;
+	    }
+	    return true;
+	}
+
+	/**
+		@brief Sottrazione di un elemento dalla cima (ladro)
+
+		@description
+	    Metodo dell'interfaccia pubblica che rimuove l'elemento inserito
+	    meno di recente, copiandone il valore nel parametro.
+	    Può essere chiamato da qualsiasi thread, senza lock.
+
+		@param out valore in cui copiare il valore dell'elemento sottratto
+
+		@return true se un elemento è stato sottratto, false se la coda
+		        è vuota o se un altro thread ha rimosso lo stesso elemento
+		        (in tal caso il chiamante può ritentare)
+	*/
+	bool steal(value_type &out) {
+	    index_type top = _top.load(std::memory_order_seq_cst);
+	    const index_type bottom = _bottom.load(std::memory_order_seq_cst);
+	    if(top >= bottom)
+	        return false;
+
+	    circular_array *array = _array.load(std::memory_order_acquire);
+	    value_type value = array->get(top);
+	    if(!_top.compare_exchange_strong(top, top + 1,
+	                                     std::memory_order_seq_cst,
+	                                     std::memory_order_relaxed))
+	        return false;
+	    out = value;
+	    return true;
+	}
+};
+
+#endif
+
+// Fine file header work_stealing_deque.h
@@ -16,17 +16,69 @@
 #include <iostream> // std::cout, std::endl
 #include <cassert> // assert
 #include <string> // std::string
+#include <limits> // std::numeric_limits
 #include <vector> // std::vector
 #include <list> // std::list
+#include <memory_resource> // std::pmr::monotonic_buffer_resource
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::milliseconds
+#include <iterator> // std::back_inserter
+#include <functional> // std::function
+#include <stdexcept> // std::runtime_error, std::length_error
+#include <coroutine> // std::coroutine_handle, std::suspend_never
+#include <exception> // std::terminate
+#include <sstream> // std::ostringstream
+#include <iomanip> // std::setprecision, std::setw
+#include <charconv> // std::from_chars
+#include <cstddef> // offsetof
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
 #include "./headers/queue.h" // queue, transformif,
-                             // operatore di stream << per la classe queue,
+                             // operatori di stream << e >> per la classe
+                             // queue, parse_queue, serialize, deserialize,
                              // empty_queue_exception,
-                             // queue_iterator_out_of_bounds_exception
+                             // queue_iterator_out_of_bounds_exception,
+                             // parse_queue_exception,
+                             // serialize_queue_exception
+#include "./headers/chunked_queue.h" // chunked_queue, transformif,
+                                     // operatori di stream << e >> per la classe
+                                     // chunked_queue
+#include "./headers/ring_queue.h" // ring_queue, transformif,
+                                  // operatori di stream << e >> per la classe
+                                  // ring_queue
+#include "./headers/text_format.h" // text::formatter, text::print
+#include "./headers/text_parse.h" // text::parser, text::parse_into
+#include "./headers/binary_io.h" // binary::codec, binary::read_queue_into
+#include "./headers/simd_search.h" // plain_equality_tag, is_simd_searchable
+#include "./headers/spsc_queue.h" // spsc_queue, full_queue_exception
+#include "./headers/mpmc_queue.h" // mpmc_queue
+#include "./headers/blocking_queue.h" // blocking_queue
+#include "./headers/work_stealing_deque.h" // work_stealing_deque
+#include "./headers/executor.h" // executor
+#include "./headers/sharded_queue.h" // sharded_queue
+#include "./headers/flat_combining_queue.h" // flat_combining_queue
+#include "./headers/async_queue.h" // async_queue
+#include "./headers/multicast_ring.h" // multicast_ring
+#include "./headers/multilevel_queue.h" // multilevel_queue, transformif,
+                                        // operatore di stream << per la
+                                        // classe multilevel_queue,
+                                        // invalid_level_exception
+#include "./headers/delay_queue.h" // delay_queue
+#include "./headers/hashed_queue.h" // hashed_queue, transformif,
+                                    // operatore di stream << per la classe
+                                    // hashed_queue
+#include "./headers/execution.h" // execution::seq, execution::unseq,
+                                 // execution::par, execution::par_unseq,
+                                 // execution::speculative_op_tag,
+                                 // transformif con politica di esecuzione
+#include "./headers/algorithms.h" // count_if, find_if, reduce,
+                                  // transform_into, remove_if
 
 /**
 	@brief Funtore per l'uguaglianza tra interi
 */
-struct equal_int {
+struct equal_int : plain_equality_tag {
     bool operator()(int i1, int i2) const {
         return i1 == i2;
     }
@@ -58,7 +110,7 @@ int double_int(int i) {
 /**
 	@brief Funtore per l'uguaglianza tra float
 */
-struct equal_float {
+struct equal_float : plain_equality_tag {
     bool operator()(float f1, float f2) const {
         return f1 == f2;
     }
@@ -244,6 +296,51 @@ std::ostream &operator<<(std::ostream &os, const complex &c) {
     return os;
 }
 
+/**
+	@brief Formattatore di un numero complesso
+
+    @description
+	Scrive il numero complesso direttamente nel buffer della stampa
+    delle code, nello stesso formato dell'operatore di stream <<.
+*/
+template <>
+struct text::formatter<complex> {
+    static void write(text::writer &w, const complex &c) {
+        w.put('(');
+        w.put_number(c.real);
+        w.put(", ");
+        w.put_number(c.imaginary);
+        w.put(')');
+    }
+};
+
+/**
+	@brief Lettore di un numero complesso
+
+    @description
+	Legge un numero complesso nel formato (re, im) prodotto dal
+    formattatore, per la lettura delle code con parse_queue e
+    l'operatore di stream >>.
+*/
+template <>
+struct text::parser<complex> {
+    static const char *read(const char *first, const char *last,
+                            std::vector<complex> &out) {
+        int re, im;
+        if(first == last || *first != '(')
+            return nullptr;
+        std::from_chars_result r = std::from_chars(first + 1, last, re);
+        if(r.ec != std::errc() || last - r.ptr < 2 || r.ptr[0] != ',' ||
+           r.ptr[1] != ' ')
+            return nullptr;
+        r = std::from_chars(r.ptr + 2, last, im);
+        if(r.ec != std::errc() || r.ptr == last || *r.ptr != ')')
+            return nullptr;
+        out.emplace_back(re, im);
+        return r.ptr + 1;
+    }
+};
+
 /**
 	@brief Funtore di uguaglianza di due numeri complessi
 */
@@ -314,6 +411,84 @@ std::ostream &operator<<(std::ostream &os, const employee &e) {
     return os;
 }
 
+/**
+	@brief Formattatore di un impiegato
+
+    @description
+	Scrive l'impiegato direttamente nel buffer della stampa delle code,
+    nello stesso formato dell'operatore di stream <<.
+*/
+template <>
+struct text::formatter<employee> {
+    static void write(text::writer &w, const employee &e) {
+        w.put('{');
+        w.put(e.name);
+        w.put(' ');
+        w.put(e.surname);
+        w.put(": ");
+        w.put_number(e.salary);
+        w.put('}');
+    }
+};
+
+/**
+	@brief Lettore di un impiegato
+
+    @description
+	Legge un impiegato nel formato {nome cognome: salario} prodotto dal
+    formattatore; il nome non può contenere spazi.
+*/
+template <>
+struct text::parser<employee> {
+    static const char *read(const char *first, const char *last,
+                            std::vector<employee> &out) {
+        if(first == last || *first != '{')
+            return nullptr;
+        std::string_view s(first + 1, static_cast<std::size_t>(last - first - 1));
+        std::size_t space = s.find(' ');
+        std::size_t colon = s.find(": ");
+        if(space == std::string_view::npos || colon == std::string_view::npos ||
+           colon < space)
+            return nullptr;
+        unsigned int salary;
+        const char *number = s.data() + colon + 2;
+        std::from_chars_result r = std::from_chars(number, last, salary);
+        if(r.ec != std::errc() || r.ptr == last || *r.ptr != '}')
+            return nullptr;
+        out.emplace_back(std::string(s.substr(0, space)),
+                         std::string(s.substr(space + 1, colon - space - 1)),
+                         salary);
+        return r.ptr + 1;
+    }
+};
+
+/**
+	@brief Codificatore binario di un impiegato
+
+    @description
+	Scrive nome e cognome con il codificatore delle stringhe, seguiti
+    dal salario, per la serializzazione binaria delle code.
+*/
+template <>
+struct binary::codec<employee> {
+    static void write(binary::writer &w, const employee &e) {
+        binary::codec<std::string>::write(w, e.name);
+        binary::codec<std::string>::write(w, e.surname);
+        w.put_value(e.salary);
+    }
+
+    static bool read(binary::reader &r, std::vector<employee> &out) {
+        std::vector<std::string> names;
+        unsigned int salary;
+        if(!binary::codec<std::string>::read(r, names) ||
+           !binary::codec<std::string>::read(r, names) ||
+           !r.get_value(salary))
+            return false;
+        out.emplace_back(std::move(names[0]), std::move(names[1]), salary);
+        return true;
+    }
+};
+
 /**
 	@brief Funtore di uguaglianza di due impiegati
 
@@ -380,6 +555,31 @@ employee half_salary_employee(const employee &e) {
 */
 typedef queue<int, equal_int> queue_int;
 
+/**
+	@brief Lettore di una coda di interi
+
+    @description
+	Legge una coda di interi annidata nel testo di una coda di code,
+    delimitandola con text::element_end.
+*/
+template <>
+struct text::parser<queue_int> {
+    static const char *read(const char *first, const char *last,
+                            std::vector<queue_int> &out) {
+        const char *end = text::element_end(first, last);
+        try {
+            queue_int q;
+            text::parse_into(std::string_view(first,
+                static_cast<std::size_t>(end - first)), q);
+            out.push_back(std::move(q));
+        }
+        catch(const parse_queue_exception &) {
+            return nullptr;
+        }
+        return end;
+    }
+};
+
 /**
 	@brief Funtore di uguaglianza di due code di interi
 
@@ -478,12 +678,13 @@ struct add_queue_int {
     }
 };
 
-template <typename E, typename T, typename P, typename F>
-void test_queue(const std::vector<T> values, const std::list<T> enqueue_values,
-        T set_tail_value, T set_head_value, P pred, F op) {
+template <typename Q, typename E, typename T, typename P, typename F>
+void test_container(const std::vector<T> values,
+        const std::list<T> enqueue_values, T set_tail_value, T set_head_value,
+        P pred, F op) {
 
     typedef T value_type;
-    typedef queue<value_type, E> queue;
+    typedef Q queue;
     typedef unsigned int size_type;
 
     E equals;
@@ -602,6 +803,69 @@ void test_queue(const std::vector<T> values, const std::list<T> enqueue_values,
     }
     std::cout << std::endl;
 
+    std::cout << "try_dequeue:" << std::endl;
+    queue q_try(q);
+    value_type out = set_tail_value;
+    typename queue::const_iterator it_expected = q.begin();
+    while(q_try.try_dequeue(out)) {
+        std::cout << "Valore dell'elemento rimosso: " << out << std::endl;
+        assert(equals(out, *it_expected));
+        ++it_expected;
+    }
+    assert(it_expected == q.end());
+    assert(q_try.size() == 0);
+    std::cout << std::endl;
+
+    std::cout << "try_dequeue su coda vuota:" << std::endl;
+    value_type unchanged = out;
+    assert(!q_try.try_dequeue(out));
+    assert(equals(out, unchanged));
+    std::cout << "Nessun elemento rimosso." << std::endl;
+    q_try.enqueue(set_head_value); // la coda svuotata rimane utilizzabile
+    assert(q_try.try_dequeue(out) && equals(out, set_head_value));
+    std::cout << std::endl;
+
+    std::cout << "clear:" << std::endl;
+    queue q_clear(q);
+    q_clear.clear();
+    std::cout << q_clear << std::endl;
+    assert(q_clear.size() == 0);
+    assert(q_clear.begin() == q_clear.end());
+    q_clear.clear(); // clear su coda vuota
+    q_clear.enqueue(set_tail_value); // la coda svuotata rimane utilizzabile
+    assert(q_clear.size() == 1 && equals(q_clear.get_head(), set_tail_value));
+    std::cout << q_clear << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "enqueue da vettore su coda vuota:" << std::endl;
+    queue q_range;
+    q_range.enqueue(values.begin(), values.end());
+    std::cout << q_range << std::endl;
+    assert(q_range.size() == values.size());
+    assert(equals(q_range.get_head(), values.front()));
+    assert(equals(q_range.get_tail(), values.back()));
+    q_range.enqueue(values.end(), values.end()); // sequenza vuota
+    assert(q_range.size() == values.size());
+    std::cout << std::endl;
+
+    std::cout << "splice:" << std::endl;
+    queue q_splice;
+    q_splice.splice(queue(q_range)); // su coda vuota
+    assert(q_splice.size() == values.size());
+    queue q_other(q_range);
+    q_splice.splice(std::move(q_other));
+    std::cout << q_splice << std::endl;
+    assert(q_other.size() == 0);
+    assert(q_splice.size() == 2 * values.size());
+    assert(equals(q_splice.get_tail(), values.back()));
+    q_other.enqueue(set_tail_value); // la coda concatenata rimane utilizzabile
+    q_splice.splice(std::move(q_other));
+    assert(equals(q_splice.get_tail(), set_tail_value));
+    q_splice.splice(std::move(q_splice)); // nessun effetto
+    q_splice.splice(queue()); // nessun effetto
+    assert(q_splice.size() == 2 * values.size() + 1);
+    std::cout << std::endl;
+
     std::cout << "get_tail:" << std::endl;
     value_type tail = q.get_tail();
     std::cout << "Valore dell'elemento in coda: " << tail << std::endl;
@@ -910,6 +1174,22 @@ void test_queue(const std::vector<T> values, const std::list<T> enqueue_values,
     std::cout << " e' presente nella coda." << std::endl;
     assert(!q_contains);
 
+    std::cout << "find e count:" << std::endl;
+    for(size_type i = 0; i < values.size(); ++i) {
+        size_type expected = 0;
+        for(size_type j = 0; j < values.size(); ++j)
+            if(equals(values[j], values[i]))
+                ++expected;
+        typename queue::const_iterator found = const_queue.find(values[i]);
+        assert(found != const_queue.end() && equals(*found, values[i]));
+        assert(const_queue.count(values[i]) == expected);
+    }
+    assert(const_queue.find(set_tail_value) == const_queue.end());
+    assert(const_queue.count(set_tail_value) == 0);
+    std::cout << "Il valore " << values[0] << " compare " <<
+                 const_queue.count(values[0]) << " volte nella coda." <<
+                 std::endl;
+
     std::cout << std::endl;
     std::cout << "******** Test degli iteratori ********" << std::endl;
     std::cout << std::endl;
@@ -957,6 +1237,35 @@ void test_queue(const std::vector<T> values, const std::list<T> enqueue_values,
     std::cout << const_queue << std::endl;
 }
 
+template <typename E, typename T, typename P, typename F>
+void test_queue(const std::vector<T> values, const std::list<T> enqueue_values,
+        T set_tail_value, T set_head_value, P pred, F op) {
+
+    test_container<queue<T, E>, E>(values, enqueue_values, set_tail_value,
+                                   set_head_value, pred, op);
+
+    /*
+        La stessa batteria di test viene ripetuta sulla coda a blocchi,
+        con blocchi di dimensione ridotta per attraversarne i confini.
+    */
+    std::cout << std::endl;
+    std::cout << "******** Stessi test su una coda a blocchi ********" <<
+                 std::endl;
+    std::cout << std::endl;
+
+    test_container<chunked_queue<T, E, 2>, E>(values, enqueue_values,
+                                              set_tail_value, set_head_value,
+                                              pred, op);
+
+    std::cout << std::endl;
+    std::cout << "******** Stessi test su una coda circolare ********" <<
+                 std::endl;
+    std::cout << std::endl;
+
+    test_container<ring_queue<T, E>, E>(values, enqueue_values, set_tail_value,
+                                        set_head_value, pred, op);
+}
+
 void test_queue_int() {
 	
 	std::cout << std::endl;
@@ -981,6 +1290,18 @@ void test_queue_int() {
 	
 	test_queue<equal_int>(values, enqueue_values, set_tail_value,
 	                      set_head_value, even_int, double_int);
+
+    std::cout << "Capacita' oltre il massimo della coda circolare:" <<
+                 std::endl;
+    ring_queue<int, equal_int> r;
+    bool thrown = false;
+    try {
+        r.reserve((1u << 31) + 1);
+    }
+    catch(const std::length_error &) {
+        thrown = true;
+    }
+    assert(thrown && r.capacity() == 0);
 }
 
 void test_queue_float() {
@@ -1156,35 +1477,2300 @@ void test_queue_queue_int() {
                                 add_queue_int(10));
 }
 
-void test_continue() {
-	
+void test_queue_pool() {
+
 	std::cout << std::endl;
-	std::cout << "******** Fine test precedente ********" << std::endl;
+	std::cout << "******** Test del pool dei nodi liberi ********" << std::endl;
+	std::cout << std::endl;
+
+    queue_int q;
+    assert(q.pool_capacity() == queue_int::DEFAULT_POOL_CAPACITY);
+    assert(q.pool_size() == 0);
+
+    std::cout << "Ciclo stazionario di inserimenti e rimozioni:" << std::endl;
+    for(int i = 0; i < 1000; ++i) {
+        q.enqueue(i);
+        assert(q.dequeue() == i);
+    }
+    std::cout << "Riutilizzi: " << q.pool_hits() << ", allocazioni: " <<
+                 q.pool_misses() << std::endl;
+    assert(q.pool_misses() == 1);
+    assert(q.pool_hits() == 999);
+    assert(q.pool_size() == 1);
+    std::cout << std::endl;
+
+    std::cout << "Capacita' del pool superata:" << std::endl;
+    for(int i = 0; i < 100; ++i)
+        q.enqueue(i);
+    while(q.size() > 0)
+        q.dequeue();
+    std::cout << "Nodi liberi nel pool: " << q.pool_size() << std::endl;
+    assert(q.pool_size() == queue_int::DEFAULT_POOL_CAPACITY);
+    std::cout << std::endl;
+
+    std::cout << "set_pool_capacity:" << std::endl;
+    q.set_pool_capacity(10);
+    std::cout << "Nodi liberi nel pool: " << q.pool_size() << std::endl;
+    assert(q.pool_size() == 10);
+    q.set_pool_capacity(0);
+    unsigned long misses = q.pool_misses();
+    q.enqueue(1);
+    q.dequeue();
+    assert(q.pool_size() == 0);
+    assert(q.pool_misses() == misses + 1);
+    std::cout << "Pool disabilitato: nessun nodo libero conservato." <<
+                 std::endl;
+    std::cout << std::endl;
+
+    std::cout << "clear (i nodi rimossi tornano nel pool):" << std::endl;
+    for(int i = 0; i < 100; ++i)
+        q.enqueue(i);
+    q.clear();
+    assert(q.size() == 0 && q.pool_size() == 0);
+    q.set_pool_capacity(queue_int::DEFAULT_POOL_CAPACITY);
+    for(int i = 0; i < 100; ++i)
+        q.enqueue(i);
+    q.clear();
+    std::cout << "Nodi liberi nel pool: " << q.pool_size() << std::endl;
+    assert(q.pool_size() == queue_int::DEFAULT_POOL_CAPACITY);
+    std::cout << std::endl;
+
+    std::cout << "Distruzione di una coda molto lunga (senza ricorsione):" <<
+                 std::endl;
+    {
+        queue_int q_long;
+        for(int i = 0; i < 1000000; ++i)
+            q_long.enqueue(i);
+        queue_int q_long2;
+        q_long2 = q_long;
+        q_long.clear();
+        assert(q_long.size() == 0 && q_long2.size() == 1000000);
+    }
+    std::cout << "Eseguita." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "enqueue da vettore (memoria acquisita in anticipo):" <<
+                 std::endl;
+    std::vector<int> batch(200, 1);
+    for(int i = 0; i < 100; ++i)
+        q.enqueue(i);
+    q.clear();
+    unsigned long hits = q.pool_hits();
+    misses = q.pool_misses();
+    q.enqueue(batch.begin(), batch.end());
+    std::cout << "Riutilizzi: " << (q.pool_hits() - hits) <<
+                 ", allocazioni: " << (q.pool_misses() - misses) << std::endl;
+    assert(q.pool_hits() - hits == queue_int::DEFAULT_POOL_CAPACITY);
+    assert(q.pool_misses() - misses ==
+           batch.size() - queue_int::DEFAULT_POOL_CAPACITY);
+    assert(q.size() == batch.size() && q.pool_size() == 0);
+    q.clear();
+    std::cout << std::endl;
+
+    std::cout << "Copy Constructor (capacita' del pool):" << std::endl;
+    q.set_pool_capacity(5);
+    q.enqueue(7);
+    queue_int q2(q);
+    assert(q2.pool_capacity() == 5);
+    assert(q2.pool_hits() == 0 && q2.pool_misses() == 1);
+    std::cout << q2 << std::endl;
 }
 
-void test() {
-	
-	std::cout << "**************** INIZIO TEST ****************" << std::endl;
+/**
+	@brief Allocatore con identificativo che si propaga in copia, spostamento
+           e scambio
 
-	test_queue_int();
+    @description
+	Allocatore di test che delega a std::allocator, ma porta con sé
+    un identificativo: due allocatori sono uguali solo se hanno lo stesso
+    identificativo. Permette di verificare che la coda rispetti i traits
+    di propagazione dell'allocatore.
+*/
+template <typename T>
+struct tagged_allocator {
 
-	test_continue();
-	test_queue_float();
+    typedef T value_type; ///< @brief Tipo dei valori allocati
+    typedef std::true_type propagate_on_container_copy_assignment; ///< @brief
+                                                                   ///< Trait
+    typedef std::true_type propagate_on_container_move_assignment; ///< @brief
+                                                                   ///< Trait
+    typedef std::true_type propagate_on_container_swap; ///< @brief Trait
 
-	test_continue();
-	test_queue_bool();
+    int id; ///< @brief Identificativo dell'allocatore
 
-	test_continue();
-	test_queue_string();
+    tagged_allocator(int i) : id(i) {} // initialization list
 
-	test_continue();
-	test_queue_complex();
+    template <typename U>
+    tagged_allocator(const tagged_allocator<U> &other) :
+        id(other.id) {} // initialization list
 
-	test_continue();
-	test_queue_employee();
+    T *allocate(std::size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
 
-	test_continue();
-	test_queue_queue_int();
+    void deallocate(T *p, std::size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const tagged_allocator &other) const {
+        return id == other.id;
+    }
+
+    bool operator!=(const tagged_allocator &other) const {
+        return id != other.id;
+    }
+};
+
+void test_queue_allocator() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test dell'allocatore della coda ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "pmr::queue su monotonic_buffer_resource:" << std::endl;
+    static unsigned char buffer[64 * 1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+    {
+        pmr::queue<int, equal_int> q(&arena);
+        for(int i = 0; i < 100; ++i)
+            q.enqueue(i);
+        assert(q.size() == 100);
+        assert(q.get_allocator().resource() == &arena);
+        assert(q.get_head() == 0 && q.get_tail() == 99);
+        std::cout << "Elementi allocati nell'arena: " << q.size() << std::endl;
+
+        pmr::queue<int, equal_int> q2;
+        q2 = q; // polymorphic_allocator non si propaga nell'assegnamento
+        assert(q2.get_allocator().resource() != &arena);
+        assert(q2.size() == 100);
+
+        std::cout << "Copia con allocatore esplicito:" << std::endl;
+        pmr::queue<int, equal_int> q3(q, &arena);
+        assert(q3.get_allocator().resource() == &arena);
+        assert(q3.size() == 100);
+    }
+    arena.release();
+    std::cout << std::endl;
+
+    typedef queue<int, equal_int, tagged_allocator<int> > tagged_queue;
+
+    std::cout << "Propagazione nell'assegnamento:" << std::endl;
+    tagged_queue q1(tagged_allocator<int>(1));
+    tagged_queue q2(tagged_allocator<int>(2));
+    q1.enqueue(1);
+    q2.enqueue(2);
+    q2.enqueue(3);
+    q1 = q2;
+    std::cout << q1 << std::endl;
+    assert(q1.get_allocator().id == 2);
+    assert(q1.size() == 2);
+    std::cout << std::endl;
+
+    std::cout << "Propagazione nello scambio:" << std::endl;
+    tagged_queue q3(tagged_allocator<int>(3));
+    q3.enqueue(4);
+    swap(q1, q3);
+    std::cout << q1 << " " << q3 << std::endl;
+    assert(q1.get_allocator().id == 3 && q3.get_allocator().id == 2);
+    assert(q1.size() == 1 && q3.size() == 2);
+    std::cout << std::endl;
+
+    std::cout << "splice tra allocatori diversi:" << std::endl;
+    tagged_queue q5(tagged_allocator<int>(5));
+    q5.enqueue(5);
+    q3.splice(std::move(q5)); // i valori vengono spostati in nuovi elementi
+    std::cout << q3 << std::endl;
+    assert(q3.size() == 3 && q3.get_tail() == 5);
+    assert(q5.size() == 0 && q3.get_allocator().id == 2);
+    std::cout << std::endl;
+
+    std::cout << "Copy Constructor:" << std::endl;
+    tagged_queue q4(q3);
+    std::cout << q4 << std::endl;
+    assert(q4.get_allocator().id == 2);
+}
+
+/**
+	@brief Test della semantica di spostamento di una coda
+
+    @description
+	Verifica enqueue per spostamento, emplace, il Move Constructor
+    e l'operatore di assegnamento per spostamento su un tipo di coda.
+
+    @tparam Q tipo della coda di code di interi
+    @tparam S tipo della coda di impiegati
+*/
+template <typename Q, typename S>
+void test_move_container() {
+
+    std::cout << "enqueue per spostamento di una coda annidata:" << std::endl;
+    Q q;
+    queue_int inner;
+    for(int i = 0; i < 3; ++i)
+        inner.enqueue(i);
+    q.enqueue(std::move(inner));
+    assert(inner.size() == 0);
+    assert(q.size() == 1 && q.get_head().size() == 3);
+    q.enqueue(inner); // copia di una coda vuota
+    assert(q.size() == 2 && q.get_tail().size() == 0);
+    std::cout << q << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "emplace:" << std::endl;
+    S s;
+    s.emplace("Mario", "Rossi", 1000);
+    s.emplace(employee("Luigi", "Verdi", 2000));
+    assert(s.size() == 2);
+    assert(s.get_head().name == "Mario" && s.get_tail().salary == 2000);
+    std::cout << s << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Move Constructor:" << std::endl;
+    Q q2(std::move(q));
+    assert(q.size() == 0 && q2.size() == 2);
+    assert(q2.get_head().get_tail() == 2);
+    q.enqueue(queue_int()); // la coda spostata rimane utilizzabile
+    assert(q.size() == 1);
+    std::cout << q2 << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Operatore di assegnamento per spostamento:" << std::endl;
+    q = std::move(q2);
+    assert(q.size() == 2 && q2.size() == 0);
+    assert(q.get_head().size() == 3);
+    q = std::move(q);
+    assert(q.size() == 2);
+    std::cout << q << std::endl;
+}
+
+void test_queue_move() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della semantica di spostamento ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    test_move_container<queue<queue_int, equal_queue_int>,
+                        queue<employee, equal_employee> >();
+
+    std::cout << std::endl;
+    std::cout << "Assegnamento per spostamento tra allocatori diversi:" <<
+                 std::endl;
+    std::pmr::monotonic_buffer_resource arena;
+    pmr::queue<std::string, equal_string> q1(&arena);
+    pmr::queue<std::string, equal_string> q2;
+    q1.enqueue(std::string("primo"));
+    q1.emplace(3, 'x');
+    q2 = std::move(q1); // polymorphic_allocator non si propaga
+    assert(q2.get_allocator().resource() != &arena);
+    assert(q1.size() == 0 && q2.size() == 2);
+    assert(q2.get_head() == "primo" && q2.get_tail() == "xxx");
+    std::cout << q2 << std::endl;
+
+	std::cout << std::endl;
+	std::cout << "Stessi test su una coda a blocchi:" << std::endl;
+	std::cout << std::endl;
+    test_move_container<chunked_queue<queue_int, equal_queue_int, 2>,
+                        chunked_queue<employee, equal_employee, 2> >();
+
+	std::cout << std::endl;
+	std::cout << "Stessi test su una coda circolare:" << std::endl;
+	std::cout << std::endl;
+    test_move_container<ring_queue<queue_int, equal_queue_int>,
+                        ring_queue<employee, equal_employee> >();
+}
+
+void test_spsc_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda a singolo produttore e singolo "
+                 "consumatore ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Costruttore (capacita' arrotondata):" << std::endl;
+    spsc_queue<std::string, equal_string> q(5);
+    std::cout << "Capacita': " << q.capacity() << std::endl;
+    assert(q.capacity() == 8 && q.size() == 0);
+    bool too_large = false;
+    try {
+        spsc_queue<int, equal_int> huge((1u << 31) + 1);
+    }
+    catch(const std::length_error &) {
+        too_large = true;
+    }
+    assert(too_large);
+    std::cout << std::endl;
+
+    std::cout << "try_enqueue fino alla capacita':" << std::endl;
+    for(unsigned int i = 0; i < q.capacity(); ++i)
+        assert(q.try_enqueue(std::string(i + 1, 'a')));
+    assert(!q.try_enqueue(std::string("piena")));
+    assert(q.size() == 8);
+    assert(q.contains("aaa") && !q.contains("piena"));
+    std::cout << "Elementi inseriti: " << q.size() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "enqueue su coda piena:" << std::endl;
+    try {
+        q.enqueue("piena");
+    }
+    catch(full_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "try_dequeue e dequeue:" << std::endl;
+    std::string out;
+    assert(q.try_dequeue(out) && out == "a");
+    assert(q.get_head() == "aa");
+    assert(q.dequeue() == "aa");
+    assert(q.try_enqueue(std::string("b"))); // posizioni riutilizzate
+    assert(q.try_emplace(2, 'b'));
+    while(q.try_dequeue(out))
+        std::cout << out << " ";
+    std::cout << std::endl;
+    assert(out == "bb" && q.size() == 0);
+    assert(!q.try_dequeue(out) && out == "bb");
+    std::cout << std::endl;
+
+    std::cout << "dequeue su coda vuota:" << std::endl;
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Produttore e consumatore su thread distinti:" << std::endl;
+    const int n = 200000;
+    spsc_queue<int, equal_int> q2(64);
+    long long sum = 0;
+    bool ordered = true;
+    std::thread consumer([&]() {
+        int expected = 0;
+        int value;
+        while(expected < n) {
+            if(q2.try_dequeue(value)) {
+                ordered = ordered && (value == expected);
+                sum += value;
+                ++expected;
+            }
+            else
+                std::this_thread::yield();
+        }
+    });
+    for(int i = 0; i < n; ++i)
+        while(!q2.try_enqueue(i))
+            std::this_thread::yield();
+    consumer.join();
+    std::cout << "Somma dei valori ricevuti: " << sum << std::endl;
+    assert(ordered);
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+    assert(q2.size() == 0);
+    std::cout << std::endl;
+
+    std::cout << "Distruttore con elementi non rimossi:" << std::endl;
+    {
+        spsc_queue<std::string, equal_string> q3(4);
+        q3.enqueue("x");
+        q3.enqueue("y");
+    }
+    std::cout << "Eseguito." << std::endl;
+}
+
+void test_mpmc_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda a piu' produttori e piu' "
+                 "consumatori ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "enqueue, try_dequeue e dequeue su un solo thread:" <<
+                 std::endl;
+    mpmc_queue<std::string, equal_string> q;
+    assert(q.empty());
+    q.enqueue(std::string("uno"));
+    q.emplace(3, 'x');
+    std::string s("tre");
+    q.enqueue(s);
+    assert(!q.empty());
+    std::string out;
+    assert(q.try_dequeue(out) && out == "uno");
+    assert(q.dequeue() == "xxx");
+    assert(q.try_dequeue(out) && out == "tre");
+    assert(!q.try_dequeue(out) && out == "tre");
+    assert(q.empty());
+    std::cout << "Eseguiti." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "dequeue su coda vuota:" << std::endl;
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Stress test con 4 produttori e 4 consumatori:" << std::endl;
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 50000;
+    const int total = producers * per_producer;
+    mpmc_queue<int, equal_int> q2;
+    std::atomic<int> consumed(0);
+    std::vector<std::vector<int> > received(consumers,
+                                            std::vector<int>(total, 0));
+    std::vector<char> ordered(consumers, 1);
+    std::vector<std::thread> threads;
+    for(int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&, c]() {
+            std::vector<int> last(producers, -1);
+            int value;
+            while(consumed.load() < total) {
+                if(!q2.try_dequeue(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(1);
+                received[c][value]++;
+                // i valori di uno stesso produttore arrivano in ordine
+                int p = value / per_producer;
+                if(value % per_producer <= last[p])
+                    ordered[c] = 0;
+                last[p] = value % per_producer;
+            }
+        }));
+    for(int p = 0; p < producers; ++p)
+        threads.push_back(std::thread([&, p]() {
+            for(int i = 0; i < per_producer; ++i)
+                q2.enqueue(p * per_producer + i);
+        }));
+    for(std::thread &t : threads)
+        t.join();
+    for(int v = 0; v < total; ++v) {
+        int count = 0;
+        for(int c = 0; c < consumers; ++c)
+            count += received[c][v];
+        assert(count == 1); // ogni valore ricevuto esattamente una volta
+    }
+    for(int c = 0; c < consumers; ++c)
+        assert(ordered[c]);
+    assert(q2.empty());
+    std::cout << "Valori ricevuti esattamente una volta: " << total <<
+                 std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Distruttore con elementi non rimossi:" << std::endl;
+    {
+        mpmc_queue<std::string, equal_string> q3;
+        q3.enqueue("x");
+        q3.enqueue("y");
+        q3.dequeue();
+    }
+    std::cout << "Eseguito." << std::endl;
+}
+
+void test_blocking_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda bloccante ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "try_enqueue e try_dequeue su un solo thread:" << std::endl;
+    blocking_queue<std::string, equal_string> q(2);
+    assert(q.capacity() == 2 && q.size() == 0);
+    assert(q.try_enqueue(std::string("uno")));
+    q.enqueue("due");
+    assert(!q.try_enqueue(std::string("tre")));
+    std::string out;
+    assert(q.try_dequeue(out) && out == "uno");
+    assert(q.dequeue() == "due");
+    assert(!q.try_dequeue(out) && out == "uno");
+    std::cout << "Eseguiti." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "enqueue_for e dequeue_for con tempo scaduto:" << std::endl;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    assert(!q.dequeue_for(out, std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >=
+           std::chrono::milliseconds(20));
+    q.enqueue("a");
+    q.enqueue("b");
+    std::string moved("c");
+    assert(!q.enqueue_for(std::move(moved), std::chrono::milliseconds(20)));
+    assert(moved == "c"); // il valore non viene spostato se non inserito
+    assert(q.size() == 2);
+    assert(q.dequeue_for(out, std::chrono::milliseconds(20)) && out == "a");
+    assert(q.enqueue_for(std::move(moved), std::chrono::milliseconds(20)));
+    std::cout << "Eseguiti." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Rimozione a blocchi:" << std::endl;
+    std::vector<std::string> drained;
+    assert(q.dequeue_bulk(std::back_inserter(drained), 10) == 2);
+    assert(drained.size() == 2 && drained[0] == "b" && drained[1] == "c");
+    assert(q.size() == 0);
+    // con max 0 non attende, anche se la coda è vuota
+    assert(q.dequeue_bulk(std::back_inserter(drained), 0) == 0);
+    assert(drained.size() == 2);
+    std::cout << "Eseguita." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Attesa di produttori e consumatori su thread distinti:" <<
+                 std::endl;
+    const int n = 20000;
+    blocking_queue<int, equal_int> q2(16);
+    long long sum = 0;
+    bool ordered = true;
+    std::thread consumer([&]() {
+        std::vector<int> batch;
+        int expected = 0;
+        while(expected < n) {
+            if(expected % 2 == 0) {
+                int value = q2.dequeue(); // bloccante
+                ordered = ordered && (value == expected);
+                sum += value;
+                ++expected;
+            }
+            else {
+                batch.clear();
+                q2.dequeue_bulk(std::back_inserter(batch), 8);
+                for(int value : batch) {
+                    ordered = ordered && (value == expected);
+                    sum += value;
+                    ++expected;
+                }
+            }
+        }
+    });
+    std::vector<int> values;
+    for(int i = 0; i < n / 2; ++i)
+        values.push_back(i);
+    q2.enqueue(values.begin(), values.end()); // a blocchi, bloccante
+    for(int i = n / 2; i < n; ++i)
+        q2.enqueue(i);
+    consumer.join();
+    std::cout << "Somma dei valori ricevuti: " << sum << std::endl;
+    assert(ordered);
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+    assert(q2.size() == 0);
+    std::cout << std::endl;
+
+    std::cout << "Consumatore risvegliato da un inserimento:" << std::endl;
+    std::thread waiter([&]() {
+        int value = 0;
+        bool received = q2.dequeue_for(value, std::chrono::seconds(10));
+        assert(received && value == 42);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    q2.enqueue(42);
+    waiter.join();
+    std::cout << "Eseguito." << std::endl;
+}
+
+void test_work_stealing_deque() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda per il work stealing ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "push, pop e steal su un solo thread:" << std::endl;
+    work_stealing_deque<int> d(4);
+    assert(d.empty() && d.capacity() == 4);
+    for(int i = 0; i < 100; ++i)
+        d.push(i);
+    assert(d.size() == 100 && d.capacity() == 128);
+    int out = -1;
+    assert(d.pop(out) && out == 99); // il proprietario preleva l'ultimo
+    assert(d.steal(out) && out == 0); // i ladri prelevano il primo
+    assert(d.size() == 98);
+    while(d.pop(out))
+        ;
+    assert(out == 1 && d.empty() && !d.steal(out));
+    std::cout << "Eseguiti." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Proprietario e 3 ladri su thread distinti:" << std::endl;
+    const int n = 200000;
+    const int thieves = 3;
+    work_stealing_deque<int> d2;
+    std::vector<std::vector<char> > taken(thieves + 1,
+                                          std::vector<char>(n, 0));
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for(int t = 1; t <= thieves; ++t)
+        threads.push_back(std::thread([&, t]() {
+            int value;
+            while(!done.load() || !d2.empty())
+                if(d2.steal(value))
+                    taken[t][value]++;
+        }));
+    int value;
+    for(int i = 0; i < n; ++i) {
+        d2.push(i);
+        if(i % 3 == 0 && d2.pop(value))
+            taken[0][value]++;
+    }
+    while(d2.pop(value))
+        taken[0][value]++;
+    done.store(true);
+    for(std::thread &t : threads)
+        t.join();
+    int stolen = 0;
+    bool once = true;
+    for(int i = 0; i < n; ++i) {
+        int count = 0;
+        for(int t = 0; t <= thieves; ++t)
+            count += taken[t][i];
+        once = once && (count == 1);
+    }
+    for(int t = 1; t <= thieves; ++t)
+        for(int i = 0; i < n; ++i)
+            stolen += taken[t][i];
+    std::cout << "Elementi sottratti dai ladri: " << stolen << std::endl;
+    assert(once); // ogni elemento è prelevato esattamente una volta
+}
+
+void test_executor() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test del pool di thread ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Task sottomessi da un thread esterno:" << std::endl;
+    executor ex(4);
+    assert(ex.thread_count() == 4);
+    std::atomic<int> count(0);
+    for(int i = 0; i < 1000; ++i)
+        ex.submit([&count]() { count.fetch_add(1); });
+    ex.wait_all();
+    std::cout << "Task eseguiti: " << count.load() << std::endl;
+    assert(count.load() == 1000);
+    std::cout << std::endl;
+
+    std::cout << "Fork/join con task sottomessi dai task:" << std::endl;
+    std::atomic<int> leaves(0);
+    std::function<void(int)> fork = [&](int depth) {
+        if(depth == 0) {
+            leaves.fetch_add(1);
+            return;
+        }
+        ex.submit([&fork, depth]() { fork(depth - 1); });
+        ex.submit([&fork, depth]() { fork(depth - 1); });
+    };
+    ex.submit([&fork]() { fork(12); });
+    ex.wait_all();
+    std::cout << "Foglie raggiunte: " << leaves.load() << std::endl;
+    assert(leaves.load() == 4096);
+    std::cout << std::endl;
+
+    std::cout << "Eccezione lanciata da un task:" << std::endl;
+    ex.submit([]() { throw std::runtime_error("errore nel task"); });
+    ex.submit([&count]() { count.fetch_add(1); });
+    try {
+        ex.wait_all();
+        assert(false);
+    }
+    catch(std::runtime_error &e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(count.load() == 1001); // gli altri task vengono eseguiti
+    ex.wait_all(); // l'eccezione viene riportata una sola volta
+}
+
+void test_sharded_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda suddivisa in corsie ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Inserimenti e rimozioni su un solo thread:" << std::endl;
+    sharded_queue<std::string, equal_string> q(4);
+    assert(q.lanes() == 4 && q.order() == q.per_producer);
+    q.enqueue(std::string("uno"));
+    std::string s("due");
+    q.enqueue(s);
+    q.enqueue("tre");
+    assert(q.size() == 3);
+    assert(q.contains("due") && !q.contains("quattro"));
+    // un solo produttore: l'ordine di inserimento è rispettato
+    assert(q.dequeue() == "uno");
+    assert(q.dequeue() == "due");
+    std::string out;
+    assert(q.try_dequeue(out) && out == "tre");
+    assert(!q.try_dequeue(out) && q.size() == 0);
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    // valori senza costruttore di default
+    sharded_queue<employee, equal_employee> qe(2);
+    qe.enqueue(employee("Mario", "Rossi", 1500));
+    qe.enqueue(employee("Anna", "Bianchi", 2000));
+    assert(qe.dequeue().salary == 1500);
+    employee e("", "", 0);
+    assert(qe.try_dequeue(e) && e.salary == 2000 && !qe.try_dequeue(e));
+    std::cout << std::endl;
+
+    std::cout << "Ordine FIFO globale tra produttori successivi:" << std::endl;
+    sharded_queue<int, equal_int> q2(4, sharded_queue<int, equal_int>::
+                                         approximate_fifo);
+    for(int t = 0; t < 8; ++t) {
+        std::thread producer([&q2, t]() {
+            q2.enqueue(2 * t);
+            q2.enqueue(2 * t + 1);
+        });
+        producer.join();
+    }
+    for(int i = 0; i < 16; ++i)
+        assert(q2.dequeue() == i);
+    std::cout << "Eseguito." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Stress test con 4 produttori e 2 consumatori:" << std::endl;
+    const int producers = 4;
+    const int consumers = 2;
+    const int per_producer = 20000;
+    const int total = producers * per_producer;
+    sharded_queue<int, equal_int> q3(producers);
+    std::atomic<int> consumed(0);
+    std::vector<char> received(total, 0);
+    std::vector<char> ordered(consumers, 1);
+    std::vector<std::thread> threads;
+    for(int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&, c]() {
+            std::vector<int> last(producers, -1);
+            int value;
+            while(consumed.load() < total) {
+                if(!q3.try_dequeue(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(1);
+                received[value]++;
+                // i valori di uno stesso produttore arrivano in ordine
+                int p = value / per_producer;
+                if(value % per_producer <= last[p])
+                    ordered[c] = 0;
+                last[p] = value % per_producer;
+            }
+        }));
+    for(int p = 0; p < producers; ++p)
+        threads.push_back(std::thread([&, p]() {
+            for(int i = 0; i < per_producer; ++i)
+                q3.enqueue(p * per_producer + i);
+        }));
+    for(std::thread &t : threads)
+        t.join();
+    bool once = true;
+    for(int i = 0; i < total; ++i)
+        once = once && (received[i] == 1);
+    std::cout << "Valori ricevuti: " << consumed.load() << std::endl;
+    assert(once && ordered[0] && ordered[1] && q3.size() == 0);
+    std::cout << std::endl;
+
+    std::cout << "Ricerca parallela nelle corsie:" << std::endl;
+    threads.clear();
+    for(int p = 0; p < producers; ++p)
+        threads.push_back(std::thread([&, p]() {
+            for(int i = 0; i < per_producer; ++i)
+                q3.enqueue(p * per_producer + i);
+        }));
+    for(std::thread &t : threads)
+        t.join();
+    assert(q3.size() == total);
+    assert(q3.contains(total - 1) && q3.contains(0));
+    assert(!q3.contains(total));
+    std::cout << "Eseguita." << std::endl;
+}
+
+void test_flat_combining_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda con flat combining ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Inserimenti e rimozioni su un solo thread:" << std::endl;
+    flat_combining_queue<std::string, equal_string> q;
+    q.enqueue(std::string("uno"));
+    std::string s("due");
+    q.enqueue(s);
+    assert(q.size() == 2);
+    assert(q.dequeue() == "uno");
+    std::string out;
+    assert(q.try_dequeue(out) && out == "due");
+    assert(!q.try_dequeue(out) && out == "due" && q.size() == 0);
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Stress test con 8 thread e 4 posizioni per le richieste:" <<
+                 std::endl;
+    const int threads = 8;
+    const int per_thread = 20000;
+    const int total = threads * per_thread;
+    flat_combining_queue<int, equal_int> q2(4);
+    std::vector<std::vector<int> > received(threads);
+    std::vector<char> ordered(threads, 1);
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&, t]() {
+            std::vector<int> last(threads, -1);
+            int value;
+            // ogni thread inserisce i propri valori e ne rimuove altrettanti
+            for(int i = 0; i < per_thread; ++i) {
+                q2.enqueue(t * per_thread + i);
+                while(!q2.try_dequeue(value))
+                    std::this_thread::yield();
+                received[t].push_back(value);
+                // i valori di uno stesso thread arrivano in ordine
+                int p = value / per_thread;
+                if(value % per_thread <= last[p])
+                    ordered[t] = 0;
+                last[p] = value % per_thread;
+            }
+        }));
+    for(std::thread &t : workers)
+        t.join();
+    std::vector<char> seen(total, 0);
+    bool once = true;
+    int count = 0;
+    for(int t = 0; t < threads; ++t) {
+        assert(ordered[t]);
+        for(int value : received[t])
+            once = once && (seen[value]++ == 0);
+        count += static_cast<int>(received[t].size());
+    }
+    std::cout << "Valori ricevuti: " << count << std::endl;
+    assert(once && q2.size() == 0);
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra coroutine
+*/
+struct equal_handle {
+    bool operator()(std::coroutine_handle<> h1,
+                    std::coroutine_handle<> h2) const {
+        return h1 == h2;
+    }
+};
+
+/**
+	@brief Coroutine senza risultato, avviata subito e distrutta al termine
+*/
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() { return detached_task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+	@brief Event loop a singolo thread
+
+    @description
+	Riprende, in ordine FIFO, le coroutine di cui è stata pianificata
+    la ripresa.
+*/
+class event_loop {
+
+    ring_queue<std::coroutine_handle<>, equal_handle> _ready; ///< @brief
+                                                              ///< Coroutine
+                                                              ///< pronte
+
+public:
+
+    void post(std::coroutine_handle<> handle) {
+        _ready.enqueue(handle);
+    }
+
+    /**
+		@brief Esecuzione delle coroutine pronte, comprese quelle pianificate
+		       durante l'esecuzione
+
+        @return numero di coroutine riprese
+	*/
+    unsigned int run() {
+        unsigned int resumed = 0;
+        std::coroutine_handle<> handle;
+        while(_ready.try_dequeue(handle)) {
+            handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+};
+
+/**
+	@brief Scheduler che affida la ripresa delle coroutine a un event loop
+
+    @description
+	Se l'inserimento nell'event loop fallisce il programma termina:
+    async_queue richiede uno scheduler noexcept.
+*/
+struct loop_scheduler {
+    event_loop *loop; ///< @brief Event loop
+
+    void operator()(std::coroutine_handle<> handle) const noexcept {
+        loop->post(handle);
+    }
+};
+
+typedef async_queue<int, equal_int, loop_scheduler> async_queue_int;
+
+/**
+	@brief Consumatore di un solo valore
+*/
+detached_task consume_one(async_queue_int &q, std::vector<int> &received,
+                          int index) {
+    received[index] = co_await q.dequeue();
+}
+
+/**
+	@brief Consumatore che somma i valori fino al primo valore negativo
+*/
+detached_task consume_until_negative(async_queue_int &q, long long &sum) {
+    while(true) {
+        int value = co_await q.dequeue();
+        if(value < 0)
+            break;
+        sum += value;
+    }
+}
+
+/**
+	@brief Produttore che inserisce i valori da 1 a n, seguiti da -1,
+	       cedendo il controllo all'event loop dopo ogni inserimento
+*/
+detached_task produce(async_queue_int &q, async_queue_int &ticks, int n) {
+    for(int i = 1; i <= n; ++i) {
+        q.enqueue(i);
+        ticks.enqueue(0);
+        co_await ticks.dequeue();
+    }
+    q.enqueue(-1);
+}
+
+void test_async_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda asincrona ********" << std::endl;
+	std::cout << std::endl;
+
+    event_loop loop;
+    async_queue_int q(loop_scheduler{&loop});
+    std::vector<int> received(1000, -1);
+
+    std::cout << "co_await su coda non vuota:" << std::endl;
+    q.enqueue(5);
+    consume_one(q, received, 0); // non viene sospesa
+    assert(received[0] == 5 && q.size() == 0 && q.waiting() == 0);
+    std::cout << "Eseguito." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "1000 coroutine in attesa su coda vuota:" << std::endl;
+    for(int i = 0; i < 1000; ++i)
+        consume_one(q, received, i);
+    assert(q.waiting() == 1000 && loop.run() == 0);
+    for(int i = 0; i < 1000; ++i)
+        q.enqueue(i);
+    // enqueue consegna i valori ma non riprende le coroutine
+    assert(q.waiting() == 0 && q.size() == 0 && received[999] == -1);
+    assert(loop.run() == 1000);
+    bool fifo = true;
+    for(int i = 0; i < 1000; ++i)
+        fifo = fifo && (received[i] == i);
+    assert(fifo); // le coroutine ricevono i valori nell'ordine di attesa
+    std::cout << "Eseguito." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Produttore e consumatore sullo stesso event loop:" <<
+                 std::endl;
+    async_queue_int ticks(loop_scheduler{&loop});
+    long long sum = 0;
+    consume_until_negative(q, sum);
+    produce(q, ticks, 100);
+    loop.run();
+    std::cout << "Somma dei valori ricevuti: " << sum << std::endl;
+    assert(sum == 5050 && q.waiting() == 0 && ticks.waiting() == 0);
+}
+
+void test_multicast_ring() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test del buffer multicast ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Pubblicazione e lettura su un solo thread:" << std::endl;
+    multicast_ring<std::string, equal_string> r(4, 2);
+    assert(r.capacity() == 4 && r.consumers() == 2);
+    bool too_large = false;
+    try {
+        multicast_ring<int, equal_int> huge((1u << 31) + 1, 1);
+    }
+    catch(const std::length_error &) {
+        too_large = true;
+    }
+    assert(too_large);
+    assert(r.try_publish(std::string("a")));
+    r.publish("b");
+    std::string s("c");
+    assert(r.try_publish(s));
+    r.publish("d");
+    assert(!r.try_publish("e")); // buffer pieno
+    std::string read;
+    std::string all;
+    assert(r.available(0) == 4 && r.available(1) == 4);
+    assert(r.consume(0, [&all](const std::string &v) { all += v; }) == 4);
+    assert(all == "abcd" && r.available(0) == 0);
+    // le posizioni non sono liberate finché il consumatore 1 non le legge
+    assert(!r.try_publish("e"));
+    assert(r.try_read(1, read) && read == "a");
+    assert(r.try_read(1, read) && read == "b");
+    assert(r.try_publish("e") && r.try_publish("f") && !r.try_publish("g"));
+    assert(r.try_read(0, read) && read == "e");
+    all.clear();
+    assert(r.consume(1, [&all](const std::string &v) { all += v; }, 3) == 3);
+    assert(all == "cde" && r.available(1) == 1 && r.available(0) == 1);
+    std::cout << "Eseguite." << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Un produttore e 3 consumatori su thread distinti:" <<
+                 std::endl;
+    const int n = 100000;
+    const int consumers = 3;
+    multicast_ring<int, equal_int> r2(64, consumers);
+    std::vector<long long> sums(consumers, 0);
+    std::vector<char> ordered(consumers, 1);
+    std::vector<std::thread> threads;
+    for(int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&, c]() {
+            int expected = 0;
+            while(expected < n)
+                if(r2.consume(c, [&](int value) {
+                       ordered[c] = ordered[c] && (value == expected);
+                       sums[c] += value;
+                       ++expected;
+                   }) == 0)
+                    std::this_thread::yield();
+        }));
+    for(int i = 0; i < n; ++i)
+        r2.publish(i);
+    for(std::thread &t : threads)
+        t.join();
+    for(int c = 0; c < consumers; ++c) {
+        std::cout << "Somma ricevuta dal consumatore " << c << ": " <<
+                     sums[c] << std::endl;
+        assert(ordered[c]);
+        assert(sums[c] == static_cast<long long>(n) * (n - 1) / 2);
+    }
+}
+
+void test_multilevel_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda a piu' livelli ********" << std::endl;
+	std::cout << std::endl;
+
+    multilevel_queue<int, equal_int, 8> q;
+    assert(q.levels() == 8 && q.size() == 0 && q.begin() == q.end());
+
+    std::cout << "Inserimento in livelli diversi:" << std::endl;
+    q.enqueue(2, 20);
+    q.enqueue(0, 1);
+    q.enqueue(7, 70);
+    q.enqueue(2, 21);
+    q.emplace(0, 2);
+    q.enqueue(7, 71);
+    assert(q.size() == 6 && q.size(2) == 2 && q.size(5) == 0);
+    assert(q.top_level() == 7 && q.get_head() == 70);
+    std::cout << q << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Inserimento in un livello inesistente:" << std::endl;
+    try {
+        q.enqueue(8, 80);
+    }
+    catch(invalid_level_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(q.size() == 6);
+    std::cout << std::endl;
+
+    std::cout << "contains e transformif:" << std::endl;
+    assert(q.contains(21) && q.contains(1) && !q.contains(3));
+    const multilevel_queue<int, equal_int, 8> &cq = q;
+    int visited = 0;
+    for(multilevel_queue<int, equal_int, 8>::const_iterator i = cq.begin();
+        i != cq.end(); ++i)
+        ++visited;
+    assert(visited == 6);
+    transformif(q, [](int v) { return v < 10; }, [](int v) { return -v; });
+    std::cout << q << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Copia, rimozione per priorita' e FIFO nel livello:" <<
+                 std::endl;
+    multilevel_queue<int, equal_int, 8> copy(q);
+    const int expected[] = {70, 71, 20, 21, -1, -2};
+    for(int v : expected) {
+        assert(q.get_head() == v);
+        assert(q.dequeue() == v);
+    }
+    assert(q.size() == 0 && q.begin() == q.end());
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    int out = 0;
+    assert(!q.try_dequeue(out));
+    assert(copy.size() == 6 && copy.try_dequeue(out) && out == 70);
+    std::cout << "Copia dopo una rimozione: " << copy << std::endl;
+
+    std::cout << "Reinserimento dopo lo svuotamento di un livello:" <<
+                 std::endl;
+    copy.enqueue(3, 30);
+    copy.dequeue();
+    assert(copy.top_level() == 3 && copy.dequeue() == 30);
+    assert(copy.top_level() == 2);
+    q = std::move(copy);
+    assert(copy.size() == 0 && q.size() == 4);
+    q.clear();
+    assert(q.size() == 0 && !q.contains(20));
+    q.enqueue(1, 10);
+    assert(q.top_level() == 1 && q.dequeue() == 10);
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Orologio manuale per i test della coda con scadenza
+
+    @description
+	Orologio il cui istante corrente viene impostato dal test, in modo
+    che le scadenze siano deterministiche.
+*/
+struct manual_clock {
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<manual_clock> time_point;
+    static const bool is_steady = true;
+
+    static inline time_point current{}; ///< @brief Istante corrente
+
+    static time_point now() {
+        return current;
+    }
+};
+
+void test_delay_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda con scadenza ********" << std::endl;
+	std::cout << std::endl;
+
+    typedef manual_clock::time_point time_point;
+    typedef std::chrono::milliseconds ms;
+    manual_clock::current = time_point();
+    delay_queue<int, equal_int, manual_clock> q;
+    assert(q.size() == 0 && q.resolution() == ms(1));
+
+    std::cout << "Inserimento con scadenze su piu' livelli della ruota:" <<
+                 std::endl;
+    const time_point t0 = manual_clock::now();
+    q.enqueue(t0 + ms(300), 3);
+    q.enqueue(t0 + ms(5), 1);
+    q.enqueue(t0 + std::chrono::hours(2), 5);
+    q.enqueue(t0 + ms(300), 4);
+    q.emplace(t0 + ms(70000), 6);
+    q.enqueue(t0 + ms(40), 2);
+    q.enqueue(t0 + std::chrono::nanoseconds(4500001), 0); // arrotondata a 5 ms
+    assert(q.size() == 7 && q.ready_size() == 0);
+    assert(q.contains(5) && q.contains(2) && !q.contains(7));
+
+    int out = -1;
+    assert(!q.try_dequeue(out) && out == -1);
+    try {
+        q.dequeue();
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    manual_clock::current = t0 + std::chrono::nanoseconds(4999999);
+    assert(!q.try_dequeue(out)); // mai in anticipo
+    manual_clock::current = t0 + ms(5);
+    assert(q.dequeue() == 1 && q.dequeue() == 0 && !q.try_dequeue(out));
+
+    std::cout << "Avanzamento di un salto che attraversa piu' posizioni:" <<
+                 std::endl;
+    assert(q.advance(t0 + ms(1000)) == 3);
+    const int due[] = {2, 3, 4};
+    for(int v : due)
+        assert(q.try_dequeue(t0 + ms(1000), out) && out == v);
+    q.enqueue(t0 + ms(10), 10); // gia' scaduto: subito pronto
+    assert(q.ready_size() == 1 && q.dequeue(t0 + ms(1000)) == 10);
+    assert(q.advance(t0 + ms(500)) == 0); // il tempo non torna indietro
+
+    std::cout << "Ridistribuzione dai livelli superiori:" << std::endl;
+    q.enqueue(t0 + ms(69999), 7);
+    q.enqueue(t0 + ms(70000), 8);
+    assert(q.advance(t0 + ms(69999)) == 1 && q.dequeue(t0 + ms(69999)) == 7);
+    assert(q.advance(t0 + ms(70000)) == 2);
+    assert(q.dequeue(t0 + ms(70000)) == 6 && q.dequeue(t0 + ms(70000)) == 8);
+    assert(q.size() == 1 && q.advance(t0 + std::chrono::minutes(119)) == 0);
+    manual_clock::current = t0 + std::chrono::hours(2);
+    assert(q.dequeue() == 5 && q.size() == 0);
+
+    std::cout << "Stress rispetto a un riferimento ordinato:" << std::endl;
+    manual_clock::current = t0; // origine della nuova coda
+    delay_queue<int, equal_int, manual_clock> r(std::chrono::microseconds(1));
+    std::vector<long long> deadlines;
+    unsigned int seed = 7;
+    for(int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        long long d = (seed >> 8) % (i % 3 == 0 ? 100000000u : 50000u);
+        deadlines.push_back(d);
+        r.enqueue(t0 + std::chrono::microseconds(d), i);
+    }
+    long long last = -1;
+    int last_index = -1;
+    unsigned int released = 0;
+    for(long long now = 0; released < deadlines.size(); now += 997) {
+        while(r.try_dequeue(t0 + std::chrono::microseconds(now), out)) {
+            long long d = deadlines[out];
+            assert(d <= now && d >= last);
+            assert(d > last || out > last_index); // FIFO a parita' di scadenza
+            last = d;
+            last_index = out;
+            ++released;
+        }
+    }
+    assert(r.size() == 0);
+
+    q.enqueue(t0 + std::chrono::hours(3), 1);
+    q.enqueue(t0, 2);
+    q.clear();
+    assert(q.size() == 0 && q.ready_size() == 0 && !q.contains(1));
+    std::cout << "Eseguite." << std::endl;
+}
+
+void test_hashed_queue() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della coda con indice hash ********" << std::endl;
+	std::cout << std::endl;
+
+    hashed_queue<int, equal_int> q;
+    assert(q.size() == 0 && q.distinct() == 0 && !q.contains(1));
+
+    std::cout << "Inserimento con valori ripetuti:" << std::endl;
+    q.enqueue(1);
+    q.enqueue(2);
+    int three = 3;
+    q.enqueue(std::move(three));
+    q.emplace(2);
+    const std::vector<int> more = {4, 1};
+    q.enqueue(more.begin(), more.end());
+    std::cout << q << std::endl;
+    assert(q.size() == 6 && q.distinct() == 4);
+    assert(q.count(1) == 2 && q.count(2) == 2 && q.count(5) == 0);
+    assert(q.contains(4) && !q.contains(5));
+
+    std::cout << "Rimozione e sovrascrittura di testa e coda:" << std::endl;
+    assert(q.dequeue() == 1 && q.count(1) == 1);
+    q.set_head(5); // 2 -> 5
+    assert(q.get_head() == 5 && q.count(2) == 1 && q.contains(5));
+    q.set_tail(4); // 1 -> 4
+    assert(q.get_tail() == 4 && !q.contains(1) && q.count(4) == 2);
+    q.set_tail(q.get_tail()); // sovrascrittura con lo stesso valore
+    assert(q.count(4) == 2);
+    std::cout << q << std::endl;
+
+    std::cout << "transformif aggiorna l'indice:" << std::endl;
+    transformif(q, [](int v) { return v == 4; }, [](int v) { return v * 10; });
+    std::cout << q << std::endl;
+    assert(!q.contains(4) && q.count(40) == 2 && q.distinct() == 4);
+
+    std::cout << "Copia, spostamento e svuotamento:" << std::endl;
+    hashed_queue<int, equal_int> copy(q);
+    int out = 0;
+    while(q.try_dequeue(out))
+        assert(q.count(out) < copy.count(out) || !q.contains(out));
+    assert(q.size() == 0 && q.distinct() == 0 && !q.try_dequeue(out));
+    try {
+        q.set_head(1);
+    }
+    catch(empty_queue_exception &e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(q.distinct() == 0);
+    q = std::move(copy);
+    assert(q.size() == 5 && q.contains(40) && q.contains(3));
+    q.clear();
+    assert(q.size() == 0 && !q.contains(40));
+
+    hashed_queue<std::string, equal_string> s;
+    s.enqueue("uno");
+    s.enqueue("due");
+    assert(s.contains("due") && !s.contains("tre"));
+    assert(s.dequeue() == "uno" && !s.contains("uno"));
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Funtore per l'uguaglianza tra interi non dichiarato semplice
+
+    @description
+	Usato per confrontare la ricerca vettoriale con quella che chiama
+    il funtore su un elemento alla volta.
+*/
+struct equal_int_functor {
+    bool operator()(int i1, int i2) const {
+        return i1 == i2;
+    }
+};
+
+void test_simd_search() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della ricerca vettoriale ********" << std::endl;
+	std::cout << std::endl;
+
+    static_assert(is_simd_searchable<int, equal_int>::value, "");
+    static_assert(is_simd_searchable<float, equal_float>::value, "");
+    static_assert(!is_simd_searchable<int, equal_int_functor>::value, "");
+    static_assert(!is_simd_searchable<std::string, equal_string>::value, "");
+
+    std::cout << "Confronto con la ricerca scalare, a cavallo dei tratti "
+                 "contigui:" << std::endl;
+    for(unsigned int n = 0; n < 300; n += 7) {
+        ring_queue<int, equal_int> r;
+        ring_queue<int, equal_int_functor> rs;
+        chunked_queue<int, equal_int, 5> c;
+        // la testa avanza per far girare il buffer circolare
+        for(unsigned int i = 0; i < n / 3; ++i) {
+            r.enqueue(-1);
+            rs.enqueue(-1);
+            c.enqueue(-1);
+        }
+        for(unsigned int i = 0; i < n; ++i) {
+            int v = static_cast<int>((i * 7) % 13);
+            r.enqueue(v);
+            rs.enqueue(v);
+            c.enqueue(v);
+        }
+        for(unsigned int i = 0; i < n / 3; ++i) {
+            r.dequeue();
+            rs.dequeue();
+            c.dequeue();
+        }
+        for(int v = -1; v < 14; ++v) {
+            assert(r.contains(v) == rs.contains(v));
+            assert(c.contains(v) == rs.contains(v));
+            assert(r.count(v) == rs.count(v) && c.count(v) == rs.count(v));
+            ring_queue<int, equal_int>::iterator ri = r.find(v);
+            ring_queue<int, equal_int_functor>::iterator si = rs.find(v);
+            chunked_queue<int, equal_int, 5>::iterator ci = c.find(v);
+            unsigned int rpos = 0, spos = 0, cpos = 0;
+            for(ring_queue<int, equal_int>::iterator i = r.begin(); i != ri;
+                ++i)
+                ++rpos;
+            for(ring_queue<int, equal_int_functor>::iterator i = rs.begin();
+                i != si; ++i)
+                ++spos;
+            for(chunked_queue<int, equal_int, 5>::iterator i = c.begin();
+                i != ci; ++i)
+                ++cpos;
+            assert(rpos == spos && cpos == spos);
+        }
+    }
+
+    std::cout << "Semantica di == per i float:" << std::endl;
+    ring_queue<float, equal_float> f;
+    for(int i = 0; i < 40; ++i)
+        f.enqueue(static_cast<float>(i) / 4);
+    f.enqueue(-0.0f);
+    f.enqueue(std::numeric_limits<float>::quiet_NaN());
+    assert(f.contains(0.0f) && f.count(0.0f) == 2);
+    assert(!f.contains(std::numeric_limits<float>::quiet_NaN()));
+    assert(f.contains(9.75f) && !f.contains(9.8f));
+    *f.find(9.75f) = 100.0f;
+    assert(f.get_tail() != 100.0f && f.contains(100.0f));
+
+    queue<float, equal_float> l;
+    l.enqueue(1.5f);
+    l.enqueue(2.5f);
+    l.enqueue(1.5f);
+    assert(l.count(1.5f) == 2 && *l.find(2.5f) == 2.5f);
+    assert(l.find(3.5f) == l.end());
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Operatore add_float dichiarato speculativo, per la trasformazione
+	       senza salti condizionati delle politiche vettorizzabili
+*/
+struct speculative_add_float : add_float, execution::speculative_op_tag {
+    speculative_add_float(float v) : add_float(v) {} // initialization list
+};
+
+/**
+	@brief Confronto di transformif con politica di esecuzione con quella
+	       sequenziale
+
+    @description
+	Trasforma una copia della coda con ogni politica e con un numero
+    di thread esplicito, e verifica che il risultato coincida, elemento
+    per elemento, con quello di transformif sequenziale.
+*/
+template <typename C, typename P, typename F, typename S>
+void check_parallel_transformif(const C &original, P pred, F op, S same) {
+    C expected(original);
+    transformif(expected, pred, op);
+
+    C s(original), u(original), p(original), pu(original), t(original);
+    transformif(s, execution::seq, pred, op);
+    transformif(u, execution::unseq, pred, op);
+    transformif(p, execution::par, pred, op);
+    transformif(pu, execution::parallel_unsequenced_policy(3), pred, op);
+    transformif(t, 5u, pred, op);
+
+    const C *results[] = {&s, &u, &p, &pu, &t};
+    for(const C *r : results) {
+        assert(r->size() == expected.size());
+        typename C::const_iterator i = r->begin(), j = expected.begin();
+        for(; j != expected.end(); ++i, ++j)
+            assert(same(*i, *j));
+    }
+}
+
+void test_parallel_transformif() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test di transformif parallela ********" << std::endl;
+	std::cout << std::endl;
+
+    auto same_float = [](float a, float b) { return a == b; };
+    auto same_employee = [](const employee &a, const employee &b) {
+        return a.name == b.name && a.salary == b.salary;
+    };
+
+    assert(execution::detail::worker_count(8, 10) == 1);
+    assert(execution::detail::worker_count(8, 3 * execution::MIN_GRAIN) == 3);
+    assert(execution::detail::worker_count(2, 100 * execution::MIN_GRAIN) ==
+           2);
+
+    std::cout << "Code di float, con dimensioni a cavallo della soglia "
+                 "di parallelismo:" << std::endl;
+    const unsigned int sizes[] = {0, 1, 1000, 4 * execution::MIN_GRAIN + 17,
+                                  9 * execution::MIN_GRAIN + 3};
+    for(unsigned int n : sizes) {
+        queue<float, equal_float> q;
+        ring_queue<float, equal_float> r;
+        chunked_queue<float, equal_float, 100> c;
+        // la testa avanza per far girare il buffer circolare
+        for(unsigned int i = 0; i < n / 3; ++i) {
+            r.enqueue(0.0f);
+            c.enqueue(0.0f);
+        }
+        for(unsigned int i = 0; i < n; ++i) {
+            float v = static_cast<float>((i * 37) % 101);
+            q.enqueue(v);
+            r.enqueue(v);
+            c.enqueue(v);
+        }
+        for(unsigned int i = 0; i < n / 3; ++i) {
+            r.dequeue();
+            c.dequeue();
+        }
+        check_parallel_transformif(q, less_than_float(50.0f), add_float(0.5f),
+                                   same_float);
+        check_parallel_transformif(r, less_than_float(50.0f), add_float(0.5f),
+                                   same_float);
+        check_parallel_transformif(c, less_than_float(50.0f), add_float(0.5f),
+                                   same_float);
+        check_parallel_transformif(r, less_than_float(50.0f),
+                                   speculative_add_float(0.5f), same_float);
+        check_parallel_transformif(c, less_than_float(50.0f),
+                                   speculative_add_float(0.5f), same_float);
+    }
+
+    std::cout << "Operatore definito solo dove vale il predicato:" <<
+                 std::endl;
+    auto same_int = [](int a, int b) { return a == b; };
+    auto non_zero = [](int v) { return v != 0; };
+    auto divide = [](int v) { return 100 / v; };
+    ring_queue<int, equal_int> rz;
+    chunked_queue<int, equal_int, 100> cz;
+    for(unsigned int i = 0; i < 4 * execution::MIN_GRAIN + 5; ++i) {
+        rz.enqueue(static_cast<int>(i % 7));
+        cz.enqueue(static_cast<int>(i % 7));
+    }
+    // divide non è speculativo: op non deve essere valutato sugli zeri
+    check_parallel_transformif(rz, non_zero, divide, same_int);
+    check_parallel_transformif(cz, non_zero, divide, same_int);
+
+    std::cout << "Code di impiegati:" << std::endl;
+    queue<employee, equal_employee> qe;
+    ring_queue<employee, equal_employee> re;
+    chunked_queue<employee, equal_employee> ce;
+    for(unsigned int i = 0; i < 3 * execution::MIN_GRAIN; ++i) {
+        employee e("nome" + std::to_string(i), "cognome", i % 5000);
+        qe.enqueue(e);
+        re.enqueue(e);
+        ce.enqueue(e);
+    }
+    check_parallel_transformif(qe, salary_greater_or_equal_than_employee(2500),
+                               half_salary_employee, same_employee);
+    check_parallel_transformif(re, salary_greater_or_equal_than_employee(2500),
+                               half_salary_employee, same_employee);
+    check_parallel_transformif(ce, salary_greater_or_equal_than_employee(2500),
+                               half_salary_employee, same_employee);
+
+    std::cout << "Eccezione lanciata da un thread:" << std::endl;
+    ring_queue<float, equal_float> x;
+    for(unsigned int i = 0; i < 4 * execution::MIN_GRAIN; ++i)
+        x.enqueue(static_cast<float>(i));
+    bool thrown = false;
+    try {
+        transformif(x, execution::parallel_policy(4),
+                    [](float v) {
+                        if(v == 3.0f * execution::MIN_GRAIN)
+                            throw std::runtime_error("errore");
+                        return false;
+                    },
+                    add_float(1.0f));
+    }
+    catch(const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Verifica degli algoritmi su una coda di interi
+
+    @description
+	Riempie la coda con n valori pseudo-casuali (dopo aver fatto avanzare
+    la testa, per ring_queue e chunked_queue) e confronta il risultato
+    di ogni algoritmo, sequenziale e parallelo, con quello calcolato
+    su un std::vector con gli stessi valori.
+*/
+template <typename C>
+void check_algorithms(unsigned int n) {
+    C q;
+    std::vector<int> v;
+    for(unsigned int i = 0; i < n / 4; ++i)
+        q.enqueue(-1);
+    for(unsigned int i = 0; i < n; ++i) {
+        int value = static_cast<int>((i * 2654435761u) % 1000);
+        q.enqueue(value);
+        v.push_back(value);
+    }
+    for(unsigned int i = 0; i < n / 4; ++i)
+        q.dequeue();
+
+    auto even = [](int i) { return i % 2 == 0; };
+    auto large = [](int i) { return i >= 990; };
+    auto square = [](int i) { return static_cast<long>(i) * i; };
+    const execution::parallel_policy par3(3);
+
+    unsigned int evens = 0;
+    long sum = 0, squares = 0;
+    for(int i : v) {
+        evens += even(i) ? 1 : 0;
+        sum += i;
+        squares += square(i);
+    }
+    assert(count_if(q, even) == evens);
+    assert(count_if(q, execution::seq, even) == evens);
+    assert(count_if(q, par3, even) == evens);
+    assert(count_if(q, execution::par, even) == evens);
+
+    assert(reduce(q, 0L) == sum);
+    assert(reduce(q, par3, 0L) == sum);
+    assert(reduce(q, execution::unseq, 1L, [](long a, long b) {
+        return a + b;
+    }) == sum + 1);
+
+    unsigned int first_large = 0;
+    while(first_large < n && !large(v[first_large]))
+        ++first_large;
+    const C &cq = q;
+    typename C::const_iterator seq_found = find_if(cq, large);
+    typename C::iterator par_found = find_if(q, par3, large);
+    unsigned int seq_pos = 0, par_pos = 0;
+    for(typename C::const_iterator i = cq.begin(); i != seq_found; ++i)
+        ++seq_pos;
+    for(typename C::iterator i = q.begin(); i != par_found; ++i)
+        ++par_pos;
+    assert(seq_pos == first_large && par_pos == first_large);
+    assert(find_if(q, par3, [](int i) { return i < 0; }) == q.end());
+
+    queue<long, std::equal_to<long> > squared, par_squared;
+    ring_queue<long, std::equal_to<long> > even_squared;
+    assert(transform_into(q, squared, square) == n);
+    assert(transform_into(q, par3, par_squared, square) == n);
+    assert(transform_into(q, par3, even_squared, even, square) == evens);
+    assert(reduce(squared, 0L) == squares && reduce(par_squared, 0L) == squares);
+    assert(squared.size() == n && even_squared.size() == evens);
+    {
+        queue<long, std::equal_to<long> >::const_iterator a = squared.begin();
+        queue<long, std::equal_to<long> >::const_iterator b =
+            par_squared.begin();
+        for(unsigned int i = 0; i < n; ++i, ++a, ++b)
+            assert(*a == square(v[i]) && *b == *a);
+    }
+
+    C odd(q), par_odd(q);
+    assert(remove_if(odd, even) == evens);
+    assert(remove_if(par_odd, par3, even) == evens);
+    assert(odd.size() == n - evens && par_odd.size() == n - evens);
+    typename C::const_iterator a = odd.begin(), b = par_odd.begin();
+    for(int i : v)
+        if(!even(i)) {
+            assert(*a == i && *b == i);
+            ++a;
+            ++b;
+        }
+    assert(a == odd.end() && b == par_odd.end());
+    // la coda compattata accetta nuovi elementi in coda
+    odd.enqueue(7);
+    assert(odd.get_tail() == 7 && odd.size() == n - evens + 1);
+}
+
+/**
+	@brief Verifica di remove_if in casi limite
+
+    @tparam C tipo della coda di interi
+*/
+template <typename C>
+void check_remove_if() {
+    C q;
+    assert(q.remove_if([](int) { return true; }) == 0);
+
+    for(int i = 0; i < 20; ++i)
+        q.enqueue(i);
+    // nessun elemento rimosso
+    assert(q.remove_if([](int) { return false; }) == 0 && q.size() == 20);
+    // rimozione dell'elemento in coda
+    assert(q.remove_if([](int i) { return i == 19; }) == 1);
+    assert(q.get_tail() == 18);
+    q.enqueue(100);
+    assert(q.get_tail() == 100 && q.size() == 20);
+    // eccezione a metà: gli elementi già esaminati restano rimossi
+    int seen = 0;
+    bool thrown = false;
+    try {
+        q.remove_if([&seen](int i) {
+            if(++seen == 10)
+                throw std::runtime_error("errore");
+            return i % 2 == 0;
+        });
+    }
+    catch(const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown && q.size() == 15 && q.get_head() == 1);
+    int expected[] = {1, 3, 5, 7, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 100};
+    unsigned int k = 0;
+    for(typename C::const_iterator i = q.begin(); i != q.end(); ++i)
+        assert(*i == expected[k++]);
+    // rimozione di tutti gli elementi
+    assert(q.remove_if([](int) { return true; }) == 15 && q.size() == 0);
+    q.enqueue(5);
+    assert(q.get_head() == 5 && q.get_tail() == 5);
+}
+
+void test_algorithms() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test degli algoritmi ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Code di interi, confronto con std::vector:" << std::endl;
+    const unsigned int sizes[] = {0, 1, 100, 5 * execution::MIN_GRAIN + 11};
+    for(unsigned int n : sizes) {
+        check_algorithms<queue<int, equal_int> >(n);
+        check_algorithms<ring_queue<int, equal_int> >(n);
+        check_algorithms<chunked_queue<int, equal_int, 7> >(n);
+    }
+
+    std::cout << "Riduzione parallela con operatore non commutativo:" <<
+                 std::endl;
+    ring_queue<std::string, equal_string> digits;
+    std::string expected("x");
+    for(unsigned int i = 0; i < 3 * execution::MIN_GRAIN; ++i) {
+        digits.enqueue(std::to_string(i % 10));
+        expected += std::to_string(i % 10);
+    }
+    auto concatenate = [](std::string a, const std::string &b) {
+        return a + b;
+    };
+    assert(reduce(digits, std::string("x"), concatenate) == expected);
+    assert(reduce(digits, execution::parallel_policy(3), std::string("x"),
+                  concatenate) == expected);
+
+    std::cout << "Casi limite di remove_if:" << std::endl;
+    check_remove_if<queue<int, equal_int> >();
+    check_remove_if<ring_queue<int, equal_int> >();
+    check_remove_if<chunked_queue<int, equal_int, 3> >();
+
+    std::cout << "Code di impiegati:" << std::endl;
+    chunked_queue<employee, equal_employee> e;
+    for(unsigned int i = 0; i < 2 * execution::MIN_GRAIN; ++i)
+        e.enqueue(employee("nome" + std::to_string(i), "cognome", i));
+    salary_greater_or_equal_than_employee rich(execution::MIN_GRAIN);
+    assert(count_if(e, execution::par, rich) == execution::MIN_GRAIN);
+    assert(find_if(e, execution::parallel_policy(2), rich)->salary ==
+           execution::MIN_GRAIN);
+    assert(remove_if(e, execution::parallel_policy(2), rich) ==
+           execution::MIN_GRAIN);
+    assert(e.size() == execution::MIN_GRAIN &&
+           e.get_tail().salary == execution::MIN_GRAIN - 1);
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Stampa elemento per elemento con l'operatore di stream <<
+
+    @description
+	Riferimento per la stampa tramite buffer: è la stampa originale
+    dell'operatore di stream << delle code.
+*/
+template <typename C>
+std::string print_by_element(const C &q, std::ostream &settings) {
+    std::ostringstream os;
+    os.copyfmt(settings);
+    os << "[";
+    for(typename C::const_iterator i = q.begin(); i != q.end(); ++i) {
+        if(i != q.begin())
+            os << ", ";
+        os << *i;
+    }
+    os << "]";
+    return os.str();
+}
+
+/**
+	@brief Confronto della stampa tramite buffer con quella elemento
+	       per elemento, con le impostazioni di uno stream
+*/
+template <typename C>
+void check_print(const C &q, std::ostream &settings) {
+    std::ostringstream os;
+    os.copyfmt(settings);
+    os << q;
+    assert(os.str() == print_by_element(q, settings));
+}
+
+void test_text_format() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della stampa tramite buffer ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Numeri con diverse impostazioni dello stream:" << std::endl;
+    queue<int, equal_int> qi;
+    ring_queue<float, equal_float> rf;
+    chunked_queue<double, std::equal_to<double>, 16> cd;
+    const int ints[] = {0, -1, 7, std::numeric_limits<int>::max(),
+                        std::numeric_limits<int>::min(), 255};
+    for(int i : ints)
+        qi.enqueue(i);
+    const double reals[] = {0.0, -0.0, 0.1, 1.0 / 3, 1234567.0, 1e-7, 2.5e300,
+                            -42.0, std::numeric_limits<double>::infinity(),
+                            std::numeric_limits<double>::quiet_NaN()};
+    for(double d : reals) {
+        rf.enqueue(static_cast<float>(d));
+        cd.enqueue(d);
+    }
+    std::ostringstream settings;
+    check_print(qi, settings);
+    check_print(rf, settings);
+    check_print(cd, settings);
+    settings << std::setprecision(12);
+    check_print(rf, settings);
+    check_print(cd, settings);
+    settings << std::fixed << std::setprecision(3);
+    check_print(cd, settings);
+    settings << std::scientific;
+    check_print(cd, settings);
+    settings << std::hexfloat;
+    check_print(cd, settings);
+    settings << std::defaultfloat << std::hex << std::showbase;
+    check_print(qi, settings);
+    settings << std::dec << std::noshowbase << std::showpos;
+    check_print(qi, settings);
+    check_print(cd, settings);
+    settings << std::noshowpos;
+
+    std::cout << "Booleani, caratteri e stringhe:" << std::endl;
+    queue<bool, equal_bool> qb;
+    qb.enqueue(true);
+    qb.enqueue(false);
+    check_print(qb, settings);
+    settings << std::boolalpha;
+    check_print(qb, settings);
+    queue<char, std::equal_to<char> > qc;
+    qc.enqueue('a');
+    qc.enqueue('z');
+    check_print(qc, settings);
+    ring_queue<std::string, equal_string> rs;
+    rs.enqueue("uno");
+    rs.enqueue("");
+    rs.enqueue("tre, quattro");
+    check_print(rs, settings);
+    check_print(ring_queue<std::string, equal_string>(), settings);
+
+    std::cout << "Larghezza del campo:" << std::endl;
+    std::ostringstream wide, wide_expected;
+    wide << std::setw(5) << qi << "|";
+    wide_expected << std::setw(5) << "[" << print_by_element(qi, settings)
+                                                .substr(1) << "|";
+    assert(wide.str() == wide_expected.str());
+
+    std::cout << "Formattatori di numeri complessi e impiegati:" << std::endl;
+    queue<complex, equal_complex> qx;
+    qx.enqueue(complex(1, -2));
+    qx.enqueue(complex(0, 0));
+    std::ostringstream sx;
+    sx << qx;
+    assert(sx.str() == "[(1, -2), (0, 0)]");
+    chunked_queue<employee, equal_employee> ce;
+    ce.enqueue(employee("Mario", "Rossi", 1500));
+    ce.enqueue(employee("Anna", "Bianchi", 2000));
+    std::ostringstream se;
+    se << ce;
+    assert(se.str() == "[{Mario Rossi: 1500}, {Anna Bianchi: 2000}]");
+
+    std::cout << "Code di code (stampa annidata):" << std::endl;
+    queue<queue_int, equal_queue_int> qq;
+    qq.enqueue(qi);
+    qq.enqueue(queue_int());
+    qq.enqueue(qi);
+    check_print(qq, settings);
+
+    std::cout << "Coda piu' grande del buffer:" << std::endl;
+    ring_queue<int, equal_int> big;
+    for(int i = 0; i < 100000; ++i)
+        big.enqueue(i * 7919 - 300000);
+    check_print(big, settings);
+    text::output_buffer small(16);
+    std::ostringstream sb;
+    {
+        text::writer w(sb, small);
+        for(int i = 0; i < 100; ++i) {
+            w.put_number(i * 1000003);
+            w.put(std::string_view("; "));
+        }
+    }
+    std::ostringstream sb_expected;
+    for(int i = 0; i < 100; ++i)
+        sb_expected << i * 1000003 << "; ";
+    assert(sb.str() == sb_expected.str());
+
+    std::cout << "Stampa limitata ai primi e agli ultimi elementi:" <<
+                 std::endl;
+    queue<int, equal_int> q10;
+    for(int i = 0; i < 10; ++i)
+        q10.enqueue(i);
+    std::ostringstream l1, l2, l3, l4, l5;
+    l1 << text::print(q10, 2, 3);
+    assert(l1.str() == "[0, 1, ..., 7, 8, 9]");
+    l2 << text::print(q10, 3);
+    assert(l2.str() == "[0, 1, 2, ...]");
+    l3 << text::print(q10, 0, 1);
+    assert(l3.str() == "[..., 9]");
+    l4 << text::print(q10, 5, 5);
+    assert(l4.str() == "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9]");
+    l5 << text::print(big, 1, 1) << text::print(queue<int, equal_int>(), 1, 1);
+    assert(l5.str() == "[-300000, ..., 791592081][]");
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Verifica che la lettura del testo stampato di una coda
+	       produca una coda che si stampa nello stesso modo
+*/
+template <typename C>
+void check_round_trip(const C &q) {
+    std::ostringstream os;
+    os << q;
+    C p;
+    std::istringstream is(os.str());
+    is >> p;
+    assert(!is.fail() && p.size() == q.size());
+    std::ostringstream ps;
+    ps << p;
+    assert(ps.str() == os.str());
+}
+
+void test_text_parse() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della lettura testuale ********" << std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Lettura del testo stampato:" << std::endl;
+    queue<int, equal_int> qi;
+    const int ints[] = {0, -1, 7, std::numeric_limits<int>::max(),
+                        std::numeric_limits<int>::min(), 255};
+    for(int i : ints)
+        qi.enqueue(i);
+    check_round_trip(qi);
+    queue<int, equal_int> pi = parse_queue<int, equal_int>("[0, -1, 7, "
+        "2147483647, -2147483648, 255]");
+    assert(pi.size() == qi.size());
+    queue<int, equal_int>::const_iterator i = qi.begin(), j = pi.begin();
+    for(; i != qi.end(); ++i, ++j)
+        assert(*i == *j);
+    ring_queue<float, equal_float> rf;
+    chunked_queue<double, std::equal_to<double>, 16> cd;
+    const double reals[] = {0.0, -0.0, 0.1, 1.0 / 3, 1234567.0, 1e-7, 2.5e300,
+                            -42.0, std::numeric_limits<double>::infinity(),
+                            std::numeric_limits<double>::quiet_NaN()};
+    for(double d : reals) {
+        rf.enqueue(static_cast<float>(d));
+        cd.enqueue(d);
+    }
+    check_round_trip(rf);
+    check_round_trip(cd);
+    check_round_trip(queue<int, equal_int>());
+    queue<bool, equal_bool> qb = parse_queue<bool, equal_bool>("[1, 0, true]");
+    assert(qb.size() == 3 && qb.get_head() && qb.get_tail());
+    check_round_trip(qb);
+    queue<char, std::equal_to<char> > qc =
+        parse_queue<char, std::equal_to<char> >("[a, ,, z]");
+    assert(qc.size() == 3 && qc.get_head() == 'a' && qc.get_tail() == 'z');
+    ring_queue<std::string, equal_string> rs;
+    rs.enqueue("uno");
+    rs.enqueue("");
+    rs.enqueue("tre,quattro");
+    check_round_trip(rs);
+
+    std::cout << "Numeri complessi, impiegati e code di code:" << std::endl;
+    queue<complex, equal_complex> qx =
+        parse_queue<complex, equal_complex>("[(1, -2), (0, 0)]");
+    assert(qx.size() == 2 && qx.get_head().imaginary == -2);
+    check_round_trip(qx);
+    chunked_queue<employee, equal_employee> ce;
+    ce.enqueue(employee("Mario", "Rossi", 1500));
+    ce.enqueue(employee("Anna", "De Santis", 2000));
+    check_round_trip(ce);
+    queue<queue_int, equal_queue_int> qq;
+    qq.enqueue(qi);
+    qq.enqueue(queue_int());
+    qq.enqueue(qi);
+    check_round_trip(qq);
+
+    std::cout << "Code piu' grandi di un blocco di inserimento:" << std::endl;
+    ring_queue<int, equal_int> big;
+    queue<long, std::equal_to<long> > big_list;
+    for(int k = 0; k < 3 * static_cast<int>(text::PARSE_BATCH) + 5; ++k) {
+        big.enqueue(k * 7919 - 300000);
+        big_list.enqueue(-k);
+    }
+    check_round_trip(big);
+    check_round_trip(big_list);
+    std::ostringstream sb;
+    sb << big;
+    ring_queue<int, equal_int> appended(big);
+    assert(text::parse_into(sb.str(), appended) == big.size());
+    assert(appended.size() == 2 * big.size() &&
+           appended.get_tail() == big.get_tail());
+
+    std::cout << "Testo non valido:" << std::endl;
+    const char *invalid[] = {"", "1, 2", "[1, 2", "[1,2]", "[1, x]",
+                             "[1, 2] 3", "[1, ]", "[ 1]"};
+    const std::size_t positions[] = {0, 0, 5, 2, 4, 8, 4, 1};
+    for(unsigned int k = 0; k < 8; ++k) {
+        bool thrown = false;
+        try {
+            parse_queue<int, equal_int>(invalid[k]);
+        }
+        catch(const parse_queue_exception &e) {
+            thrown = true;
+            assert(e.position() == positions[k]);
+        }
+        assert(thrown);
+    }
+
+    std::cout << "Operatore di stream >>:" << std::endl;
+    std::istringstream two("  [1, 2]\n[[3], [4, 5]] [6");
+    ring_queue<int, equal_int> r;
+    queue<queue_int, equal_queue_int> nested;
+    two >> r >> nested;
+    assert(two && r.size() == 2 && r.get_tail() == 2 && nested.size() == 2 &&
+           nested.get_tail().size() == 2);
+    two >> r;
+    assert(two.fail() && r.size() == 2);
+    std::istringstream wrong("[1, a]");
+    wrong >> r;
+    assert(wrong.fail() && r.size() == 2 && r.get_head() == 1);
+    std::cout << "Eseguite." << std::endl;
+}
+
+/**
+	@brief Verifica che la deserializzazione di una coda serializzata
+	       produca una coda con gli stessi elementi
+*/
+template <typename C, typename E>
+void check_serialize(const C &q, E equal) {
+    std::stringstream ss(std::ios_base::in | std::ios_base::out |
+                         std::ios_base::binary);
+    serialize(ss, q);
+    C d;
+    deserialize(ss, d);
+    assert(d.size() == q.size());
+    typename C::const_iterator i = q.begin(), j = d.begin();
+    for(; i != q.end(); ++i, ++j)
+        assert(equal(*i, *j));
+    assert(ss.peek() == std::char_traits<char>::eof());
+}
+
+void test_binary_io() {
+
+	std::cout << std::endl;
+	std::cout << "******** Test della serializzazione binaria ********" <<
+	             std::endl;
+	std::cout << std::endl;
+
+    std::cout << "Tipi banalmente copiabili:" << std::endl;
+    queue<int, equal_int> qi;
+    ring_queue<int, equal_int> ri;
+    chunked_queue<double, std::equal_to<double>, 7> cd;
+    for(int k = 0; k < 100000; ++k) {
+        qi.enqueue(k * 7919 - 300000);
+        ri.enqueue(k);
+        cd.enqueue(k / 3.0);
+    }
+    // coda circolare che non parte dall'inizio del buffer
+    for(int k = 0; k < 1000; ++k) {
+        ri.dequeue();
+        ri.enqueue(-k);
+    }
+    check_serialize(qi, equal_int());
+    check_serialize(ri, equal_int());
+    check_serialize(cd, std::equal_to<double>());
+    check_serialize(queue<int, equal_int>(), equal_int());
+    check_serialize(ring_queue<int, equal_int>(), equal_int());
+    queue<complex, equal_complex> qx;
+    qx.enqueue(complex(1, -2));
+    qx.enqueue(complex(0, 0));
+    check_serialize(qx, equal_complex());
+    ring_queue<bool, equal_bool> rb;
+    for(int k = 0; k < 100000; ++k)
+        rb.enqueue(k % 3 == 0);
+    check_serialize(rb, equal_bool());
+
+    std::cout << "Stringhe e impiegati:" << std::endl;
+    ring_queue<std::string, equal_string> rs;
+    rs.enqueue("uno");
+    rs.enqueue("");
+    rs.enqueue(std::string(200000, 'x'));
+    rs.enqueue(std::string("con\0zero", 8));
+    check_serialize(rs, [](const std::string &a, const std::string &b) {
+        return a == b;
+    });
+    chunked_queue<employee, equal_employee> ce;
+    ce.enqueue(employee("Mario", "Rossi", 1500));
+    ce.enqueue(employee("Anna", "De Santis", 2000));
+    check_serialize(ce, [](const employee &a, const employee &b) {
+        return a.name == b.name && a.surname == b.surname &&
+               a.salary == b.salary;
+    });
+
+    std::cout << "Piu' code sullo stesso stream:" << std::endl;
+    std::stringstream ss(std::ios_base::in | std::ios_base::out |
+                         std::ios_base::binary);
+    serialize(ss, qi);
+    serialize(ss, rs);
+    serialize(ss, ri);
+    queue<int, equal_int> qi2;
+    ring_queue<std::string, equal_string> rs2;
+    chunked_queue<int, equal_int, 16> ci;
+    deserialize(ss, qi2);
+    deserialize(ss, rs2);
+    assert(binary::read_queue_into(ss, ci) == ri.size());
+    assert(qi2.size() == qi.size() && rs2.get_tail() == rs.get_tail() &&
+           ci.size() == ri.size() && ci.get_tail() == ri.get_tail());
+
+    std::cout << "Dati non validi:" << std::endl;
+    std::stringstream good(std::ios_base::in | std::ios_base::out |
+                           std::ios_base::binary);
+    serialize(good, qi);
+    const std::string bytes = good.str();
+    std::string corrupted[5] = {bytes.substr(0, 10),
+                                bytes.substr(0, bytes.size() - 1),
+                                bytes, bytes, bytes};
+    corrupted[2][0] = 'X'; // identificativo del formato
+    corrupted[3][4] = 2; // versione futura
+    corrupted[4][12] = 8; // dimensione degli elementi
+    for(unsigned int k = 0; k < 5; ++k) {
+        std::istringstream is(corrupted[k], std::ios_base::binary);
+        queue<int, equal_int> q;
+        q.enqueue(42);
+        bool thrown = false;
+        try {
+            deserialize(is, q);
+        }
+        catch(const serialize_queue_exception &) {
+            thrown = true;
+        }
+        assert(thrown && q.size() == 1 && q.get_head() == 42);
+    }
+    std::istringstream as_double(bytes, std::ios_base::binary);
+    queue<double, std::equal_to<double> > qd;
+    bool thrown = false;
+    try {
+        deserialize(as_double, qd);
+    }
+    catch(const serialize_queue_exception &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Numero di elementi dell'intestazione non valido:" <<
+                 std::endl;
+    const std::uint64_t counts[3] = {(std::uint64_t(1) << 31) + 1,
+                                     std::uint64_t(1) << 29,
+                                     std::uint64_t(1) << 32};
+    for(std::uint64_t count : counts) {
+        // solo l'intestazione, senza gli elementi
+        std::string crafted = bytes.substr(0, sizeof(binary::header));
+        std::memcpy(&crafted[offsetof(binary::header, count)], &count,
+                    sizeof(count));
+        std::istringstream is(crafted, std::ios_base::binary);
+        ring_queue<int, equal_int> r;
+        r.enqueue(42);
+        thrown = false;
+        try {
+            deserialize(is, r);
+        }
+        catch(const serialize_queue_exception &) {
+            thrown = true;
+        }
+        // il rifiuto è immediato e non riserva lo spazio dichiarato
+        assert(thrown && r.size() == 1 && r.get_head() == 42);
+    }
+    std::cout << "Eseguite." << std::endl;
+}
+
+void test_continue() {
+	
+	std::cout << std::endl;
+	std::cout << "******** Fine test precedente ********" << std::endl;
+}
+
+void test() {
+	
+	std::cout << "**************** INIZIO TEST ****************" << std::endl;
+
+	test_queue_int();
+
+	test_continue();
+	test_queue_float();
+
+	test_continue();
+	test_queue_bool();
+
+	test_continue();
+	test_queue_string();
+
+	test_continue();
+	test_queue_complex();
+
+	test_continue();
+	test_queue_employee();
+
+	test_continue();
+	test_queue_queue_int();
+
+	test_continue();
+	test_queue_pool();
+
+	test_continue();
+	test_queue_allocator();
+
+	test_continue();
+	test_queue_move();
+
+	test_continue();
+	test_spsc_queue();
+
+	test_continue();
+	test_mpmc_queue();
+
+	test_continue();
+	test_blocking_queue();
+
+	test_continue();
+	test_work_stealing_deque();
+
+	test_continue();
+	test_executor();
+
+	test_continue();
+	test_sharded_queue();
+
+	test_continue();
+	test_flat_combining_queue();
+
+	test_continue();
+	test_async_queue();
+
+	test_continue();
+	test_multicast_ring();
+
+	test_continue();
+	test_multilevel_queue();
+
+	test_continue();
+	test_delay_queue();
+
+	test_continue();
+	test_hashed_queue();
+
+	test_continue();
+	test_simd_search();
+
+	test_continue();
+	test_parallel_transformif();
+
+	test_continue();
+	test_algorithms();
+
+	test_continue();
+	test_text_format();
+
+	test_continue();
+	test_text_parse();
+
+	test_continue();
+	test_binary_io();
 	
 	std::cout << std::endl << "**************** FINE TEST ****************" <<
 	             std::endl;
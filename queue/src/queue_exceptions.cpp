@@ -6,13 +6,18 @@
 
     @description
     File sorgente con la definizione delle classi di eccezioni custom
-    empty_queue_exception e queue_iterator_out_of_bounds_exception.
+    empty_queue_exception, queue_iterator_out_of_bounds_exception,
+    full_queue_exception, invalid_level_exception, parse_queue_exception
+    e serialize_queue_exception.
 */
 
 // Direttive per il pre-compilatore
 
 #include "../headers/queue_exceptions.h" // empty_queue_exception,
-                                       // queue_iterator_out_of_bounds_exception
+                                       // queue_iterator_out_of_bounds_exception,
+                                       // full_queue_exception,
+                                       // invalid_level_exception,
+                                       // parse_queue_exception
 
 // Definizione della classe eccezione custom empty_queue_exception
 
@@ -39,3 +44,54 @@ queue_iterator_out_of_bounds_exception::
 std::string queue_iterator_out_of_bounds_exception::what() const {
     return _message;
 }
+
+// Definizione della classe eccezione custom full_queue_exception
+
+// Definizione del costruttore
+full_queue_exception::full_queue_exception(const std::string &message) :
+    _message(message) {} // initialization list
+
+// Definizione del metodo what()
+std::string full_queue_exception::what() const {
+    return _message;
+}
+
+// Definizione della classe eccezione custom invalid_level_exception
+
+// Definizione del costruttore
+invalid_level_exception::invalid_level_exception(const std::string &message) :
+    _message(message) {} // initialization list
+
+// Definizione del metodo what()
+std::string invalid_level_exception::what() const {
+    return _message;
+}
+
+// Definizione della classe eccezione custom parse_queue_exception
+
+// Definizione del costruttore
+parse_queue_exception::parse_queue_exception(const std::string &message,
+                                             std::size_t position) :
+    _message(message), _position(position) {} // initialization list
+
+// Definizione del metodo what()
+std::string parse_queue_exception::what() const {
+    return _message;
+}
+
+// Definizione del metodo position()
+std::size_t parse_queue_exception::position() const {
+    return _position;
+}
+
+// Definizione della classe eccezione custom serialize_queue_exception
+
+// Definizione del costruttore
+serialize_queue_exception::serialize_queue_exception(
+    const std::string &message) :
+    _message(message) {} // initialization list
+
+// Definizione del metodo what()
+std::string serialize_queue_exception::what() const {
+    return _message;
+}